@@ -125,6 +125,24 @@ public:
      */
     int ReadCurrent(float* const Value);
 
+    /**
+     * @brief Read the shunt voltage, bus voltage, power and current in a single bus transaction.
+     *
+     * @param[out] ShuntVoltage A pointer to a float to store the shunt voltage.
+     * @param[out] BusVoltage A pointer to a float to store the bus voltage.
+     * @param[out] Power A pointer to a float to store the power.
+     * @param[out] Current A pointer to a float to store the current.
+     *
+     * @return  0 : OK
+     * @return -1 : IOCTL error.
+     *
+     * @test Function to test !
+     */
+    int ReadAll(float* const ShuntVoltage,
+                float* const BusVoltage,
+                float* const Power,
+                float* const Current);
+
     /**
      * @brief Store the value used for the calibration. This is the full scale voltage drop for the shunt resistor.
      *
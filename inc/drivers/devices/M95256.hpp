@@ -16,6 +16,7 @@
 #include "drivers/peripherals/spi.hpp"
 
 // STD
+#include <chrono>
 #include <cstdint>
 
 // ==============================================================================
@@ -32,6 +33,19 @@ enum class EEPROM_WP
 
 constexpr int PAGE_SIZE = 64; /*!< Define EEPROM page size*/
 
+/*! Define the write cycle statistics of the EEPROM, measured by polling the WIP bit */
+struct M95256_STATISTICS
+{
+    unsigned long Cycles; /*!< Number of measured write cycles*/
+    unsigned long Overlapped; /*!< Number of write cycles already completed on the first poll, without any sleep*/
+    unsigned long Estimated; /*!< Number of write cycles completed on the first poll, after sleeping the estimate*/
+    unsigned long Polls; /*!< Number of RDSR issued while waiting*/
+    unsigned long Timeouts; /*!< Number of write cycles that did not complete in time*/
+    long MinCycle; /*!< Shortest measured write cycle, in us*/
+    long MaxCycle; /*!< Longest measured write cycle, in us*/
+    long TotalCycle; /*!< Sum of the measured write cycles, in us*/
+};
+
 // ==============================================================================
 // IC CLASS FUNCTIONS
 // ==============================================================================
@@ -45,6 +59,21 @@ private:
     SPI_Bus SPI;
     uint8_t Openned;
 
+    bool WritePending; /*!< A write cycle has been started, and not yet checked for completion*/
+    std::chrono::steady_clock::time_point WriteStart; /*!< Start of the pending write cycle*/
+    long Estimate; /*!< Lower bound of the write cycle slept before the first poll, in us. 0 if unknown*/
+    M95256_STATISTICS Statistics;
+
+    /**
+     * @brief Read the status register, without waiting for the write cycle.
+     */
+    int PollStatus(uint8_t* const Status);
+
+    /**
+     * @brief Mark a write cycle as started. It will be awaited by the next operation.
+     */
+    void StartWrite();
+
 public:
     /**
      * @brief Constructor for the M95256 class.
@@ -65,6 +94,31 @@ public:
      */
     ~M95256();
 
+    /**
+     * @brief Wait for the completion of the pending write cycle, if any, by polling the WIP bit with an increasing
+     *        delay. Called by every operation, thus writes return as soon as they have been sent, and the write
+     *        cycle overlap with the work of the caller.
+     *        The first poll is delayed by an estimate of the cycle, which shrink each time the device is found ready
+     *        on the first poll : the cycle keep being measured, and the estimate follow it.
+     *        The cycle is only considered complete once WIP has been read as 0 : after an error, the next operation
+     *        wait for it again.
+     *
+     * @return  0 : OK
+     * @return -1 : IOCTL error.
+     * @return -2 : Write cycle did not complete in time.
+     */
+    int WaitWrite();
+
+    /**
+     * @brief Return the measured write cycle statistics.
+     */
+    M95256_STATISTICS GetStatistics() const;
+
+    /**
+     * @brief Clear the write cycle statistics.
+     */
+    void ResetStatistics();
+
     /**
      * @brief Enable the ability to write on the chip. Warning : The physical pin can overhide this value.
      *
@@ -109,7 +163,7 @@ public:
     int WriteStatus(const int WriteProtectStatus, const EEPROM_WP ProtectedBlock);
 
     /**
-     * @brief Read data of the EEPROM
+     * @brief Read data of the EEPROM, with a single sequential READ (split only beyond the spidev bufsiz).
      *
      * @param Address Address of the first byte to be read.
      * @param Data A pointer to a list of Len elements to store the output.
@@ -119,11 +173,15 @@ public:
      * @return -1 : Invalid address
      * @return -2 : Invalid Len (May be triggered if Address + Len > MAX_ADDRESS)
      * @return -3 : IOCTL error.
+     * @return -4 : Previous write cycle did not complete.
+     * @return -5 : IOCTL error while waiting for the previous write cycle.
      */
     int Read(const int Address, uint8_t* const Data, const int Len);
 
     /**
-     * @brief Write content to EEPROM. Only possible if write has been enabled !
+     * @brief Write content to EEPROM. Any address and length are accepted : the data is split on the page
+     *        boundaries, and each page is sent once the previous one has been programmed.
+     *        Return once the last page has been sent, it's write cycle is awaited by the next operation.
      *
      * @param Address Adress of the first byte to be wrote
      * @param Data A pointer to a list of elements to be wrote.
@@ -133,6 +191,8 @@ public:
      * @return -1 : Invalid address
      * @return -2 : Invalid Len (May be triggered if Address + Len > MAX_ADDRESS)
      * @return -3 : IOCTL error.
+     * @return -4 : Previous write cycle did not complete.
+     * @return -5 : IOCTL error while waiting for the previous write cycle.
      */
     int Write(const int Address, uint8_t* const Data, const int Len);
 };
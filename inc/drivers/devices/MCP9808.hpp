@@ -14,6 +14,7 @@
 #pragma once
 
 // Drivers
+#include "drivers/peripherals/core/I2C_Async.hpp"
 #include "drivers/peripherals/i2c.hpp"
 
 // STD
@@ -97,6 +98,27 @@ public:
      */
     ~MCP9808();
 
+    /**
+     * @brief Bring the sensor up : check it's manufacturer ID, then configure it's resolution and alert temperatures.
+     *        The accesses are queued to the arbiter, if running, without blocking the calling thread : the task is
+     *        resumed on the arbiter worker once each of them has been served. The object shall outlive the task.
+     *
+     * @param[in] Resolution The measurement resolution.
+     * @param[in] Minimal Lower alert temperature, within -128 +127 °C.
+     * @param[in] Maximal Upper alert temperature, within -128 +127 °C.
+     * @param[in] Critical Critical alert temperature, within -128 +127 °C.
+     *
+     * @return  0 : OK
+     * @return -1 : Out of range temperature.
+     * @return -2 : IOCTL error.
+     * @return -3 : The device is not an MCP9808.
+     *
+     */
+    I2C_Task Initialize(const TEMP_RESOLUTION Resolution,
+                        const float Minimal,
+                        const float Maximal,
+                        const float Critical);
+
     /**
      * @brief Configure the device measurement resolution.
      *
@@ -12,6 +12,7 @@
 #pragma once
 
 // Drivers
+#include "drivers/peripherals/core/REG_Map.hpp"
 #include "drivers/peripherals/i2c.hpp"
 
 // STD
@@ -35,6 +36,34 @@ enum class DAC_BUFFER
     B = 0x3E,
 };
 
+/**
+ * @enum DAC_WRITE
+ * @brief Define how configuration writes are handled
+ *
+ * @param DAC_WRITE::THROUGH Registers are wrote immediately (default).
+ * @param DAC_WRITE::DEFERRED Registers are only updated in RAM, and sent by Flush().
+ *
+ */
+enum class DAC_WRITE
+{
+    THROUGH,
+    DEFERRED,
+};
+
+// =====================
+// PUBLIC STRUCTS
+// =====================
+
+/*! Define the counters of the CRAM and instruction RAM uploads*/
+struct DAC_UPLOAD_STATISTICS
+{
+    unsigned long Bursts; /*!< Number of runs of contiguous words sent*/
+    unsigned long Skipped; /*!< Number of words not sent, since already on the DAC*/
+    unsigned long Transfers; /*!< Number of transfers (thus, of ioctls)*/
+    unsigned long Bytes; /*!< Number of register bytes sent, page selections excluded*/
+    unsigned long long Duration; /*!< Time spent on the uploads, in ns*/
+};
+
 // ==============================================================================
 // IC CLASS FUNCTIONS
 // ==============================================================================
@@ -49,7 +78,46 @@ private:
     uint8_t address;
     I2C_Bus I2C;
 
+    // Shadow of the configuration pages (0, 1, 44 and 253). Registers are mirrored once wrote or read.
+    static constexpr int SHADOW_PAGES = 4;
+    uint8_t Shadow[SHADOW_PAGES][128];
+    uint64_t ShadowValid[SHADOW_PAGES][2];
+    uint64_t ShadowDirty[SHADOW_PAGES][2];
+    int CurrentPage; // -1 if unknown
+    DAC_WRITE WriteMode;
+    DAC_UPLOAD_STATISTICS Upload;
+
+    // Image of the CRAM buffers (A then B) and of the instruction RAM, as last uploaded. Only the known words are
+    // valid. 9 pages of coefficients per buffer, 52 pages of instructions, 30 words per page.
+    static constexpr int DSP_COEFFICIENTS = 270;
+    static constexpr int DSP_INSTRUCTIONS = 1560;
+    uint8_t CoefficientImage[2][DSP_COEFFICIENTS * 3];
+    uint64_t CoefficientKnown[2][(DSP_COEFFICIENTS + 63) / 64];
+    uint8_t InstructionImage[DSP_INSTRUCTIONS * 4];
+    uint64_t InstructionKnown[(DSP_INSTRUCTIONS + 63) / 64];
+
     int SelectPage(int Page);
+    int SelectPage(I2C_Transaction* const Transaction, const uint8_t* const Page);
+    int ShadowSlot(const int Page);
+    void InvalidateShadow();
+    int QueueWrite(I2C_Transaction* const Transaction,
+                   const REG_Register Register,
+                   const uint8_t* const Values,
+                   const int Size);
+    int WriteRegisters(I2C_Transaction* const Transaction,
+                       const REG_Register Register,
+                       const uint8_t* const Values,
+                       const int Size);
+    int ReadRegister(const REG_Register Register, int* const Value);
+    int Submit(I2C_Transaction* const Transaction);
+    int WriteDSPWords(const int FirstPage,
+                      const int Pages,
+                      const int Width,
+                      uint8_t* const Resident,
+                      uint64_t* const Known,
+                      const int First,
+                      const uint8_t* const Values,
+                      const int Count);
 
     int PLLINPUTFREQ;
 
@@ -437,6 +505,29 @@ public:
      */
     int DSPSwitchCRAM();
 
+    /**
+     * @brief Read which CRAM buffer is used by the DSP. In adaptive mode, the other one can be wrote.
+     *
+     * @param[out] Active The active buffer.
+     *
+     * @return  0 : OK
+     * @return -1 : IOCTL error.
+     */
+    int ReadActiveCRAM(DAC_BUFFER* const Active);
+
+    /**
+     * @brief Switch the CRAM buffers, and wait for the DSP to confirm the switch. The switch is done between two
+     *        audio frames, and thus is glitch-free. Require the adaptive mode (see ConfigureDSP()).
+     *
+     * @param[in] Timeout Maximal time to wait for the confirmation, in ms.
+     * @param[out] Active If not null, the active buffer once switched.
+     *
+     * @return  0 : OK
+     * @return -1 : IOCTL error.
+     * @return -2 : Timeout, the DSP didn't switch (not in adaptive mode, or no audio clock).
+     */
+    int DSPSwapCRAM(const int Timeout, DAC_BUFFER* const Active = nullptr);
+
     /**
      * @brief Enable and configure the external Interpolation filter.
      *
@@ -566,40 +657,90 @@ public:
                                const int LRLCK);
 
     /**
-     * @brief Write to a CRAM buffer a list of coefficients for the DSP.
-     * @warning This function is slow and blocking due to the large amount of Data to transfer.
+     * @brief Write to a CRAM buffer a list of coefficients for the DSP. The buffer is formatted first, then sent as
+     *        an auto-incremented burst per page, with several pages per transfer.
      *
      * @param[in] Buffer The number of the buffer.
-     * @param[in] Values An array to be wrote.
-     * @param[in] CoeffNumber The number of values to write.
+     * @param[in] Values An array to be wrote. Only the 24 LSB are used.
+     * @param[in] CoeffNumber The number of values to write, up to 270.
      *
      * @return  0 : OK
      * @return -1 : Invalid Buffer
      * @return -2 : Invalid Values sizes
      * @return -3 : IOCTL error.
-     *
-     * @test Function to test !
      */
     int ConfigureDSPCoefficientBuffer(const DAC_BUFFER Buffer,
                                       int* const Values,
                                       const size_t CoeffNumber);
 
     /**
-     * @brief Write to a CRAM buffer a list of instructions for the DSP.
-     * @warning This function is slow and blocking due to the large amount of Data to transfer.
+     * @brief Write to the instruction RAM a list of instructions for the DSP. The program is formatted first, then
+     *        sent as an auto-incremented burst per page, with several pages per transfer.
      *
      * @param[in] Instructions An array of instructions to be wrote.
-     * @param[in] InstrNumber The number of instructions to write.
+     * @param[in] InstrNumber The number of instructions to write, up to 1560.
      *
      * @return  0 : OK
      * @return -1 : Invalid Values sizes
      * @return -2 : IOCTL error.
-     * @return -3 : Unknown error. Shoudln't get here, if you land here, good luck !
-     *
-     * @test Function to test !
+     * @return -3 : Failed to allocate memory.
      */
     int ConfigureDSPIntructions(int* const Instructions, const size_t InstrNumber);
 
+    /**
+     * @brief Write already formatted coefficients to a CRAM buffer. Each coefficient is a 4.20 fixed point word of
+     *        3 bytes, MSB first, as stored on a DSP profile. Only the coefficients that differ from the last
+     *        uploaded ones are sent, as a burst per run of changed coefficients.
+     *
+     * @param[in] Buffer The number of the buffer.
+     * @param[in] First Index of the first written coefficient.
+     * @param[in] Values The coefficients, 3 bytes each.
+     * @param[in] Count The number of coefficients to write.
+     *
+     * @return  0 : OK
+     * @return -1 : Invalid Buffer, or coefficients out of the buffer.
+     * @return -2 : IOCTL error.
+     */
+    int WriteDSPCoefficients(const DAC_BUFFER Buffer,
+                             const int First,
+                             const uint8_t* const Values,
+                             const int Count);
+
+    /**
+     * @brief Write already formatted instructions to the instruction RAM. Each instruction is a word of 4 bytes,
+     *        MSB first, as stored on a DSP profile. Only the instructions that differ from the last uploaded ones
+     *        are sent, as a burst per run of changed instructions.
+     *
+     * @param[in] First Index of the first written instruction.
+     * @param[in] Values The instructions, 4 bytes each.
+     * @param[in] Count The number of instructions to write.
+     *
+     * @return  0 : OK
+     * @return -1 : Instructions out of the instruction RAM.
+     * @return -2 : IOCTL error.
+     */
+    int WriteDSPInstructions(const int First, const uint8_t* const Values, const int Count);
+
+    /**
+     * @brief Forget the uploaded coefficients and instructions : the next uploads send every word. Done on DSP
+     *        resets, and to be called if the CRAM may have been changed by another mean.
+     *
+     */
+    void InvalidateDSPImage();
+
+    /**
+     * @brief Return the counters of the CRAM and instruction RAM uploads, since the last reset.
+     *
+     * @return DAC_UPLOAD_STATISTICS
+     */
+    DAC_UPLOAD_STATISTICS GetUploadStatistics() const;
+
+    /**
+     * @brief Clear the counters of the uploads.
+     *
+     */
+    void ResetUploadStatistics();
+
     /**
      * @brief Configure the volume (digital) for the DAC.
      *
@@ -641,6 +782,28 @@ public:
      */
     int Mute(const int MuteLeft, const int MuteRight);
 
+    /**
+     * @brief Select how the configuration functions write the registers.
+     *        In DEFERRED mode, the configuration functions only update the shadow of the registers, and the
+     *        changed ones are sent by Flush(). Resets, resynchronisations and CRAM switches are always immediate,
+     *        and read back values (PLL lock...) reflect the state before the Flush().
+     *        Switching back to THROUGH flush the pending writes.
+     *
+     * @param[in] Mode The write mode.
+     *
+     * @return  0 : OK
+     * @return -1 : IOCTL error.
+     */
+    int SetWriteMode(const DAC_WRITE Mode);
+
+    /**
+     * @brief Send the registers changed since the last flush, as auto-incremented bursts of contiguous registers.
+     *
+     * @return  0 : OK
+     * @return -1 : IOCTL error. The registers are kept pending.
+     */
+    int Flush();
+
     /**
      * @brief Read the status of the GPIO used as input.
      *
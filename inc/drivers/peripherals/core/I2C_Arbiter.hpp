@@ -0,0 +1,161 @@
+/**
+ * @file I2C_Arbiter.hpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define a bus arbiter, that serialize the accesses of all of the threads to an I2C bus.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+// Header
+#include "I2C_Engine.hpp"
+
+// STD
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// ==============================================================================
+// DATA STRUCTURES
+// ==============================================================================
+
+/*! Define an operation to be executed by the arbiter, with exclusive access to the bus*/
+typedef int (*I2C_Operation)(I2C_Bus* I2C, void* Arguments);
+
+/*! Define a request to the arbiter. Must not be moved nor destroyed until completed.*/
+struct I2C_Request
+{
+    I2C_Operation Operation; /*!< Operation to be executed*/
+    void* Arguments; /*!< Arguments of the operation*/
+    I2C_Bus* I2C; /*!< Bus copy used for the operation*/
+    int Result; /*!< Value returned by the operation*/
+    void (*Complete)(I2C_Request* Request); /*!< Called by the worker once executed. nullptr for blocking requests*/
+    void* User; /*!< Free for the use of the Complete callback*/
+
+    // Internal usage
+    std::atomic<uint32_t> Done; /*!< Set once a blocking request has been executed*/
+    std::chrono::steady_clock::time_point Queued; /*!< Submission time*/
+    I2C_Request* Next; /*!< Next request on the queue*/
+};
+
+/*! Arguments of the SMBus based accesses (I2C_Write and I2C_Read)*/
+struct I2C_AccessArguments
+{
+    int Address; /*!< The address of the IC on the bus*/
+    int Register; /*!< The first register*/
+    int* Payload; /*!< The data to be wrote, or rode*/
+    int Size; /*!< The number of bytes (or words)*/
+    int DataSize; /*!< The number of bytes per operation (1 or 2)*/
+};
+
+/*! Define the statistics of a priority class*/
+struct I2C_QueueStatistics
+{
+    unsigned long Requests; /*!< Number of served requests*/
+    unsigned long long TotalLatency; /*!< Sum of the queueing latencies, in ns*/
+    unsigned long long MaxLatency; /*!< Worst queueing latency, in ns*/
+};
+
+// ==============================================================================
+// PROTOTYPES
+// ==============================================================================
+
+/**
+ * @brief Start the arbiter of a bus. Once started, a worker thread own the file descriptor and all of the
+ *        accesses done through any copy of the bus are queued to it.
+ *        Must be called before sharing the bus between threads.
+ *
+ * @param[inout] I2C A pointer on a struct that define bus informations.
+ *
+ * @return  0 : OK
+ * @return -1 : The bus has no context (not opened with I2C_GetInfos).
+ * @return -2 : The arbiter is already running.
+ */
+int I2C_ArbiterStart(I2C_Bus* I2C);
+
+/**
+ * @brief Stop the arbiter of a bus. Already queued requests are served before the worker exits.
+ *        No other thread shall access the bus once called. Called by I2C_Close if needed.
+ *
+ * @param[inout] I2C A pointer on a struct that define bus informations.
+ *
+ * @return  0 : OK
+ * @return -1 : The arbiter is not running.
+ */
+int I2C_ArbiterStop(I2C_Bus* I2C);
+
+/**
+ * @brief Execute an operation with exclusive access to the bus.
+ *        If an arbiter is running, the request is queued in the class of the bus copy, and the calling thread
+ *        is blocked until completion. Otherwise (or if called from the worker), the operation is run in place.
+ *
+ * @param[inout] I2C A pointer on a struct that define bus informations.
+ * @param[in] Operation The operation to be executed.
+ * @param[inout] Arguments The arguments of the operation. Must remain valid until the return.
+ *
+ * @return The value returned by the operation.
+ */
+int I2C_ArbiterExecute(I2C_Bus* I2C, I2C_Operation Operation, void* Arguments);
+
+/**
+ * @brief Queue a request to the arbiter without waiting for it.
+ *        Once executed, the Complete callback is called from the worker thread. The request shall not be
+ *        accessed by the arbiter after this call, thus the callback is free to release it.
+ *        The callback must be short, since the bus is not served while it runs.
+ *
+ * @param[inout] I2C A pointer on a struct that define bus informations.
+ * @param[inout] Request The request, with Operation, Arguments, I2C and Complete filled.
+ *
+ * @return  0 : OK
+ * @return -1 : The arbiter is not running.
+ */
+int I2C_ArbiterSubmit(I2C_Bus* I2C, I2C_Request* const Request);
+
+/**
+ * @brief Set the priority class of the requests issued through this copy of the bus.
+ *
+ * @param[inout] I2C A pointer on a struct that define bus informations.
+ * @param[in] Priority The priority class.
+ *
+ * @return 0 : OK
+ */
+int I2C_SetPriority(I2C_Bus* I2C, const I2C_PRIORITY Priority);
+
+/**
+ * @brief Return the queueing statistics of a priority class.
+ *
+ * @param[in] I2C A pointer on a struct that define bus informations.
+ * @param[in] Priority The priority class.
+ * @param[out] Statistics The statistics of the class.
+ *
+ * @return  0 : OK
+ * @return -1 : The arbiter is not running.
+ */
+int I2C_GetQueueStatistics(I2C_Bus* I2C,
+                           const I2C_PRIORITY Priority,
+                           I2C_QueueStatistics* const Statistics);
+
+// ==============================================================================
+// OPERATIONS
+// ==============================================================================
+// Raw accesses, executed by the arbiter with exclusive access to the bus.
+// Arguments are checked here, and the return codes are the ones of the public functions.
+
+/**
+ * @brief Operation behind I2C_Write. Arguments is an I2C_AccessArguments.
+ */
+int I2C_WriteDirect(I2C_Bus* I2C, void* Arguments);
+
+/**
+ * @brief Operation behind I2C_Read. Arguments is an I2C_AccessArguments.
+ */
+int I2C_ReadDirect(I2C_Bus* I2C, void* Arguments);
+
+/**
+ * @brief Operation behind I2C_TransactionSubmit. Arguments is an I2C_Transaction.
+ */
+int I2C_TransactionSubmitDirect(I2C_Bus* I2C, void* Arguments);
@@ -0,0 +1,164 @@
+/**
+ * @file I2C_Async.hpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define an asynchronous, coroutine based, access to the I2C bus.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @remark Coroutines are resumed from the arbiter worker thread once their request has been served. The code between
+ *         two co_await shall thus remain short, since the bus is not served while it runs.
+ *         Without a running arbiter, every access is done in place and the coroutines run to completion on call.
+ *
+ */
+
+#pragma once
+
+// Header
+#include "I2C_Arbiter.hpp"
+
+// STD
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+
+// ==============================================================================
+// DATA STRUCTURES
+// ==============================================================================
+
+/*! Define an awaitable access to the bus. Created by the I2C_xxxAsync functions, to be co_awaited at once.*/
+class I2C_Awaitable
+{
+public:
+    /**
+     * @brief Construct an awaitable for an SMBus based access.
+     *
+     * @param[in] I2C A pointer on a struct that define the settings for the currently used I2C bus.
+     * @param[in] Operation I2C_WriteDirect or I2C_ReadDirect.
+     * @param[in] Access The arguments of the access. Copied.
+     */
+    I2C_Awaitable(I2C_Bus* I2C, I2C_Operation Operation, const I2C_AccessArguments& Access);
+
+    /**
+     * @brief Construct an awaitable for any operation.
+     *
+     * @param[in] I2C A pointer on a struct that define the settings for the currently used I2C bus.
+     * @param[in] Operation The operation to be executed.
+     * @param[in] Arguments The arguments of the operation. Must remain valid until resumed.
+     */
+    I2C_Awaitable(I2C_Bus* I2C, I2C_Operation Operation, void* Arguments);
+
+    I2C_Awaitable(const I2C_Awaitable&) = delete;
+    I2C_Awaitable& operator=(const I2C_Awaitable&) = delete;
+
+    bool await_ready();
+    void await_suspend(std::coroutine_handle<> Coroutine);
+    int await_resume() const noexcept;
+
+private:
+    I2C_AccessArguments Access;
+    I2C_Request Request;
+};
+
+/*! Define a coroutine that return an I2C error code. Start immediately, and run until the first suspension.*/
+class I2C_Task
+{
+public:
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    /*! Publish the result, then resume the awaiting coroutine if any.*/
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+        std::coroutine_handle<> await_suspend(Handle Coroutine) noexcept;
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    struct promise_type
+    {
+        int Result = 0; /*!< Value given to co_return*/
+        std::atomic<uint32_t> Done{0}; /*!< Set once Result is valid*/
+        std::atomic<void*> Continuation{nullptr}; /*!< Awaiting coroutine, or a sentinel once done*/
+
+        I2C_Task get_return_object() noexcept
+        {
+            return I2C_Task(Handle::from_promise(*this));
+        }
+        std::suspend_never initial_suspend() const noexcept
+        {
+            return {};
+        }
+        FinalAwaiter final_suspend() const noexcept
+        {
+            return {};
+        }
+        void return_value(int Value) noexcept
+        {
+            Result = Value;
+        }
+        void unhandled_exception() const noexcept;
+    };
+
+    I2C_Task(I2C_Task&& Other) noexcept;
+    I2C_Task(const I2C_Task&) = delete;
+    I2C_Task& operator=(const I2C_Task&) = delete;
+
+    /**
+     * @brief Destroy the task. Block until completion if still running.
+     */
+    ~I2C_Task();
+
+    /**
+     * @brief Check if the task has completed, without blocking.
+     *
+     * @return true : The result is available.
+     */
+    bool Ready() const;
+
+    /**
+     * @brief Block the calling thread until the task has completed. Must not be called from the arbiter worker.
+     *
+     * @return The value given to co_return.
+     */
+    int Wait() const;
+
+    // Awaiting a task from another one
+    bool await_ready() const noexcept;
+    bool await_suspend(std::coroutine_handle<> Coroutine) noexcept;
+    int await_resume() const noexcept;
+
+private:
+    explicit I2C_Task(Handle Coroutine) noexcept;
+    Handle Coroutine;
+};
+
+// ==============================================================================
+// PROTOTYPES
+// ==============================================================================
+
+/**
+ * @brief Asynchronous version of I2C_Write. Shall be co_awaited, which return the I2C_Write error code.
+ *        Payload must remain valid until resumed.
+ */
+I2C_Awaitable I2C_WriteAsync(
+    I2C_Bus* I2C, int Address, int Register, int* Payload, int Size = 1, int DataSize = 1);
+
+/**
+ * @brief Asynchronous version of I2C_Read. Shall be co_awaited, which return the I2C_Read error code.
+ *        Payload must remain valid until resumed.
+ */
+I2C_Awaitable I2C_ReadAsync(
+    I2C_Bus* I2C, int Address, int Register, int* Payload, int Size = 1, int DataSize = 1);
+
+/**
+ * @brief Asynchronous version of I2C_TransactionSubmit. Shall be co_awaited, which return the
+ *        I2C_TransactionSubmit error code. The transaction must remain valid until resumed.
+ */
+I2C_Awaitable I2C_TransactionSubmitAsync(I2C_Bus* I2C, I2C_Transaction* const Transaction);
@@ -0,0 +1,99 @@
+/**
+ * @file I2C_Backend.hpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define the interface between the I2C engine and the hardware, and the Linux i2c-dev implementation of it.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+// STD
+#include <cstdint>
+#include <linux/i2c.h>
+
+// ==============================================================================
+// IC CLASS FUNCTIONS
+// ==============================================================================
+
+/**
+ * @brief Interface used by the I2C engine for every access to the bus.
+ *        All of the functions return 0 (or the read value) on success, and a negative errno otherwise.
+ *
+ */
+class I2C_Backend
+{
+public:
+    virtual ~I2C_Backend() = default;
+
+    /**
+     * @brief Select the slave used by the following SMBus accesses.
+     *
+     * @param[in] Address The address of the IC on the bus.
+     *
+     * @return  0 : OK
+     * @return <0 : -errno
+     */
+    virtual int SelectAddress(const int Address) = 0;
+
+    /**
+     * @brief Perform an SMBus access on the selected slave. Same semantic as the I2C_SMBUS ioctl.
+     *
+     * @param[in] ReadWrite I2C_SMBUS_READ or I2C_SMBUS_WRITE.
+     * @param[in] Command The command (register) byte.
+     * @param[in] Size The transaction type (I2C_SMBUS_BYTE_DATA, I2C_SMBUS_WORD_DATA...).
+     * @param[inout] Data The data to be sent, or received.
+     *
+     * @return  0 : OK
+     * @return <0 : -errno
+     */
+    virtual int SMBusAccess(const char ReadWrite,
+                            const uint8_t Command,
+                            const int Size,
+                            union i2c_smbus_data* const Data) = 0;
+
+    /**
+     * @brief Perform a combined transfer of several messages. Same semantic as the I2C_RDWR ioctl.
+     *
+     * @param[inout] Messages The messages, each one carrying it's own address.
+     * @param[in] Count The number of messages.
+     *
+     * @return  0 : OK
+     * @return <0 : -errno
+     */
+    virtual int Transfer(struct i2c_msg* const Messages, const int Count) = 0;
+};
+
+/**
+ * @brief Backend that use the Linux i2c-dev driver.
+ *
+ */
+class I2C_KernelBackend : public I2C_Backend
+{
+private:
+    int File;
+
+public:
+    /**
+     * @brief Construct a new kernel backend.
+     *
+     * @param[in] File The file descriptor of an opened /dev/i2c-N. Closed on destruction.
+     */
+    I2C_KernelBackend(const int File);
+
+    /**
+     * @brief Destroy the kernel backend, and close the file.
+     *
+     */
+    ~I2C_KernelBackend();
+
+    int SelectAddress(const int Address) override;
+    int SMBusAccess(const char ReadWrite,
+                    const uint8_t Command,
+                    const int Size,
+                    union i2c_smbus_data* const Data) override;
+    int Transfer(struct i2c_msg* const Messages, const int Count) override;
+};
@@ -13,6 +13,11 @@
 
 #pragma once
 
+// STD
+#include <bit>
+#include <cstdint>
+#include <linux/i2c.h>
+
 // ==============================================================================
 // MACROS
 // ==============================================================================
@@ -27,16 +32,74 @@ constexpr int SWAP_BYTES(int x)
     return (((x & 0x00FF) << 8) | (x & 0xFF00) >> 8);
 }
 
+/**
+ * @brief Convert a 16bit word, as received on the bus (MSB first), to the native endianness.
+ *        Resolved at compile time, no-op on big endian targets.
+ *
+ * @param x The word, as stored in memory by the bus.
+ * @return The native value.
+ */
+constexpr uint16_t I2C_FromBigEndian(uint16_t x)
+{
+    if constexpr(std::endian::native == std::endian::little)
+        return (uint16_t)((x << 8) | (x >> 8));
+    else
+        return x;
+}
+
 // ==============================================================================
 // DATA STRUCTURES
 // ==============================================================================
 
+struct I2C_Arbiter;
+class I2C_Backend;
+struct I2C_Trace;
+
+/*! Define the priority classes of the requests on the bus. Lower values are served first.*/
+enum class I2C_PRIORITY
+{
+    CONTROL = 0, /*!< User facing operations (volume, mute...)*/
+    NORMAL = 1, /*!< Default class*/
+    BACKGROUND = 2, /*!< Telemetry polling (temperatures, voltages, currents...)*/
+};
+
+constexpr int I2C_PRIORITY_COUNT = 3; /*!< Number of priority classes*/
+
+/*! Define the state shared by all of the copies of an I2C_Bus struct.
+ *  Drivers store the bus by value, thus anything that describe the file descriptor itself must live here. */
+struct I2C_Context
+{
+    int Address; /*!< Slave address currently selected on the file descriptor. -1 if unknown*/
+    unsigned long AddressRequests; /*!< Number of slave address selections requested*/
+    unsigned long AddressIoctls; /*!< Number of I2C_SLAVE ioctls really issued*/
+    I2C_Arbiter* Arbiter; /*!< Arbiter that own the file descriptor. nullptr if accesses are done by the calling thread*/
+    I2C_Backend* Backend; /*!< Implementation of the accesses (kernel driver, simulator...)*/
+    I2C_Trace* Trace; /*!< Instrumentation, nullptr if compiled without I2C_TRACE*/
+};
+
 /*! Define the struct used internally by the I2C driver */
 struct I2C_Bus
 {
-    int I2C_file; /*!< I2C file descriptor*/
+    int I2C_file; /*!< I2C file descriptor. Owned by the backend, -1 if not a kernel bus*/
     char I2C_filename[30]; /*!< I2C file name*/
     long I2C_bus; /*!< I2C bus number*/
+    I2C_Context* Context; /*!< State shared by all of the copies of this struct*/
+    I2C_PRIORITY Priority; /*!< Priority class of the requests issued through this copy*/
+};
+
+constexpr int I2C_MAX_MESSAGES = 42; /*!< Maximal number of messages per transaction (I2C_RDWR_IOCTL_MAX_MSGS)*/
+constexpr int I2C_TRANSACTION_BUFFER = 1024; /*!< Size in bytes of the staging area for written bytes*/
+
+/*! Define a list of I2C messages that will be submitted to the kernel in a single I2C_RDWR ioctl.
+ *  Each message begin with a (repeated) START, and the bus is only released after the last one.
+ *  Writes are staged on the internal buffer, reads are done in place on the caller buffer.
+ *  Messages point to the internal buffer, thus the struct shall not be copied once filled. */
+struct I2C_Transaction
+{
+    struct i2c_msg Messages[I2C_MAX_MESSAGES]; /*!< Messages to be sent, in order*/
+    uint8_t Buffer[I2C_TRANSACTION_BUFFER]; /*!< Staging area for the register and payload bytes*/
+    int MessageCount; /*!< Number of used messages*/
+    int BufferUsed; /*!< Number of used bytes on the staging area*/
 };
 
 // ==============================================================================
@@ -51,6 +114,15 @@ struct I2C_Bus
  */
 I2C_Bus* I2C_GetInfos();
 
+/**
+ * @brief Return a struct that handle an I2C bus implemented by the given backend (simulator...).
+ *
+ * @param[in] Backend The backend to be used. It's ownership is transferred to the bus, and it's deleted by I2C_Close.
+ *
+ * @return *I2C_Bus
+ */
+I2C_Bus* I2C_Open(I2C_Backend* Backend);
+
 /**
  * @brief Close the I2C Bus. Any operation tempted by after will be failed.
  *
@@ -61,6 +133,19 @@ I2C_Bus* I2C_GetInfos();
  */
 int I2C_Close(I2C_Bus* I2C);
 
+/**
+ * @brief Return the statistics of the slave address cache.
+ *        The I2C_SLAVE ioctl is only issued when the addressed IC differ from the previous one.
+ *
+ * @param[in] I2C A pointer on a struct that define bus informations.
+ * @param[out] Issued The number of I2C_SLAVE ioctls that were really issued.
+ * @param[out] Saved The number of I2C_SLAVE ioctls that were skipped thanks to the cache.
+ *
+ * @return  0 : OK
+ * @return -1 : The bus has no context (not opened with I2C_GetInfos nor I2C_Open).
+ */
+int I2C_GetAddressStatistics(I2C_Bus* I2C, unsigned long* const Issued, unsigned long* const Saved);
+
 /**
  * @brief This function perform a write of one or more bytes (depending on the lengh of the payload) to the I2C bus.
  *        For each write, the Register value is going to be incremented.
@@ -99,3 +184,121 @@ int I2C_Write(
  * @return -5 : IOCTL error.
  */
 int I2C_Read(I2C_Bus* I2C, int Address, int Register, int* Payload, int Size = 1, int DataSize = 1);
+
+
+/**
+ * @brief Reset a transaction to an empty state. Must be called before any other use.
+ *
+ * @param[out] Transaction A pointer to the transaction to be initialized.
+ *
+ * @return  0 : OK
+ */
+int I2C_TransactionInit(I2C_Transaction* const Transaction);
+
+/**
+ * @brief Append a write of Size bytes, starting at Register, to the transaction.
+ *        The register and the payload are sent as a single message : the IC must auto-increment it's register pointer.
+ *
+ * @param[inout] Transaction A pointer to an initialized transaction.
+ * @param[in] Address The address of the IC on the bus.
+ * @param[in] Register The register where the first byte shall be wrote.
+ * @param[in] Payload The bytes to be wrote.
+ * @param[in] Size The number of bytes to write.
+ *
+ * @return  0 : OK
+ * @return -1 : Incorrect Address.
+ * @return -2 : Incorrect Register.
+ * @return -3 : Too many messages on the transaction.
+ * @return -4 : Not enough space on the staging buffer.
+ */
+int I2C_TransactionWrite(I2C_Transaction* const Transaction,
+                         int Address,
+                         int Register,
+                         const uint8_t* const Payload,
+                         int Size);
+
+/**
+ * @brief Append a combined read (register write, repeated START, then read) of Size bytes to the transaction.
+ *        Data is stored directly on the Payload buffer once the transaction has been submitted.
+ *
+ * @param[inout] Transaction A pointer to an initialized transaction.
+ * @param[in] Address The address of the IC on the bus.
+ * @param[in] Register The register where the read shall start.
+ * @param[out] Payload The buffer to be filled. Must remain valid until the submission.
+ * @param[in] Size The number of bytes to read.
+ *
+ * @return  0 : OK
+ * @return -1 : Incorrect Address.
+ * @return -2 : Incorrect Register.
+ * @return -3 : Too many messages on the transaction.
+ * @return -4 : Not enough space on the staging buffer.
+ */
+int I2C_TransactionRead(
+    I2C_Transaction* const Transaction, int Address, int Register, uint8_t* const Payload, int Size);
+
+/**
+ * @brief Submit all of the messages of the transaction with a single I2C_RDWR ioctl.
+ *
+ * @param[inout] I2C A pointer on a struct that define the settings for the currently used I2C bus.
+ * @param[inout] Transaction The transaction to be sent. It's content is left untouched, and can be submitted again.
+ *
+ * @return  0 : OK
+ * @return -5 : IOCTL error.
+ */
+int I2C_TransactionSubmit(I2C_Bus* I2C, I2C_Transaction* const Transaction);
+
+/**
+ * @brief Write Size contiguous bytes starting at Register, as a single message.
+ *        The IC must auto-increment it's register pointer.
+ *
+ * @param[inout] I2C A pointer on a struct that define the settings for the currently used I2C bus.
+ * @param[in] Address The address of the IC on the bus.
+ * @param[in] Register The register where the first byte shall be wrote.
+ * @param[in] Payload The bytes to be wrote.
+ * @param[in] Size The number of bytes to write.
+ *
+ * @return  0 : Everything went fine.
+ * @return -1 : Incorrect Address.
+ * @return -2 : Incorrect Register.
+ * @return -3 : Incorrect Size.
+ * @return -5 : IOCTL error.
+ */
+int I2C_WriteBurst(
+    I2C_Bus* I2C, int Address, int Register, const uint8_t* const Payload, int Size);
+
+/**
+ * @brief Read Size contiguous bytes starting at Register, with a combined (repeated START) transaction.
+ *        The IC must auto-increment it's register pointer.
+ *
+ * @param[inout] I2C A pointer on a struct that define the settings for the currently used I2C bus.
+ * @param[in] Address The address of the IC on the bus.
+ * @param[in] Register The register where the read shall start.
+ * @param[out] Payload The buffer to be filled.
+ * @param[in] Size The number of bytes to read.
+ *
+ * @return  0 : Everything went fine.
+ * @return -1 : Incorrect Address.
+ * @return -2 : Incorrect Register.
+ * @return -3 : Incorrect Size.
+ * @return -5 : IOCTL error.
+ */
+int I2C_ReadBurst(I2C_Bus* I2C, int Address, int Register, uint8_t* const Payload, int Size);
+
+/**
+ * @brief Read Count contiguous 16bit registers, starting at Register, with a single I2C_RDWR transaction.
+ *        Each register is fetched by it's own combined read, thus the IC doesn't need to auto-increment.
+ *        Words are received MSB first and decoded in place to the native endianness.
+ *
+ * @param[inout] I2C A pointer on a struct that define the settings for the currently used I2C bus.
+ * @param[in] Address The address of the IC on the bus.
+ * @param[in] Register The first register to read.
+ * @param[out] Words The buffer to be filled, of at least Count words.
+ * @param[in] Count The number of registers to read. Up to I2C_MAX_MESSAGES / 2.
+ *
+ * @return  0 : Everything went fine.
+ * @return -1 : Incorrect Address.
+ * @return -2 : Incorrect Register.
+ * @return -3 : Incorrect Count.
+ * @return -5 : IOCTL error.
+ */
+int I2C_ReadWords(I2C_Bus* I2C, int Address, int Register, uint16_t* const Words, int Count);
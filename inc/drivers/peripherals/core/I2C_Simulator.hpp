@@ -0,0 +1,208 @@
+/**
+ * @file I2C_Simulator.hpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define an in-memory I2C bus, to run the drivers on the host (unit tests, benchmarks).
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+// Header
+#include "I2C_Backend.hpp"
+
+// STD
+#include <cstdint>
+#include <linux/i2c.h>
+#include <vector>
+
+// ==============================================================================
+// DATA STRUCTURES
+// ==============================================================================
+
+/*! Define the counters of the simulated bus*/
+struct I2C_SimulatorStatistics
+{
+    unsigned long Transfers; /*!< Number of SMBus accesses and combined transfers (thus, of ioctls)*/
+    unsigned long Messages; /*!< Number of messages (START conditions)*/
+    unsigned long Bytes; /*!< Number of data bytes, address bytes excluded*/
+    unsigned long AddressSelects; /*!< Number of slave selections (I2C_SLAVE ioctls)*/
+    unsigned long Nacks; /*!< Number of failed transfers*/
+    unsigned long long BusTime; /*!< Simulated bus occupation, in ns*/
+};
+
+// ==============================================================================
+// IC CLASS FUNCTIONS
+// ==============================================================================
+
+/**
+ * @brief Interface of a simulated slave. Each message addressed to it is forwarded, in order.
+ *
+ */
+class I2C_DeviceModel
+{
+public:
+    virtual ~I2C_DeviceModel() = default;
+
+    /**
+     * @brief Handle a write message.
+     *
+     * @param[in] Data The bytes sent by the master.
+     * @param[in] Size The number of bytes.
+     *
+     * @return  0 : ACK
+     * @return <0 : -errno, the message is NACKed.
+     */
+    virtual int Write(const uint8_t* const Data, const int Size) = 0;
+
+    /**
+     * @brief Handle a read message.
+     *
+     * @param[out] Data The bytes returned to the master.
+     * @param[in] Size The number of bytes.
+     *
+     * @return  0 : ACK
+     * @return <0 : -errno, the message is NACKed.
+     */
+    virtual int Read(uint8_t* const Data, const int Size) = 0;
+};
+
+/**
+ * @brief Generic register based slave : the first written byte select the register, then data is wrote or rode
+ *        from there, MSB first.
+ *
+ */
+class I2C_RegisterFile : public I2C_DeviceModel
+{
+private:
+    std::vector<uint8_t> Registers;
+    int Width;
+    bool AutoIncrement;
+    int Pointer;
+    int Offset;
+
+    void Advance();
+
+protected:
+    /**
+     * @brief Called once a register has been fully wrote by the master. Override to model side effects.
+     *
+     * @param[in] Register The written register.
+     */
+    virtual void OnRegisterWrite(const int Register);
+
+public:
+    /**
+     * @brief Construct a new register file of 256 registers, all cleared.
+     *
+     * @param[in] Width The size of each register, in bytes (1 or 2).
+     * @param[in] AutoIncrement If true, the pointer move to the next register once one has been fully accessed.
+     *                          Otherwise, the same register is accessed again.
+     */
+    I2C_RegisterFile(const int Width = 1, const bool AutoIncrement = true);
+
+    /**
+     * @brief Return the value of a register, without side effects.
+     *
+     * @param[in] Register The register.
+     * @return The value of the register.
+     */
+    int Peek(const int Register) const;
+
+    /**
+     * @brief Set the value of a register, without side effects.
+     *
+     * @param[in] Register The register.
+     * @param[in] Value The value.
+     */
+    void Poke(const int Register, const int Value);
+
+    int Write(const uint8_t* const Data, const int Size) override;
+    int Read(uint8_t* const Data, const int Size) override;
+};
+
+/**
+ * @brief Simulated bus. Messages are forwarded to the attached device models, and their timings are accounted
+ *        for (and optionally waited) according to the configured clock and latency.
+ *        SMBus accesses are converted to plain I2C messages, as done by the kernel for I2C adapters.
+ *
+ */
+class I2C_SimulatedBus : public I2C_Backend
+{
+private:
+    I2C_DeviceModel* Devices[128];
+    int Nacks[128];
+    int Address;
+
+    long ClockFrequency;
+    long TransferLatency;
+    bool RealTime;
+
+    I2C_SimulatorStatistics Statistics;
+
+    void Elapse(const struct i2c_msg* const Messages, const int Count);
+
+public:
+    /**
+     * @brief Construct a new, empty, simulated bus at 100 kHz, without latency.
+     *
+     */
+    I2C_SimulatedBus();
+
+    /**
+     * @brief Attach a device model to an address. The model is not owned by the bus.
+     *
+     * @param[in] Address The 7 bits address.
+     * @param[in] Device The model, or nullptr to detach.
+     *
+     * @return  0 : OK
+     * @return -1 : Incorrect address.
+     */
+    int Attach(const int Address, I2C_DeviceModel* const Device);
+
+    /**
+     * @brief NACK the next messages addressed to a device.
+     *
+     * @param[in] Address The 7 bits address.
+     * @param[in] Count The number of messages to be NACKed.
+     *
+     * @return  0 : OK
+     * @return -1 : Incorrect address.
+     */
+    int InjectNack(const int Address, const int Count);
+
+    /**
+     * @brief Configure the timings of the bus.
+     *
+     * @param[in] ClockFrequency SCL frequency, in Hz.
+     * @param[in] TransferLatency Fixed cost of each transfer (syscall, driver...), in us.
+     * @param[in] RealTime If true, the calling thread really wait for the transfer duration.
+     *
+     * @return  0 : OK
+     * @return -1 : Incorrect clock frequency.
+     */
+    int SetLatency(const long ClockFrequency, const long TransferLatency, const bool RealTime);
+
+    /**
+     * @brief Return the counters of the bus.
+     *
+     * @return I2C_SimulatorStatistics
+     */
+    I2C_SimulatorStatistics GetStatistics() const;
+
+    /**
+     * @brief Clear the counters of the bus.
+     *
+     */
+    void ResetStatistics();
+
+    int SelectAddress(const int Address) override;
+    int SMBusAccess(const char ReadWrite,
+                    const uint8_t Command,
+                    const int Size,
+                    union i2c_smbus_data* const Data) override;
+    int Transfer(struct i2c_msg* const Messages, const int Count) override;
+};
@@ -0,0 +1,161 @@
+/**
+ * @file I2C_Trace.hpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define the instrumentation of the I2C engine : per device and per register statistics, and a trace of the
+ *        last transactions.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @remark Only recorded when compiled with I2C_TRACE (cmake -DI2C_TRACE=ON). Otherwise, the hooks are compiled out
+ *         and every function of this file return -1.
+ *
+ */
+
+#pragma once
+
+// Header
+#include "I2C_Engine.hpp"
+
+// STD
+#include <cstdint>
+
+// ==============================================================================
+// CONSTANTS
+// ==============================================================================
+
+constexpr int I2C_TRACE_BUCKETS = 16; /*!< Latency histogram buckets. Bucket N count [2^(N+10), 2^(N+11)[ ns*/
+constexpr int I2C_TRACE_RECORDS = 4096; /*!< Depth of the trace ring buffer. Must be a power of 2*/
+constexpr uint32_t I2C_TRACE_MAGIC = 0x54433249; /*!< "I2CT", first word of a dump*/
+
+// ==============================================================================
+// DATA STRUCTURES
+// ==============================================================================
+
+/*! Define the counters of a device, or of a register*/
+struct I2C_TraceCounters
+{
+    unsigned long long Transactions; /*!< Number of transactions*/
+    unsigned long long Bytes; /*!< Number of data bytes (register bytes included)*/
+    unsigned long long Errors; /*!< Number of failed transactions*/
+    unsigned long long TotalLatency; /*!< Sum of the latencies, in ns*/
+    unsigned long Histogram[I2C_TRACE_BUCKETS]; /*!< Latency histogram*/
+};
+
+/*! Define a record of the trace, as stored in a dump*/
+struct I2C_TraceRecord
+{
+    uint64_t Timestamp; /*!< Start of the transaction, steady clock, in ns*/
+    uint32_t Latency; /*!< Duration of the transaction, in ns*/
+    uint16_t Bytes; /*!< Number of data bytes*/
+    uint8_t Address; /*!< Address of the device (of the first message)*/
+    uint8_t Register; /*!< First register*/
+    int32_t Result; /*!< 0 or -errno*/
+    uint32_t Reserved; /*!< Padding, 0*/
+};
+
+/*! Define the header of a dump, followed by Count records, oldest first*/
+struct I2C_TraceHeader
+{
+    uint32_t Magic; /*!< I2C_TRACE_MAGIC*/
+    uint16_t Version; /*!< 1*/
+    uint16_t RecordSize; /*!< sizeof(I2C_TraceRecord)*/
+    uint32_t Count; /*!< Number of records*/
+    uint32_t Lost; /*!< Number of records overwritten before the dump*/
+};
+
+// ==============================================================================
+// PROTOTYPES
+// ==============================================================================
+
+/**
+ * @brief Return the counters of a device.
+ *
+ * @param[in] I2C A pointer on a struct that define bus informations.
+ * @param[in] Address The address of the IC on the bus.
+ * @param[out] Counters The counters of the device.
+ *
+ * @return  0 : OK
+ * @return -1 : Tracing is not compiled in.
+ * @return -2 : Incorrect Address.
+ */
+int I2C_TraceGetDevice(I2C_Bus* I2C, const int Address, I2C_TraceCounters* const Counters);
+
+/**
+ * @brief Return the counters of a register of a device. Transactions are accounted to their first register.
+ *
+ * @param[in] I2C A pointer on a struct that define bus informations.
+ * @param[in] Address The address of the IC on the bus.
+ * @param[in] Register The register.
+ * @param[out] Counters The counters of the register. Cleared if never accessed.
+ *
+ * @return  0 : OK
+ * @return -1 : Tracing is not compiled in.
+ * @return -2 : Incorrect Address.
+ * @return -3 : Incorrect Register.
+ */
+int I2C_TraceGetRegister(I2C_Bus* I2C,
+                         const int Address,
+                         const int Register,
+                         I2C_TraceCounters* const Counters);
+
+/**
+ * @brief Write the content of the trace ring buffer to a binary file : an I2C_TraceHeader, then the records.
+ *        Records written during the dump may be torn.
+ *
+ * @param[in] I2C A pointer on a struct that define bus informations.
+ * @param[in] Filename The path of the file to be created.
+ *
+ * @return  0 : OK
+ * @return -1 : Tracing is not compiled in.
+ * @return -2 : Unable to write the file.
+ */
+int I2C_TraceDump(I2C_Bus* I2C, const char* const Filename);
+
+/**
+ * @brief Clear all of the counters, and the trace.
+ *
+ * @param[in] I2C A pointer on a struct that define bus informations.
+ *
+ * @return  0 : OK
+ * @return -1 : Tracing is not compiled in.
+ */
+int I2C_TraceReset(I2C_Bus* I2C);
+
+// ==============================================================================
+// ENGINE HOOKS
+// ==============================================================================
+// Used by the engine only.
+
+/**
+ * @brief Allocate the instrumentation of a bus. Return nullptr if not compiled in.
+ */
+I2C_Trace* I2C_TraceCreate();
+
+/**
+ * @brief Release the instrumentation of a bus.
+ */
+void I2C_TraceDestroy(I2C_Trace* Trace);
+
+/**
+ * @brief Return the current time, in ns, on the clock used by the trace.
+ */
+uint64_t I2C_TraceNow();
+
+/**
+ * @brief Account for a completed transaction.
+ *
+ * @param[inout] Trace The instrumentation of the bus.
+ * @param[in] Address The address of the device.
+ * @param[in] Register The first register.
+ * @param[in] Bytes The number of data bytes.
+ * @param[in] Result 0 or -errno.
+ * @param[in] Start The value of I2C_TraceNow() before the transaction.
+ */
+void I2C_TraceTransaction(I2C_Trace* const Trace,
+                          const int Address,
+                          const int Register,
+                          const int Bytes,
+                          const int Result,
+                          const uint64_t Start);
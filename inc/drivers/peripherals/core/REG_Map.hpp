@@ -0,0 +1,162 @@
+/**
+ * @file REG_Map.hpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define a compile time description of the registers of an IC : pages, addresses and bitfields.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @remark Header only. Fields layout, overlaps, page membership and contiguity are checked by the compiler, thus
+ *         packing constants is free, and packing runtime values is reduced to a mask and a shift per field.
+ *
+ */
+
+#pragma once
+
+// STD
+#include <cstdint>
+
+// ==============================================================================
+// DATA STRUCTURES
+// ==============================================================================
+
+/*! Define a register of an IC. Implicitly converted to its address, to be used with the I2C functions.*/
+struct REG_Register
+{
+    uint8_t Page; /*!< Page of the register, 0 for single page ICs*/
+    uint8_t Address; /*!< Address of the register within the page*/
+
+    constexpr operator int() const
+    {
+        return this->Address;
+    }
+    constexpr bool operator==(const REG_Register&) const = default;
+};
+
+/**
+ * @brief Define a bitfield of a register.
+ *
+ * @tparam Register The register that contain the field.
+ * @tparam Shift The position of the LSB of the field.
+ * @tparam Width The number of bits of the field. Single bit fields are booleans : any non null value set the bit.
+ */
+template <REG_Register Register, int Shift, int Width = 1>
+struct REG_Field
+{
+    static_assert((Shift >= 0) & (Width > 0) & (Shift + Width <= 8),
+                  "Field outside of the register");
+
+    static constexpr REG_Register Parent = Register;
+    static constexpr int Max = (1 << Width) - 1;
+    static constexpr uint8_t Mask = (uint8_t)(Max << Shift);
+
+    /**
+     * @brief Check that a value fit in the field.
+     */
+    static constexpr bool Valid(const int Value)
+    {
+        return (Value >= 0) & (Value <= Max);
+    }
+
+    /**
+     * @brief Place a value in the field. The value shall have been checked with Valid(), extra bits are dropped.
+     */
+    static constexpr uint8_t Pack(const int Value)
+    {
+        if constexpr(Width == 1)
+            return (uint8_t)((bool)Value << Shift);
+        else
+            return (uint8_t)((Value & Max) << Shift);
+    }
+
+    /**
+     * @brief Place a constant in the field. Checked at compile time.
+     */
+    template <int Value>
+    static constexpr uint8_t Pack()
+    {
+        static_assert((Width == 1) | ((Value >= 0) & (Value <= Max)),
+                      "Value does not fit in the field");
+        return Pack(Value);
+    }
+
+    /**
+     * @brief Return the value of the field from the content of the register.
+     */
+    static constexpr int Extract(const uint8_t Byte)
+    {
+        return (Byte & Mask) >> Shift;
+    }
+
+    /**
+     * @brief Replace the value of the field in the content of the register. Other bits are preserved.
+     */
+    static constexpr uint8_t Update(const uint8_t Byte, const int Value)
+    {
+        return (uint8_t)((Byte & ~Mask) | Pack(Value));
+    }
+};
+
+/*! Used to expand an int per field in the REG_Pack prototype.*/
+template <typename Field>
+using REG_Value = int;
+
+/**
+ * @brief Build the content of a register from the values of its fields. The fields shall be of the same register
+ *        and shall not overlap, which is checked at compile time. Unlisted bits are cleared.
+ *
+ * @tparam Fields The fields, in the order of the values.
+ * @param[in] Values The values, checked with Valid() before.
+ *
+ * @return The content of the register.
+ */
+template <typename First, typename... Fields>
+constexpr uint8_t REG_Pack(const REG_Value<First> Value, const REG_Value<Fields>... Values)
+{
+    static_assert(((Fields::Parent == First::Parent) && ...), "Fields of different registers");
+    static_assert((First::Mask + ... + Fields::Mask) == (First::Mask | ... | Fields::Mask),
+                  "Overlapping fields");
+
+    return (uint8_t)(First::Pack(Value) | ... | Fields::Pack(Values));
+}
+
+/**
+ * @brief Check that a list of registers follow each other, without gaps.
+ */
+template <REG_Register First, REG_Register... Next>
+constexpr bool REG_Contiguous()
+{
+    int Address = First.Address;
+    return ((Next.Address == ++Address) && ...);
+}
+
+/**
+ * @brief Define a set of registers written or read as a single auto-incremented burst. The registers shall be
+ *        listed in order, on the same page and without gaps, which is checked at compile time.
+ *
+ * @tparam First The first register of the burst.
+ * @tparam Next The following registers.
+ */
+template <REG_Register First, REG_Register... Next>
+struct REG_Burst
+{
+    static_assert(((Next.Page == First.Page) && ...), "Registers of different pages");
+    static_assert(REG_Contiguous<First, Next...>(), "Registers are not contiguous");
+
+    static constexpr REG_Register Register = First;
+    static constexpr uint8_t Page = First.Page;
+    static constexpr uint8_t Address = First.Address;
+    static constexpr int Length = 1 + sizeof...(Next);
+};
+
+/**
+ * @brief Page shared by a set of registers, checked at compile time. Used to emit a single page selection ahead of
+ *        accesses to registers that are not contiguous.
+ */
+template <REG_Register First, REG_Register... Next>
+constexpr uint8_t REG_Page()
+{
+    static_assert(((Next.Page == First.Page) && ...), "Registers of different pages");
+    return First.Page;
+}
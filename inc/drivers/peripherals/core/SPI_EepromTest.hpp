@@ -0,0 +1,84 @@
+/**
+ * @file SPI_EepromTest.hpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define the common test fixture of the EEPROM stack, on a simulated M95256.
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+// Including the unit test framework
+#include "CppUTest/TestHarness.h"
+
+// Simulated device, and the stack above it
+#include "drivers/devices/M95256.hpp"
+#include "drivers/peripherals/core/SPI_Simulator.hpp"
+#include "drivers/peripherals/spi.hpp"
+#include "modules/eeprom/queue/queue.hpp"
+
+// ==============================================================================
+// CLASS
+// ==============================================================================
+/**
+ * @brief Base of the test groups of the EEPROM stack : an erased M95256 without write cycle time, it's driver and
+ *        a queue. Use it with TEST_GROUP_BASE, and build the tested modules on Open().
+ *
+ */
+class SPI_EepromTest : public Utest
+{
+public:
+    SPI_EepromModel* Model;
+    SPI_Bus* Bus;
+    M95256* Eeprom;
+    EEPROM_QUEUE* Queue;
+
+    void setup() override
+    {
+        Model = new SPI_EepromModel();
+        Bus = SPI_Open(Model);
+        Eeprom = new M95256(Bus);
+        Queue = new EEPROM_QUEUE(Eeprom);
+        Open();
+    }
+    void teardown() override
+    {
+        Close();
+        delete Queue;
+        delete Eeprom;
+        SPI_Close(Bus);
+        delete Model;
+    }
+
+    /**
+     * @brief Build the tested modules above the queue. Called by setup() and Reboot().
+     *
+     */
+    virtual void Open()
+    {
+    }
+
+    /**
+     * @brief Destroy the tested modules. Called by teardown() and Reboot().
+     *
+     */
+    virtual void Close()
+    {
+    }
+
+    /**
+     * @brief Drop every RAM state, as after a reboot : the modules and the queue are built again. The device, and
+     *        it's driver, are kept.
+     *
+     */
+    void Reboot()
+    {
+        Close();
+        delete Queue;
+        Queue = new EEPROM_QUEUE(Eeprom);
+        Open();
+    }
+};
@@ -9,11 +9,14 @@
  *
  */
 
+#pragma once
+
 #include "linux/spi/spidev.h"
 #include <cstdint>
 #include <errno.h>
 #include <fcntl.h>
 #include <iostream>
+#include <span>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -23,6 +26,9 @@
 // ==============================================================================
 // DATA STRUCTURES
 // ==============================================================================
+
+class SPI_DeviceModel;
+
 /*! Define a struct that is used internally for the SPI driver */
 struct SPI_Bus
 {
@@ -39,10 +45,25 @@ struct SPI_Bus
         change; /*!< Defined automatically. Store the SPI Bus change speed after last cycle.*/
     unsigned char tx_nbits; /*!< Defined automatically. Store the SPI Bus tx bits per cycles.*/
     unsigned char rx_nbits; /*!< Defined automatically. Store the SPI Bus rx bits per cycle.*/
+    unsigned int bufsiz; /*!< Defined automatically. Maximal number of bytes per ioctl, 0 for SPI_MAX_TRANSFER.*/
+    SPI_DeviceModel* Model; /*!< Simulated slave that replace spidev, nullptr for a kernel bus. Not owned.*/
 };
 
 constexpr int SPI_DEFAULT_WORDSIZE = 8; /*!< Default value for SPI wordsize*/
 constexpr int SPI_DEFAULT_SPEED = 5'000'000; /*!< Default value for SPI speed*/
+constexpr int SPI_STACK_BUFFER = 64; /*!< Size of the stack buffers used by SPI_Transfer for converted words*/
+constexpr int SPI_MAX_SEGMENTS = 8; /*!< Maximal number of segments per transaction*/
+constexpr int SPI_MAX_TRANSFER = 4096; /*!< Default maximal number of bytes per ioctl (spidev bufsiz)*/
+
+/*! Define a list of segments that will be submitted to the kernel in a single SPI_IOC_MESSAGE(N) ioctl.
+ *  Segments point directly to the caller buffers, which shall remain valid until the submission.
+ *  CS remain asserted between two segments, unless the first one has been appended with Release set. */
+struct SPI_Transaction
+{
+    struct spi_ioc_transfer Segments[SPI_MAX_SEGMENTS]; /*!< Segments to be sent, in order*/
+    int SegmentCount; /*!< Number of used segments*/
+    int Length; /*!< Total number of bytes of the segments*/
+};
 
 /*! Define parameters of the SPI bus */
 enum class SPI_SLAVES
@@ -64,6 +85,15 @@ enum class SPI_SLAVES
  */
 SPI_Bus* SPI_GetInfos(SPI_SLAVES CS);
 
+/**
+ * @brief Return a struct for a bus where transfers are served by a simulated slave instead of spidev.
+ *
+ * @param[in] Model The simulated slave. It's not owned by the bus, and shall outlive it.
+ *
+ * @return A SPI struct, already configured with the default settings.
+ */
+SPI_Bus* SPI_Open(SPI_DeviceModel* const Model);
+
 /**
  * @brief Close and delete an SPI Object
  *
@@ -88,8 +118,72 @@ int SPI_Close(SPI_Bus* bus);
  */
 int SPI_Configure(SPI_Bus* SPI, int Mode, int WordSize, int Speed);
 
+/**
+ * @brief Return the maximal number of bytes that can be exchanged with a single ioctl on the bus.
+ *
+ * @param[in] SPI A SPI_Bus struct that serve as base
+ *
+ * @return The spidev bufsiz, or SPI_MAX_TRANSFER if unknown.
+ */
+int SPI_GetMaxTransfer(const SPI_Bus* SPI);
+
+/**
+ * @brief Perform a full duplex transfer of bytes, straight from and to the caller buffers. No copy, nor allocation.
+ *        The same buffer can be used for both directions.
+ *
+ * @param[inout] SPI A SPI_Bus struct that serve as base
+ * @param[in] TX The bytes to be written. May be empty for a read only transfer (zeros are sent).
+ * @param[out] RX The bytes to be read. May be empty for a write only transfer.
+ *
+ * @return  0 : OK
+ * @return -1 : TX and RX are of different sizes.
+ * @return -2 : IOCTL error.
+ */
+int SPI_Transfer(SPI_Bus* SPI, const std::span<const uint8_t> TX, const std::span<uint8_t> RX);
+
+/**
+ * @brief Reset a transaction to an empty state. Must be called before any other use.
+ *
+ * @param[out] Transaction A pointer to the transaction to be initialized.
+ *
+ * @return  0 : OK
+ */
+int SPI_TransactionInit(SPI_Transaction* const Transaction);
+
+/**
+ * @brief Append a segment to the transaction. Buffers are used in place, with the same rules as SPI_Transfer.
+ *
+ * @param[inout] Transaction A pointer to an initialized transaction.
+ * @param[in] TX The bytes to be written. May be empty for a read only segment.
+ * @param[out] RX The bytes to be read. May be empty for a write only segment. Must remain valid until the submission.
+ * @param[in] Release Deassert CS after this segment, for ICs that latch a command on the CS rising edge.
+ *                    Shall not be set on the last segment, where it would keep CS asserted after the transaction.
+ *
+ * @return  0 : OK
+ * @return -1 : TX and RX are of different sizes.
+ * @return -2 : Too many segments on the transaction.
+ */
+int SPI_TransactionAppend(SPI_Transaction* const Transaction,
+                          const std::span<const uint8_t> TX,
+                          const std::span<uint8_t> RX,
+                          const bool Release = false);
+
+/**
+ * @brief Submit all of the segments of the transaction with a single SPI_IOC_MESSAGE(N) ioctl.
+ *
+ * @param[inout] SPI A SPI_Bus struct that serve as base
+ * @param[inout] Transaction The transaction to be sent. Can be submitted again.
+ *
+ * @return  0 : OK
+ * @return -3 : Transaction longer than the bufsiz of the bus.
+ * @return -4 : IOCTL error.
+ */
+int SPI_TransactionSubmit(SPI_Bus* SPI, SPI_Transaction* const Transaction);
+
 /**
  * @brief Read N bytes from the bus. The order of bytes to transfer is leaved at the appreciation of an higher level code.
+ *        Each element is converted to a byte. Up to SPI_STACK_BUFFER elements, the conversion is done on the stack.
+ *        Prefer the std::span version for byte buffers.
  *
  * @param[inout] SPI A SPI_Bus struct that serve as base
  * @param[in] InputBuffer The payload to be written.
@@ -104,64 +198,51 @@ int SPI_Configure(SPI_Bus* SPI, int Mode, int WordSize, int Speed);
 template <typename I, typename O>
 int SPI_Transfer(SPI_Bus* SPI, I* const InputBuffer, O* const OutputBufer, const int Len)
 {
-    // Allocate a unsigned long long buffer to store the data to be written.
-    __u8* TX = (__u8*)malloc(sizeof(__u8) * Len);
-    if(TX == 0)
+    uint8_t StackTX[SPI_STACK_BUFFER];
+    uint8_t StackRX[SPI_STACK_BUFFER];
+    uint8_t* TX = StackTX;
+    uint8_t* RX = StackRX;
+
+    // Only long transfers are converted on the heap.
+    if(Len > SPI_STACK_BUFFER)
     {
-        std::cerr << "[ SPI ][ Transfer ] : Could not allocate the input buffer : "
-                  << strerror(errno) << std::endl;
-        return -1;
+        TX = (uint8_t*)malloc(sizeof(uint8_t) * Len);
+        if(TX == 0)
+        {
+            std::cerr << "[ SPI ][ Transfer ] : Could not allocate the input buffer : "
+                      << strerror(errno) << std::endl;
+            return -1;
+        }
+
+        RX = (uint8_t*)malloc(sizeof(uint8_t) * Len);
+        if(RX == 0)
+        {
+            std::cerr << "[ SPI ][ Transfer ] : Could not allocate the output buffer : "
+                      << strerror(errno) << std::endl;
+            free(TX);
+            return -2;
+        }
     }
 
     // Let's copy all of the input data to the new one !
     for(int i = 0; i < Len; i++)
-        TX[i] = (__u8)InputBuffer[i];
+        TX[i] = (uint8_t)InputBuffer[i];
 
-    // Allocate a unsigned long long buffer to the data to be rode.
-    __u8* RX = (__u8*)malloc(sizeof(__u8) * Len);
-    if(RX == 0)
-    {
-        std::cerr << "[ SPI ][ Transfer ] : Could not allocate the output buffer : "
-                  << strerror(errno) << std::endl;
-        return -2;
-    }
-    memset(RX, 0x00, Len * sizeof(__u8));
-
-    struct spi_ioc_transfer message = {
-        .tx_buf = (unsigned long)TX,
-        .rx_buf = (unsigned long)RX,
-        .len = (unsigned int)Len,
-        .speed_hz = SPI->speed,
-        .delay_usecs = SPI->delay,
-        .bits_per_word = SPI->bits,
-        .cs_change = SPI->change,
-        .tx_nbits = SPI->tx_nbits,
-        .rx_nbits = SPI->rx_nbits,
-        .word_delay_usecs = SPI->delay,
-        .pad = 0, // padding, remain at 0
-    };
-
-    // Perform IOCTL
-    int res = 0;
-    res = ioctl(SPI->SPI_file, SPI_IOC_MESSAGE(1), &message);
-    if(res < 0)
-    {
-        std::cerr << "[ SPI ][ Transfer ] : Could not perform transfer operation on bus "
-                  << SPI->SPI_Bus << " : " << strerror(errno) << std::endl;
-        free(RX);
-        free(TX);
-        return -3;
-    }
+    int res = SPI_Transfer(
+        SPI, std::span<const uint8_t>(TX, Len), std::span<uint8_t>(RX, Len));
 
     // Let's copy all of the output data.
-    for(int i = 0; i < Len; i++)
+    if(res == 0)
+        for(int i = 0; i < Len; i++)
+            OutputBufer[i] = (O)RX[i];
+
+    if(Len > SPI_STACK_BUFFER)
     {
-        OutputBufer[i] = (O)RX[i];
+        free(RX);
+        free(TX);
     }
 
-    // Free de allocated buffers.
-    free(RX);
-    free(TX);
-
+    if(res != 0)
+        return -3;
     return 0;
 }
\ No newline at end of file
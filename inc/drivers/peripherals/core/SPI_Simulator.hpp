@@ -0,0 +1,205 @@
+/**
+ * @file SPI_Simulator.hpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define in-memory SPI devices, to run the drivers on the host (unit tests, benchmarks).
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+// STD
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <linux/spi/spidev.h>
+#include <mutex>
+#include <vector>
+
+// ==============================================================================
+// IC CLASS FUNCTIONS
+// ==============================================================================
+
+/**
+ * @brief Interface of a simulated slave. A bus opened with SPI_Open() forward it each frame, as seen on the wires :
+ *        CS assertion, the bytes exchanged, then CS release.
+ *
+ */
+class SPI_DeviceModel
+{
+public:
+    virtual ~SPI_DeviceModel() = default;
+
+    /**
+     * @brief CS has been asserted : a new frame start.
+     *
+     */
+    virtual void Select() = 0;
+
+    /**
+     * @brief Exchange bytes within the current frame. May be called several times per frame.
+     *
+     * @param[in] TX The bytes sent by the master, or nullptr if zeros are sent.
+     * @param[out] RX The bytes returned to the master, or nullptr if they are discarded.
+     * @param[in] Len The number of bytes.
+     *
+     * @return  0 : OK
+     * @return <0 : -errno, the whole ioctl fail.
+     */
+    virtual int Exchange(const uint8_t* const TX, uint8_t* const RX, const int Len) = 0;
+
+    /**
+     * @brief CS has been released : the frame is over.
+     *
+     */
+    virtual void Deselect() = 0;
+};
+
+/**
+ * @brief Serial EEPROM of the M95xxx family (WREN, WRDI, RDSR, WRSR, READ, WRITE). Writes are programmed on the CS
+ *        rising edge, wrap within a page, and start a write cycle during which only RDSR is answered.
+ *        Faults can be injected : failed transfers, and power losses after a given number of programmed pages.
+ *
+ */
+class SPI_EepromModel : public SPI_DeviceModel
+{
+private:
+    std::mutex Lock;
+    std::vector<uint8_t> Memory;
+    int PageSize;
+
+    std::vector<uint8_t> Frame; /*!< Bytes received since the CS assertion*/
+    uint8_t Status; /*!< Status register, WIP and WEL excluded*/
+    bool WriteEnabled;
+    long Cycle; /*!< Duration of a write cycle, in us*/
+    std::chrono::steady_clock::time_point CycleEnd;
+
+    int Failures; /*!< Number of next WRITE frames to be failed*/
+    int Skipped; /*!< Number of WRITE frames let through before the failures*/
+    int Remaining; /*!< Number of pages programmed before the power loss, negative if none is planned*/
+    bool Torn; /*!< The interrupted page is half programmed*/
+    bool Powered;
+    bool Held; /*!< The WRITE frames wait for Release()*/
+    int Waiting; /*!< Number of WRITE frames held*/
+    std::condition_variable Resume;
+    std::vector<int> Log; /*!< Address of each programmed WRITE frame, in order*/
+
+    bool Busy() const;
+    void Program(const int Address, const uint8_t* const Data, const int Len);
+
+public:
+    /**
+     * @brief Construct a new, erased (0xFF), EEPROM without write cycle time.
+     *
+     * @param[in] Size Size in bytes of the array.
+     * @param[in] PageSize Size in bytes of a page.
+     */
+    SPI_EepromModel(const int Size = 0x8000, const int PageSize = 64);
+
+    /**
+     * @brief Configure the duration of the write cycles.
+     *
+     * @param[in] Cycle Duration, in us.
+     */
+    void SetCycle(const long Cycle);
+
+    /**
+     * @brief Fail the next WRITE frames : their ioctl return an error, and nothing is programmed.
+     *
+     * @param[in] Count The number of frames.
+     * @param[in] After The number of WRITE frames programmed before the first failure.
+     */
+    void InjectFailure(const int Count, const int After = 0);
+
+    /**
+     * @brief Lose the power once a number of pages have been programmed. Every following transfer fail, until
+     *        Restore().
+     *
+     * @param[in] Pages The number of pages still programmed.
+     * @param[in] Torn If true, the first half of the interrupted page is programmed.
+     */
+    void CutPower(const int Pages, const bool Torn = false);
+
+    /**
+     * @brief Power the device again, without any pending write cycle nor write enable.
+     *
+     */
+    void Restore();
+
+    /**
+     * @brief Hold the next WRITE frames on their first byte, until Release(). The writer is blocked in it's ioctl.
+     *
+     */
+    void Hold();
+
+    /**
+     * @brief Wait until a WRITE frame is held.
+     *
+     */
+    void WaitHeld();
+
+    /**
+     * @brief Let the held WRITE frames, and the next ones, go on.
+     *
+     */
+    void Release();
+
+    /**
+     * @brief Return true while the device is powered.
+     */
+    bool IsPowered();
+
+    /**
+     * @brief Read the array, without side effects.
+     *
+     * @param[in] Address Address of the first byte.
+     * @param[out] Data The bytes.
+     * @param[in] Len The number of bytes.
+     */
+    void Peek(const int Address, uint8_t* const Data, const int Len);
+
+    /**
+     * @brief Write the array, without side effects.
+     *
+     * @param[in] Address Address of the first byte.
+     * @param[in] Data The bytes.
+     * @param[in] Len The number of bytes.
+     */
+    void Poke(const int Address, const uint8_t* const Data, const int Len);
+
+    /**
+     * @brief Return the address of each programmed WRITE frame, in order.
+     */
+    std::vector<int> GetLog();
+
+    /**
+     * @brief Clear the log of the programmed frames.
+     *
+     */
+    void ClearLog();
+
+    void Select() override;
+    int Exchange(const uint8_t* const TX, uint8_t* const RX, const int Len) override;
+    void Deselect() override;
+};
+
+// ==============================================================================
+// FUNCTIONS
+// ==============================================================================
+
+/**
+ * @brief Forward the segments of a SPI_IOC_MESSAGE(N) ioctl to a model, with the CS handling of spidev.
+ *
+ * @param[inout] Model The simulated slave.
+ * @param[inout] Segments The segments, with the same semantic as for the kernel.
+ * @param[in] Count The number of segments.
+ *
+ * @return  0 : OK
+ * @return <0 : -errno
+ */
+int SPI_SimulateTransfer(SPI_DeviceModel* const Model,
+                         const struct spi_ioc_transfer* const Segments,
+                         const int Count);
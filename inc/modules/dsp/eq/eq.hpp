@@ -0,0 +1,160 @@
+/**
+ * @file eq.hpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define a compiler from parametric EQ bands to DSP coefficients.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @remark Each band is designed as a biquad, with the formulas of the RBJ audio EQ cookbook, at the sample rate of
+ *         the stream. The biquads are wrote one after the other, from a first coefficient chosen by the DSP program,
+ *         as 5 coefficients normalized by a0 : b0, b1, b2, -a1, -a2. The feedback terms are negated, since the
+ *         program accumulate them. Coefficients are quantized to the 4.20 fixed point format, and the report give
+ *         the effect of the quantization on the coefficients and on the response of the whole EQ.
+ *
+ */
+
+#pragma once
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+// Modules
+#include "modules/eeprom/dsp_profile/dsp_profile.hpp"
+
+// STD
+#include <cstdint>
+
+// ==============================================================================
+// CONSTANTS
+// ==============================================================================
+constexpr int EQ_MAX_BANDS = 16; /*!< Maximal number of bands of an EQ*/
+constexpr int EQ_BIQUAD_COEFFICIENTS = 5; /*!< Number of coefficients of a band*/
+constexpr int EQ_COEFFICIENT_WIDTH = 3; /*!< Size in bytes of a formatted coefficient*/
+constexpr float EQ_MAX_GAIN = 24.0f; /*!< Maximal gain of a band, in dB*/
+constexpr int EQ_REPORT_POINTS = 64; /*!< Number of frequencies on which the response error is evaluated*/
+constexpr float EQ_REPORT_LOW = 20.0f; /*!< Lowest evaluated frequency, in Hz*/
+
+// ==============================================================================
+// ENUMS
+// ==============================================================================
+/*! Enum used to select the filter of a band*/
+enum class EQ_FILTER
+{
+    PEAKING, /*!< Bell around the frequency. Use the gain and the Q*/
+    LOW_SHELF, /*!< Gain below the frequency. Use the gain and the Q as the shelf slope*/
+    HIGH_SHELF, /*!< Gain above the frequency. Use the gain and the Q as the shelf slope*/
+    LOW_PASS, /*!< Second order low pass. Use the Q*/
+    HIGH_PASS, /*!< Second order high pass. Use the Q*/
+};
+
+// ==============================================================================
+// DATA STRUCTURES
+// ==============================================================================
+
+/*! Define a band of the EQ*/
+struct EQ_BAND
+{
+    EQ_FILTER Type; /*!< Filter of the band*/
+    float Frequency; /*!< Center, corner or cutoff frequency, in Hz*/
+    float Gain; /*!< Gain in dB, ignored by the pass filters*/
+    float Q; /*!< Quality factor. 0.707 give a flat pass filter*/
+};
+
+/*! Define the effect of the quantization on a compiled EQ*/
+struct EQ_REPORT
+{
+    float MaxError; /*!< Largest error on a coefficient, once quantized*/
+    int Worst; /*!< Index of this coefficient, from the first one of the EQ*/
+    float ResponseError; /*!< Largest difference between the quantized and the designed responses, in dB*/
+    float Frequency; /*!< Frequency of this difference, in Hz*/
+    bool Stable; /*!< Every quantized biquad has it's poles within the unit circle*/
+};
+
+// ==============================================================================
+// CLASS
+// ==============================================================================
+/**
+ * @brief Parametric EQ compiler. Bands are kept as parameters, and designed at each compilation.
+ *
+ */
+class DSP_EQ
+{
+private:
+    float SampleRate; /*!< Sample rate of the stream, in Hz*/
+    int First; /*!< Index of the first coefficient of the EQ, on the CRAM buffers*/
+    EQ_BAND Bands[EQ_MAX_BANDS];
+    int Count;
+
+    static void Design(const EQ_BAND& Band, const double Rate, double* const Coefficients);
+    static double Response(const double* const Coefficients, const double Omega);
+
+public:
+    /**
+     * @brief Construct a new EQ, without any band.
+     *
+     * @param[in] SampleRate Sample rate of the stream, in Hz.
+     * @param[in] First Index of the first coefficient of the EQ, as expected by the DSP program.
+     */
+    DSP_EQ(const float SampleRate, const int First = 0);
+
+    /**
+     * @brief Change the sample rate. The bands are kept, and designed for it by the next compilation.
+     *
+     * @param[in] SampleRate Sample rate of the stream, in Hz.
+     *
+     * @return  0 : OK
+     * @return -1 : Invalid sample rate.
+     */
+    int SetSampleRate(const float SampleRate);
+
+    /**
+     * @brief Add a band after the existing ones.
+     *
+     * @param[in] Band The band. The frequency is checked against the sample rate by the compilation.
+     *
+     * @return  0 : OK
+     * @return -1 : Invalid frequency, gain or Q.
+     * @return -2 : Already EQ_MAX_BANDS bands.
+     */
+    int AddBand(const EQ_BAND& Band);
+
+    /**
+     * @brief Remove all of the bands.
+     *
+     */
+    void Clear();
+
+    /**
+     * @brief Return the number of coefficients of the EQ.
+     */
+    int GetCoefficients() const;
+
+    /**
+     * @brief Design and quantize the bands.
+     *
+     * @param[out] Out A pointer to GetCoefficients() * EQ_COEFFICIENT_WIDTH bytes, for the coefficients formatted as
+     *                 4.20 fixed point words of 3 bytes, MSB first. Ready for DSP_LIVE::Set().
+     * @param[out] Report If not null, the effect of the quantization.
+     *
+     * @return  0 : OK
+     * @return -1 : A band is above the Nyquist frequency.
+     * @return -2 : A coefficient cannot be represented on 4.20 fixed point.
+     */
+    int Compile(uint8_t* const Out, EQ_REPORT* const Report = nullptr);
+
+    /**
+     * @brief Design and quantize the bands, then write them on both of the coefficient buffers of a profile. The
+     *        other coefficients, and the instructions, are kept.
+     *
+     * @param[inout] Profile The profile, that already hold the DSP program.
+     * @param[out] Report If not null, the effect of the quantization.
+     *
+     * @return  0 : OK
+     * @return -1 : A band is above the Nyquist frequency.
+     * @return -2 : A coefficient cannot be represented on 4.20 fixed point.
+     * @return -3 : The EQ doesn't fit the coefficient buffers of the profile.
+     */
+    int Compile(DSP_PROFILE* const Profile, EQ_REPORT* const Report = nullptr);
+};
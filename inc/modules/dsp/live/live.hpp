@@ -0,0 +1,126 @@
+/**
+ * @file live.hpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define a service that update the DSP coefficients while the audio is playing.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @remark The DAC shall be in adaptive mode : the DSP use one CRAM buffer while the other can be wrote. Updates are
+ *         merged on an image of the coefficients, and a worker write them on the inactive buffer, then switch the
+ *         buffers between two audio frames. Each buffer remember the range of coefficients that it missed, and is
+ *         brought up to date the next time it become inactive. Updates received while the worker is busy are
+ *         merged on the next switch : the latency is bounded by two uploads, whatever the rate of the updates.
+ *
+ */
+
+#pragma once
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+// Drivers
+#include "drivers/devices/PCM5252.hpp"
+
+// STD
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+// ==============================================================================
+// CONSTANTS
+// ==============================================================================
+constexpr int LIVE_COEFFICIENTS = 270; /*!< Number of coefficients of a CRAM buffer*/
+constexpr int LIVE_COEFFICIENT_WIDTH = 3; /*!< Size in bytes of a formatted coefficient*/
+constexpr int LIVE_SWAP_TIMEOUT = 10; /*!< Maximal time waited for the DSP to switch the buffers, in ms*/
+
+// ==============================================================================
+// DATA STRUCTURES
+// ==============================================================================
+
+/*! Define the statistics of the service*/
+struct LIVE_STATISTICS
+{
+    unsigned long Requests; /*!< Number of updates received*/
+    unsigned long Coalesced; /*!< Number of updates merged with a pending one*/
+    unsigned long Swaps; /*!< Number of confirmed buffer switches*/
+    unsigned long Errors; /*!< Number of failed uploads or switches*/
+    unsigned long long Latency; /*!< Time between the oldest merged update and it's switch, for the last one, in ns*/
+    unsigned long long MaxLatency; /*!< Maximal latency, in ns*/
+};
+
+// ==============================================================================
+// CLASS
+// ==============================================================================
+/**
+ * @brief Live coefficient update service. While it runs, the DAC shall not be accessed by another thread.
+ *
+ */
+class DSP_LIVE
+{
+private:
+    PCM5252* Dac;
+    std::mutex Lock; /*!< Protect the image, the ranges and the statistics*/
+    std::condition_variable Wake; /*!< Signaled on new updates, and on stop*/
+    std::condition_variable Idle; /*!< Signaled once every update has been switched*/
+
+    uint8_t Image[LIVE_COEFFICIENTS * LIVE_COEFFICIENT_WIDTH]; /*!< Coefficients, pending updates included*/
+    int Stale[2][2]; /*!< For the buffers A and B, first and last + 1 coefficients that differ from the image*/
+    bool Pending; /*!< Updates not yet taken by the worker*/
+    bool Busy; /*!< The worker is uploading*/
+    bool Running;
+    int Result; /*!< Result of the last upload*/
+    std::chrono::steady_clock::time_point Oldest; /*!< Time of the oldest pending update*/
+
+    LIVE_STATISTICS Statistics;
+    std::thread Worker;
+
+    void Work();
+    int Swap();
+
+public:
+    /**
+     * @brief Construct a new service, and start it's worker. Both of the CRAM buffers shall already hold the
+     *        coefficients, and the adaptive mode shall be enabled.
+     *
+     * @param[inout] Dac The DAC. Must remain valid until the service is destroyed.
+     * @param[in] Coefficients The coefficients on the buffers, 3 bytes each.
+     * @param[in] Count The number of coefficients, up to LIVE_COEFFICIENTS. The others are null.
+     */
+    DSP_LIVE(PCM5252* const Dac, const uint8_t* const Coefficients, const int Count);
+
+    /**
+     * @brief Switch the pending updates, then stop the worker.
+     *
+     */
+    ~DSP_LIVE();
+
+    /**
+     * @brief Queue an update. The coefficients are copied, and the call never wait for the DAC.
+     *
+     * @param[in] First Index of the first updated coefficient.
+     * @param[in] Values The coefficients, formatted as 4.20 fixed point words of 3 bytes, MSB first.
+     * @param[in] Count The number of coefficients.
+     *
+     * @return  0 : OK
+     * @return -1 : Coefficients out of the buffer.
+     */
+    int Set(const int First, const uint8_t* const Values, const int Count);
+
+    /**
+     * @brief Wait until every queued update is used by the DSP.
+     *
+     * @return  0 : OK
+     * @return -1 : IOCTL error. The update will be sent again by the next one.
+     * @return -2 : The DSP didn't confirm the switch.
+     */
+    int Sync();
+
+    /**
+     * @brief Return the statistics of the service.
+     */
+    LIVE_STATISTICS GetStatistics();
+};
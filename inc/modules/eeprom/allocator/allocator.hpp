@@ -0,0 +1,241 @@
+/**
+ * @file allocator.hpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define an allocator for the DSP profiles region of the EEPROM.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @remark The extents of the profiles are stored on a directory, kept on a journal. Profiles are placed on the
+ *         smallest free extent that fit them. Holes are reclaimed by compaction steps, which slide the first
+ *         profile above a hole down to it. A move is copied by chunks no larger than the shift, and the progress
+ *         is journaled after each chunk : a chunk only overwrite source bytes that are already copied, and a
+ *         move interrupted by a power loss is resumed by the next step.
+ *         Entries are programmed after the data, thus the extents freed by a removal are only reused once the
+ *         removal has been programmed : the data of a new profile never overwrite a profile still on the directory.
+ *
+ */
+
+#pragma once
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+#include "modules/eeprom/header/header.hpp"
+#include "modules/eeprom/journal/journal.hpp"
+#include "modules/eeprom/queue/queue.hpp"
+
+// STD
+#include <cstdint>
+#include <future>
+#include <map>
+#include <vector>
+
+// ==============================================================================
+// CONSTANTS
+// ==============================================================================
+constexpr int PROFILE_MAX = 31; /*!< Maximal number of DSP profiles on the directory*/
+constexpr int PROFILE_MOVE_CHUNK = 8; /*!< Maximal number of pages copied by a compaction step*/
+
+// ==============================================================================
+// DATA STRUCTURES
+// ==============================================================================
+
+/*! Define a move in progress, as journaled by the compaction.*/
+struct PROFILE_MOVE
+{
+    uint8_t Active; /*!< Set while a profile is being moved*/
+    uint8_t Profile; /*!< Moved profile*/
+    uint16_t From; /*!< Address of the profile before the move*/
+    uint16_t To; /*!< Address of the profile after the move*/
+    uint16_t Done; /*!< Bytes already copied*/
+};
+
+/*! Define the directory of the profiles, as stored on the journal.*/
+struct PROFILE_DIRECTORY
+{
+    struct DSP_PROFILE_INFO Profile[PROFILE_MAX]; /*!< Extents of the profiles. A null Len mark a free entry*/
+    struct PROFILE_MOVE Move; /*!< Move in progress*/
+};
+
+static_assert(sizeof(PROFILE_DIRECTORY) == 256, "The directory shall fit a journal state");
+
+/*! Define an extent freed by a removal, reserved until the removal has been programmed.*/
+struct PROFILE_RELEASE
+{
+    std::shared_future<int> Done; /*!< Future of the directory change*/
+    int Address; /*!< Address of the extent*/
+    int Len; /*!< Size in bytes of the extent*/
+};
+
+/*! Define the statistics of the allocator*/
+struct ALLOCATOR_STATISTICS
+{
+    unsigned long Allocations; /*!< Number of stored profiles*/
+    unsigned long Moves; /*!< Number of completed moves*/
+    unsigned long Copied; /*!< Number of bytes copied by the moves*/
+};
+
+// ==============================================================================
+// CLASS
+// ==============================================================================
+/**
+ * @brief Allocator for the DSP profiles region. Once mounted, all of the accesses to the region shall be done
+ *        through it.
+ *
+ */
+class EEPROM_ALLOCATOR
+{
+private:
+    EEPROM_QUEUE* Queue;
+    EEPROM_JOURNAL* Journal;
+    int Address; /*!< Address of the region, aligned on a page*/
+    int Size; /*!< Size in bytes of the region, multiple of PAGE_SIZE*/
+
+    PROFILE_DIRECTORY Directory;
+    std::map<int, int> Free; /*!< Free extents : size in bytes, by address*/
+    std::vector<PROFILE_RELEASE> Quarantine; /*!< Extents freed by the removals not yet programmed, or failed*/
+    bool Mounted;
+
+    ALLOCATOR_STATISTICS Statistics;
+
+    static int Extent(const int Len);
+    void Release(const bool Wait);
+    void Index();
+    int Fit(const int Len) const;
+    int Used() const;
+    int Commit(std::shared_future<int>* const Done);
+
+public:
+    /**
+     * @brief Construct a new allocator. Nothing is read until Mount().
+     *
+     * @param[inout] Queue The queue used to access the EEPROM.
+     * @param[in] Address Address of the profiles region, aligned on a page.
+     * @param[in] Size Size in bytes of the profiles region, multiple of PAGE_SIZE.
+     * @param[in] DirectoryAddress Address of the directory journal, aligned on a page.
+     * @param[in] DirectorySize Size in bytes of the directory journal, multiple of 2 pages.
+     */
+    EEPROM_ALLOCATOR(EEPROM_QUEUE* const Queue,
+                     const int Address,
+                     const int Size,
+                     const int DirectoryAddress,
+                     const int DirectorySize);
+
+    /**
+     * @brief Destroy the allocator. Pending writes remain on the queue.
+     *
+     */
+    ~EEPROM_ALLOCATOR();
+
+    /**
+     * @brief Read the directory from it's journal. A move in progress is resumed by the next Step().
+     *
+     * @return  0 : OK
+     * @return -1 : No valid directory, the allocator shall be formatted.
+     * @return -2 : Read error.
+     */
+    int Mount();
+
+    /**
+     * @brief Write a new directory.
+     *
+     * @param[in] Directory The directory. Extents shall be page aligned, within the region and not overlap.
+     * @param[out] Done If not null, a future set once the directory has been programmed.
+     *
+     * @return  0 : OK
+     */
+    int Format(const PROFILE_DIRECTORY* const Directory, std::shared_future<int>* const Done = nullptr);
+
+    /**
+     * @brief Check if a profile of Len bytes can be stored, compaction included.
+     *
+     * @param[in] Len Size in bytes of the profile.
+     * @param[out] ID The entry that would be used.
+     *
+     * @return  0 : OK
+     * @return -1 : No free entry.
+     * @return -2 : Not enough space.
+     * @return -3 : Not mounted.
+     */
+    int Check(const int Len, int* const ID) const;
+
+    /**
+     * @brief Store a profile on the smallest free extent. If none fit, the region is compacted first. The entry is
+     *        programmed after the data.
+     *
+     * @param[in] Data The profile.
+     * @param[in] Len Size in bytes of the profile.
+     * @param[out] ID The entry given to the profile.
+     * @param[out] Done If not null, a future set once the entry has been programmed.
+     *
+     * @return  0 : OK
+     * @return -1 : No free entry.
+     * @return -2 : Not enough space.
+     * @return -3 : Not mounted.
+     * @return -4 : IOCTL error while compacting.
+     */
+    int Store(const uint8_t* const Data,
+              const int Len,
+              int* const ID,
+              std::shared_future<int>* const Done = nullptr);
+
+    /**
+     * @brief Free the extent of a profile. It is only reused once the entry has been programmed, and never if that
+     *        failed, until the next Mount().
+     *
+     * @param[in] ID The entry of the profile.
+     * @param[out] Done If not null, a future set once the entry has been programmed.
+     *
+     * @return  0 : OK
+     * @return -1 : Invalid or free entry.
+     */
+    int Remove(const int ID, std::shared_future<int>* const Done = nullptr);
+
+    /**
+     * @brief Return the extent of a profile.
+     *
+     * @param[in] ID The entry of the profile.
+     * @param[out] Info The extent. The address is the one before the move, if the profile is being moved.
+     *
+     * @return  0 : OK
+     * @return -1 : Invalid or free entry.
+     */
+    int Find(const int ID, DSP_PROFILE_INFO* const Info) const;
+
+    /**
+     * @brief Read a part of a profile, even while it is being moved.
+     *
+     * @param[in] ID The entry of the profile.
+     * @param[in] Offset Offset in bytes of the first byte to read, from the start of the profile.
+     * @param[out] Data A pointer to a list of Len elements to store the output.
+     * @param[in] Len The number of bytes to read, up to the end of the profile.
+     *
+     * @return  0 : OK
+     * @return -1 : Invalid or free entry, or out of the profile.
+     * @return -2 : IOCTL error.
+     */
+    int Read(const int ID, const int Offset, uint8_t* const Data, const int Len);
+
+    /**
+     * @brief Run a single compaction step : copy at most PROFILE_MOVE_CHUNK pages, and wait for them and the
+     *        journaled progress to be programmed. Meant to be called when the speaker is idle.
+     *
+     * @return  1 : OK, the region is not yet compact.
+     * @return  0 : OK, the region is compact.
+     * @return -1 : IOCTL error.
+     * @return -3 : Not mounted.
+     */
+    int Step();
+
+    /**
+     * @brief Return the free space in bytes, once compacted.
+     */
+    int GetFreeSpace() const;
+
+    /**
+     * @brief Return the statistics of the allocator.
+     */
+    ALLOCATOR_STATISTICS GetStatistics() const;
+};
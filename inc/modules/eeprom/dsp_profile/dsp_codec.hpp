@@ -0,0 +1,186 @@
+/**
+ * @file dsp_codec.hpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define the compressed EEPROM image of a DSP profile, and it's streaming decoder.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @remark An image is a DSP_PROFILE_IMAGE header, the name, then the buffer A, buffer B and instructions sections.
+ *         Each section is coded on elements (3 bytes coefficients, 4 bytes instructions), with tokens that never
+ *         cross a section :
+ *              0nnnnnnn            : n + 1 literal elements follow.
+ *              10nnnnnn nnnnnnnn   : n + 1 null elements.
+ *              11nnnnnn            : n + 1 copies of the previous element.
+ *
+ */
+
+#pragma once
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+#include "modules/eeprom/dsp_profile/dsp_profile.hpp"
+
+// STD
+#include <cstdint>
+
+// ==============================================================================
+// CONSTANTS
+// ==============================================================================
+constexpr uint8_t DSP_IMAGE_MAGIC[2] = {0xD5, 0x9A}; /*!< Not printable : a legacy raw image start with the name*/
+constexpr int DSP_IMAGE_VERSION = 1; /*!< Version of the coding*/
+constexpr int DSP_IMAGE_SECTIONS = 3; /*!< Buffer A, buffer B and instructions*/
+constexpr int DSP_STREAM_ELEMENTS = 30; /*!< Elements forwarded at once to a sink, a CRAM page of the DAC*/
+
+// ==============================================================================
+// DATA STRUCTURES
+// ==============================================================================
+
+/*! Define the header of a compressed image. Counts are expressed in elements.*/
+struct DSP_PROFILE_IMAGE
+{
+    uint8_t Magic[2]; /*!< DSP_IMAGE_MAGIC*/
+    uint8_t Version; /*!< DSP_IMAGE_VERSION*/
+    uint8_t __padding0 = 0x00; /*!< MEMORY PADDING. DO NOT TOUCH*/
+    uint16_t Count[DSP_IMAGE_SECTIONS]; /*!< Number of elements of each section*/
+};
+
+/**
+ * @brief Return the maximal size of an image, for a profile of RawSize bytes once serialized.
+ *
+ * @param[in] RawSize Size in bytes of the raw profile.
+ */
+constexpr int DSP_IMAGE_MAX(const int RawSize)
+{
+    // At worst, a literal token every 128 elements of 3 bytes.
+    return (int)sizeof(DSP_PROFILE_IMAGE) + RawSize + (RawSize / 384) + DSP_IMAGE_SECTIONS;
+}
+
+// ==============================================================================
+// FUNCTIONS
+// ==============================================================================
+
+/**
+ * @brief Code a section.
+ *
+ * @param[in] In The elements of the section.
+ * @param[in] Count The number of elements.
+ * @param[in] Width The size in bytes of an element.
+ * @param[out] Out The coded section, at most Count * Width + Count / 128 + 1 bytes.
+ *
+ * @return The number of bytes wrote on Out.
+ */
+int DSP_EncodeSection(const uint8_t* const In, const int Count, const int Width, uint8_t* const Out);
+
+// ==============================================================================
+// CLASS
+// ==============================================================================
+/**
+ * @brief Interface of a consumer of decoded profiles, used to forward them without storing the raw profile.
+ *
+ */
+class DSP_PROFILE_SINK
+{
+public:
+    virtual ~DSP_PROFILE_SINK() = default;
+
+    /**
+     * @brief Called once the header and the name of the image have been received.
+     *
+     * @param[in] Image The header of the image.
+     * @param[in] Name The name of the profile, MAX_PROFILE_CHAR characters.
+     *
+     * @return  0 : OK
+     * @return <0 : The image is too large for the sink.
+     */
+    virtual int Open(const DSP_PROFILE_IMAGE* const Image, const char* const Name) = 0;
+
+    /**
+     * @brief Forward decoded elements. Sections are forwarded in order, by blocks of DSP_STREAM_ELEMENTS elements
+     *        aligned from the start of the section.
+     *
+     * @param[in] Section The section : 0 for the buffer A, 1 for the buffer B and 2 for the instructions.
+     * @param[in] First Index of the first element, from the start of the section.
+     * @param[in] Elements The elements, as formatted on the profile.
+     * @param[in] Count The number of elements.
+     *
+     * @return  0 : OK
+     * @return <0 : Error, the decoding is stopped.
+     */
+    virtual int Write(const int Section, const int First, const uint8_t* const Elements, const int Count) = 0;
+};
+
+/**
+ * @brief Streaming decoder for the compressed images. The image may be fed by chunks of any size, and is decoded in
+ *        place on the buffers of the profile, or forwarded to a sink : no intermediate copy of the raw profile is
+ *        needed.
+ *
+ */
+class DSP_PROFILE_DECODER
+{
+private:
+    DSP_PROFILE* Profile;
+    DSP_PROFILE_SINK* Sink;
+
+    uint8_t Head[sizeof(DSP_PROFILE_IMAGE) + MAX_PROFILE_CHAR]; /*!< Header and name, as received*/
+    int HeadLen; /*!< Number of bytes received on Head*/
+
+    uint8_t* Out[DSP_IMAGE_SECTIONS]; /*!< Buffers of the sections*/
+    int Size[DSP_IMAGE_SECTIONS]; /*!< Size in bytes of the sections, as announced by the image*/
+    int Width[DSP_IMAGE_SECTIONS]; /*!< Size in bytes of an element*/
+    int Section; /*!< Section being decoded, DSP_IMAGE_SECTIONS once done*/
+    int Offset; /*!< Bytes already decoded on the section*/
+
+    uint8_t Stage[DSP_STREAM_ELEMENTS * 4]; /*!< Elements not yet forwarded to the sink*/
+    int Forwarded; /*!< Bytes of the section already forwarded to the sink*/
+    uint8_t Last[4]; /*!< Last forwarded element, for the copies*/
+
+    int Mode; /*!< Next expected byte : token, low byte of a null run or literal*/
+    int Count; /*!< Pending token count*/
+    int Literal; /*!< Literal bytes remaining*/
+
+    void Init();
+    int Start();
+    int Token(const uint8_t Byte);
+    int Run(const bool Null, const int Elements);
+    void Next();
+    uint8_t* Cursor();
+    const uint8_t* Previous() const;
+    int Room() const;
+    int Advance(const int Len);
+
+public:
+    /**
+     * @brief Construct a new decoder.
+     *
+     * @param[out] Profile The profile to be filled.
+     */
+    DSP_PROFILE_DECODER(DSP_PROFILE* const Profile);
+
+    /**
+     * @brief Construct a new decoder, that forward the decoded elements.
+     *
+     * @param[inout] Sink The consumer of the elements.
+     */
+    DSP_PROFILE_DECODER(DSP_PROFILE_SINK* const Sink);
+
+    /**
+     * @brief Decode the next bytes of the image.
+     *
+     * @param[in] Data The bytes.
+     * @param[in] Len The number of bytes.
+     *
+     * @return  0 : OK
+     * @return -1 : Invalid image.
+     * @return -2 : The image is too large for the profile.
+     * @return -3 : The sink failed.
+     */
+    int Feed(const uint8_t* const Data, const int Len);
+
+    /**
+     * @brief Return true once the whole image has been decoded.
+     */
+    bool Finished() const;
+};
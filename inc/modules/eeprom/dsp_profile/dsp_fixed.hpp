@@ -0,0 +1,51 @@
+/**
+ * @file dsp_fixed.hpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define the batch conversions between floats and the 4.20 fixed point words of the DSP coefficients.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @remark A coefficient is a 24 bits two's complement word with 20 fractionnal bits, stored on 3 bytes, MSB first.
+ *         On the target, blocks of 16 values are converted with NEON, the remaining ones, and every value on the
+ *         host, with the scalar code. Both of them round to the nearest step, ties to even, and give the same words.
+ *
+ */
+
+#pragma once
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+// STD
+#include <cstdint>
+
+// ==============================================================================
+// CONSTANTS
+// ==============================================================================
+constexpr int DSP_FIXED_WIDTH = 3; /*!< Size in bytes of a packed 4.20 word*/
+
+// ==============================================================================
+// FUNCTIONS
+// ==============================================================================
+/**
+ * @brief Convert floats to 4.20 fixed point words, and pack them. Values out of [-8, 8 - 2^(-20)] are saturated,
+ *        and NaN are wrote as 0.
+ *
+ * @param[in] In The values.
+ * @param[in] Count The number of values.
+ * @param[out] Out A pointer to Count * DSP_FIXED_WIDTH bytes, for the packed words.
+ *
+ * @return The number of saturated, or NaN, values. 0 if every value has been represented.
+ */
+int DSP_PackFixedPoint4dot20(const float* const In, const int Count, uint8_t* const Out);
+
+/**
+ * @brief Unpack 4.20 fixed point words, and convert them to floats. The conversion is exact.
+ *
+ * @param[in] In The packed words, DSP_FIXED_WIDTH bytes each.
+ * @param[in] Count The number of words.
+ * @param[out] Out A pointer to Count floats, for the values.
+ */
+void DSP_UnpackFixedPoint4dot20(const uint8_t* const In, const int Count, float* const Out);
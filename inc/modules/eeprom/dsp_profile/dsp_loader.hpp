@@ -0,0 +1,62 @@
+/**
+ * @file dsp_loader.hpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define a sink that forward decoded DSP profiles to the DAC.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @remark Elements are received by blocks of DSP_STREAM_ELEMENTS, which match the CRAM pages of the DAC : each
+ *         block is sent as a single transfer, while the next bytes of the image are read from the EEPROM.
+ *
+ */
+
+#pragma once
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+#include "drivers/devices/PCM5252.hpp"
+#include "modules/eeprom/dsp_profile/dsp_codec.hpp"
+
+// STD
+#include <cstdint>
+
+// ==============================================================================
+// CLASS
+// ==============================================================================
+/**
+ * @brief Sink that write the decoded coefficients and instructions to the DAC, as they come.
+ *
+ */
+class DSP_PROFILE_LOADER : public DSP_PROFILE_SINK
+{
+private:
+    PCM5252* Dac;
+    char Name[MAX_PROFILE_CHAR];
+    int Written; /*!< Number of elements sent to the DAC*/
+
+public:
+    /**
+     * @brief Construct a new loader.
+     *
+     * @param[inout] Dac The DAC to be loaded.
+     */
+    DSP_PROFILE_LOADER(PCM5252* const Dac);
+
+    int Open(const DSP_PROFILE_IMAGE* const Image, const char* const Name) override;
+    int Write(const int Section, const int First, const uint8_t* const Elements, const int Count) override;
+
+    /**
+     * @brief Return the name of the loaded profile.
+     *
+     * @param[out] Name The name, MAX_PROFILE_CHAR characters.
+     */
+    void GetName(char Name[MAX_PROFILE_CHAR]) const;
+
+    /**
+     * @brief Return the number of coefficients and instructions sent to the DAC.
+     */
+    int GetWritten() const;
+};
@@ -37,6 +37,20 @@ enum class DSP_PROFILE_SIZE
     SMALL = SMALL_PROFILE, /*!< Small profile. (2) = 1438 bytes.*/
 };
 
+// ==============================================================================
+// FUNCTIONS
+// ==============================================================================
+/**
+ * @brief Convert a float to the 4.20 fixed point format of the DSP coefficients, rounded to the nearest step.
+ *
+ * @param[in] In The value, within [-8, 8 - 2^(-20)].
+ * @param[out] Out The 24 bits two's complement word, on the 24 LSBits.
+ *
+ * @return  0 : OK
+ * @return -1 : The value cannot be represented.
+ */
+int ConvertFloatToFixedPoint4dot20(const float In, int* const Out);
+
 // ==============================================================================
 // CLASS
 // ==============================================================================
@@ -49,6 +63,8 @@ class DSP_PROFILE
     // Enabling to the EEPROM class to access to the buffers,
     // to make easier the copy of the data directly, without requiring setters and getters.
     friend class EEPROM;
+    friend class DSP_PROFILE_DECODER;
+    friend class DSP_EQ;
 
 private:
 protected:
@@ -88,6 +104,19 @@ protected:
      */
     int ReadBuffers(uint8_t* const buf, int* const Len);
 
+    /**
+     * @brief This function is only available to friends class, and is used to fill a buffer with the compressed
+     *        image of the profile, as stored on the EEPROM. Use DSP_PROFILE_DECODER to read it back.
+     *
+     * @param[out] buf The image.
+     * @param[inout] Len First, the len of the output buffer, at least DSP_IMAGE_MAX(size), and then the number of
+     *                   wrote bytes.
+     *
+     * @return  0 : OK
+     * @return -1 : Buf too small.
+     */
+    int Encode(uint8_t* const buf, int* const Len);
+
 public:
     // ==============================================================================
     // CONSTRUCTORS
@@ -124,27 +153,51 @@ public:
     /**
      * @brief Write the coefficients to buffer A
      *
-     * @param[in] buf Float values to be wrote in the buffer A. Must be within +-7 range.
+     * @param[in] buf Float values to be wrote in the buffer A. Must be within the 4.20 range, [-8, 8).
      * @param[in] bufLen Number of values to be wrote.
      *
      * @return  0 : OK
      * @return -1 : Incorrect buffer length (too big)
-     * @return -2 : Buffer contain at least an incorrect value that cannot be converted to binary format.
+     * @return -2 : Buffer contain at least an incorrect value that cannot be converted to binary format. It has been
+     *              wrote saturated.
      */
     int WriteBufferA(float* const buf, const int bufLen);
 
     /**
      * @brief Write the coefficients to buffer B
      *
-     * @param[in] buf Float values to be wrote in the buffer A. Must be within +-7 range.
+     * @param[in] buf Float values to be wrote in the buffer A. Must be within the 4.20 range, [-8, 8).
      * @param[in] bufLen Number of values to be wrote.
      *
      * @return  0 : OK
      * @return -1 : Incorrect buffer length (too big)
-     * @return -2 : Buffer contain at least an incorrect value that cannot be converted to binary format.
+     * @return -2 : Buffer contain at least an incorrect value that cannot be converted to binary format. It has been
+     *              wrote saturated.
      */
     int WriteBufferB(float* const buf, const int bufLen);
 
+    /**
+     * @brief Read back the coefficients of buffer A, as floats.
+     *
+     * @param[out] buf Float values of the buffer A.
+     * @param[in] bufLen Number of values to be read.
+     *
+     * @return  0 : OK
+     * @return -1 : Incorrect buffer length (too big)
+     */
+    int ReadBufferA(float* const buf, const int bufLen);
+
+    /**
+     * @brief Read back the coefficients of buffer B, as floats.
+     *
+     * @param[out] buf Float values of the buffer B.
+     * @param[in] bufLen Number of values to be read.
+     *
+     * @return  0 : OK
+     * @return -1 : Incorrect buffer length (too big)
+     */
+    int ReadBufferB(float* const buf, const int bufLen);
+
     /**
      * @brief Write the instructions
      *
@@ -0,0 +1,94 @@
+/**
+ * @file dsp_reader.hpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define the reader of the compressed DSP profiles stored by the allocator.
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @remark Images are decoded as they are read : either on the buffers of a profile, or streamed to a sink. When
+ *         streamed, a single reader thread fill the next chunk while the current one is decoded and forwarded.
+ *
+ */
+
+#pragma once
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+#include "modules/eeprom/allocator/allocator.hpp"
+#include "modules/eeprom/dsp_profile/dsp_codec.hpp"
+#include "modules/eeprom/dsp_profile/dsp_profile.hpp"
+
+// STD
+#include <cstdint>
+
+// ==============================================================================
+// CONSTANTS
+// ==============================================================================
+constexpr int DSP_READ_CHUNK = 256; /*!< Bytes of compressed image read at once when decoded on a profile*/
+constexpr int DSP_STREAM_CHUNK = 8 * PAGE_SIZE; /*!< Bytes of compressed image read at once when streamed*/
+
+// ==============================================================================
+// CLASS
+// ==============================================================================
+/**
+ * @brief Reader of the compressed profiles. Legacy raw profiles are left to the caller.
+ *
+ */
+class DSP_PROFILE_READER
+{
+private:
+    EEPROM_ALLOCATOR* Profiles;
+
+public:
+    /**
+     * @brief Construct a new reader.
+     *
+     * @param[inout] Profiles The mounted allocator of the profiles region.
+     */
+    DSP_PROFILE_READER(EEPROM_ALLOCATOR* const Profiles);
+
+    /**
+     * @brief Read the header of a compressed image.
+     *
+     * @param[in] ID The profile.
+     * @param[out] Image The header.
+     *
+     * @return true if the profile is a compressed image, false if it's a legacy raw one or can't be read.
+     */
+    bool ReadImage(const int ID, DSP_PROFILE_IMAGE* const Image);
+
+    /**
+     * @brief Decode a compressed image on the buffers of a profile, by chunks of DSP_READ_CHUNK bytes.
+     *
+     * @param[in] ID The profile.
+     * @param[out] Profile A DSP_PROFILE object filled with the right size.
+     *
+     * @return  0 : OK
+     * @return -1 : Invalid profile number value.
+     * @return -2 : Legacy raw profile.
+     * @return -3 : IOCTL error.
+     * @return -4 : Invalid image, too large for the profile or CRC error.
+     */
+    int Decode(const int ID, DSP_PROFILE* const Profile);
+
+    /**
+     * @brief Stream a compressed image to a sink, by chunks of DSP_STREAM_CHUNK bytes. The next chunk is read
+     *        while the current one is decoded and forwarded : the duration is bounded by the slowest of the EEPROM
+     *        and the sink.
+     * @warning The CRC is only checked at the end, once every element has been forwarded.
+     *
+     * @param[in] ID The profile.
+     * @param[inout] Sink The consumer of the decoded profile.
+     *
+     * @return  0 : OK
+     * @return -1 : Invalid profile number value.
+     * @return -2 : Legacy raw profile, that can't be streamed.
+     * @return -3 : IOCTL error.
+     * @return -4 : Invalid image, too large for the sink or CRC error.
+     * @return -5 : The sink failed.
+     */
+    int Stream(const int ID, DSP_PROFILE_SINK* const Sink);
+};
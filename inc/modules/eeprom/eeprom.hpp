@@ -20,20 +20,42 @@
 #include "drivers/peripherals/spi.hpp"
 
 // Other elements
+#include "allocator/allocator.hpp"
+#include "dsp_profile/dsp_codec.hpp"
+#include "dsp_profile/dsp_loader.hpp"
 #include "dsp_profile/dsp_profile.hpp"
+#include "dsp_profile/dsp_reader.hpp"
 #include "header/header.hpp"
+#include "header/slots.hpp"
+#include "journal/journal.hpp"
+#include "queue/queue.hpp"
+
+// STD
+#include <future>
 
 // ==============================================================================
 // HEADER CONSTANTS
 // ==============================================================================
-constexpr int HEADER_SIZE = 128; /*!< Define the size in bytes of the header.*/
 constexpr int HEADER_ADDRESS = 0x0000; /*!< Define the size of the header*/
 
 // ==============================================================================
 // CONFIG CONSTANTS
 // ==============================================================================
 constexpr int CONFIG_SIZE = 256; /*!< Define the base address of the config*/
-constexpr int CONFIG_ADDRESS = 0x0080; /*!< Define the size of the config*/
+constexpr int CONFIG_ADDRESS = 0x0080; /*!< Define the legacy location of the config, reused by the header slots*/
+
+// ==============================================================================
+// DSP PROFILE CONSTANTS
+// ==============================================================================
+constexpr int PROFILE_ADDRESS = 0x0180; /*!< Define the base address of the DSP profiles region*/
+constexpr int PROFILE_DIRECTORY_ADDRESS = 0x6800; /*!< Define the base address of the profiles directory, end of the profiles*/
+constexpr int PROFILE_DIRECTORY_SIZE = 0x0800; /*!< Define the size of the profiles directory journal (two banks)*/
+
+// ==============================================================================
+// JOURNAL CONSTANTS
+// ==============================================================================
+constexpr int JOURNAL_ADDRESS = 0x7000; /*!< Define the base address of the config journal*/
+constexpr int JOURNAL_SIZE = 0x1000; /*!< Define the size of the config journal (two banks)*/
 
 // ==============================================================================
 // EEPROM CONSTANTS
@@ -53,19 +75,25 @@ class EEPROM
 
 private:
     M95256 Slave;
+    EEPROM_QUEUE* Queue;
+    EEPROM_JOURNAL* Config;
+    EEPROM_ALLOCATOR* Profiles;
+    DSP_PROFILE_READER* Reader;
     EEPROM_HEADER_V1* Header;
+    EEPROM_HEADER_SLOTS* Slots;
     SPI_Bus* SPI;
-    int ReadHeaderV1();
-    int WriteHeaderV1();
     int SetConfigCRC(const uint16_t CRC);
     int GetConfigCRC(uint16_t* const CRC);
+    int ReadLegacyConfigV1(CONFIG_V1* const Data);
+    int ImportLegacyProfiles();
 
 public:
     // ==============================================================================
     // CONSTRUCTORS
     // ==============================================================================
     /**
-     * @brief Construct a new EEPROM
+     * @brief Construct a new EEPROM. The newest valid header slot is used, the other one is the target of the
+     *        next header write.
      *
      * @param[in] ForceWrite Ignore the read issues and force the write of a new header. Will be logged.
      *
@@ -95,75 +123,113 @@ public:
     int GetHeaderV1(EEPROM_HEADER_V1* const Header);
 
     /**
-     * @brief Write the config to the EEPROM. Date and CRC are also updated.
+     * @brief Block until every queued write has been programmed on the EEPROM.
+     *
+     * @return  0 : OK
+     */
+    int Flush();
+
+    /**
+     * @brief Load the whole EEPROM in RAM, with a single read. Otherwise, each page is loaded on first access.
+     *        Once loaded, reads never access the EEPROM.
+     *
+     * @return  0 : OK
+     * @return -1 : IOCTL error.
+     */
+    int Preload();
+
+    /**
+     * @brief Write the config to the EEPROM. Only the changed bytes are appended to the config journal, the
+     *        header is left untouched. Writes are queued : the call return without waiting for the EEPROM.
      *
      * @param[in] Data A reference to the Data structure to be wrote.
+     * @param[out] Done If not null, a future set once the write has been programmed, with an EEPROM_QUEUE::Write
+     *                  error code.
      *
      * @return  0 : OK.
      * @return -1 : Memory allocation failed.
      * @return -2 : Write failed.
      */
-    int WriteConfigV1(CONFIG_V1* const Data);
+    int WriteConfigV1(CONFIG_V1* const Data, std::shared_future<int>* const Done = nullptr);
 
     /**
-     * @brief Read the config from the EEPROM. CRC is computed. An Header read is highly recommended to get the date.
+     * @brief Read the config, as rebuilt from the config journal at boot. Does not access the EEPROM.
      *
      * @param[in] Data The data to be rode
      *
      * @return  0 : OK
-     * @return -1 : Memory allocation failed.
-     * @return -2 : Read failed.
-     * @return -3 : Invalid CRC.
+     * @return -3 : No valid config on the EEPROM.
      */
     int ReadConfigV1(CONFIG_V1* const Data);
 
     /**
-     * @brief Ask for the software to load the default configuration.
+     * @brief Ask for the software to load the default configuration. Queued as WriteConfigV1.
+     *
+     * @param[out] Done If not null, a future set once the write has been programmed.
      *
      * @return  0 : OK
      * @return -1 : Incorrect file size. Note : This error take it's root on the compilation steps. Cannot be easily debugged.
      * @return -2 : IOCTL error.
      */
-    int LoadDefaultConfigV1();
+    int LoadDefaultConfigV1(std::shared_future<int>* const Done = nullptr);
 
     // ==============================================================================
     // DSP PROFILE FUNCTIONS
     // ==============================================================================
 
     /**
-     * @brief Check if there is enough space of a DSP Profile of Len Size.
+     * @brief Check if there is enough space of a DSP Profile of Len Size. The free space is counted as if the
+     *        profiles region was compacted : AddDSPProfile compact it if needed.
      *
      * @param[in] Profile A DSP_PROFILE Struct.
      * @param[out] PossibleProfileID Return the ID of the possible profile ID.
      *
      * @return  0 : OK
-     * @return -1 : Not enough space.
+     * @return -1 : Not enough space, or PROFILE_MAX profiles are already stored.
      */
     int CheckForDSPProfileSpace(DSP_PROFILE* const Profile, int* const PossibleProfileID);
 
     /**
-     * @brief Write a new DSP Profile to the EEPROM, if there is enough space for it.
+     * @brief Write a new DSP Profile to the EEPROM, on the smallest free extent that fit it. If none fit, the
+     *        profiles region is compacted first. Queued as WriteConfigV1.
      *
      * @param[in] Profile A pointer to a DSP_PROFILE struct member.
      * @param[out] ProfileNumber The function return the number of the DSP Profile that has been given to this profile.
+     * @param[out] Done If not null, a future set once the profile and it's directory entry have been programmed.
      *
      * @return  0 : OK
      * @return -1 : Not enough space
      * @return -2 : Invalid pointer
-     * @return -3 : IOCTL error.
+     * @return -3 : IOCTL error while compacting.
+     * @return -4 : The profile can't be encoded.
      */
-    int AddDSPProfile(DSP_PROFILE* const Profile, int* const ProfileNumber);
+    int AddDSPProfile(DSP_PROFILE* const Profile,
+                      int* const ProfileNumber,
+                      std::shared_future<int>* const Done = nullptr);
 
     /**
-     * @brief Delete on the EEPROM (on the header only, the values remains until the next write)
+     * @brief Delete on the EEPROM (on the directory only, the space is reclaimed by the next writes or compactions)
      *
      * @param[in] ProfileNumber The number of the DSP Profile.
+     * @param[out] Done If not null, a future set once the directory has been programmed.
      *
      * @return  0 : OK
      * @return -1 : Invalid profile number value.
-     * @return -2 : IOCTL error.
      */
-    int RemoveDSPProfile(const int ProfileNumber);
+    int RemoveDSPProfile(const int ProfileNumber, std::shared_future<int>* const Done = nullptr);
+
+    /**
+     * @brief Run a few compaction steps on the profiles region, to merge the free space left by the removed
+     *        profiles. Each step copy up to PROFILE_MOVE_CHUNK pages and wait for them. Meant to be called when the
+     *        speaker is idle, a move interrupted by a power loss is resumed.
+     *
+     * @param[in] Steps Maximal number of steps.
+     *
+     * @return  1 : OK, the region is not yet compact.
+     * @return  0 : OK, the region is compact.
+     * @return -1 : IOCTL error.
+     */
+    int CompactDSPProfiles(const int Steps = 1);
 
     /**
      * @brief Return the name of a specific DSP Profile
@@ -180,7 +246,8 @@ public:
     int GetDSPProfileName(const int ProfileNumber, char ProfileName[MAX_PROFILE_CHAR]);
 
     /**
-     * @brief Read the DSP Profile in memory and return it.
+     * @brief Read the DSP Profile in memory and return it. Compressed images are decoded by chunks, as they are
+     *        read.
      *
      * @param[in] ProfileNumber An integer to select a profile number
      * @param[out] Profile A DSP_PROFILE object filled with the right size.
@@ -191,9 +258,27 @@ public:
      * @return -1 : Invalid profile number value.
      * @return -2 : Failed to allocate memory
      * @return -3 : IOCTL error.
+     * @return -4 : Invalid image, too large for the profile or CRC error.
      */
     int GetDSPProfile(const int ProfileNumber, DSP_PROFILE* const Profile);
 
+    /**
+     * @brief Stream a compressed DSP Profile to a sink, such as a DSP_PROFILE_LOADER, without storing it. See
+     *        DSP_PROFILE_READER::Stream().
+     * @warning The CRC is only checked at the end, once every element has been forwarded.
+     *
+     * @param[in] ProfileNumber An integer to select a profile number
+     * @param[inout] Sink The consumer of the decoded profile.
+     *
+     * @return  0 : OK
+     * @return -1 : Invalid profile number value.
+     * @return -2 : Legacy raw profile, that can't be streamed. Use GetDSPProfile().
+     * @return -3 : IOCTL error.
+     * @return -4 : Invalid image, too large for the sink or CRC error.
+     * @return -5 : The sink failed.
+     */
+    int LoadDSPProfile(const int ProfileNumber, DSP_PROFILE_SINK* const Sink);
+
     /**
      * @brief Return the size of a DSP Profile
      *
@@ -82,15 +82,16 @@ struct EEPROM_HEADER_V1
     uint16_t HeaderCRC16 = 0x0000; /*!< CRC16 value for the header*/
     uint16_t ConfigCRC16 = 0x0000; /*!< CRC16 value for the config*/
 
-    uint8_t __padding3[8] = {0x00}; /*!< MEMORY PADDING. DO NOT TOUCH*/
+    uint16_t Sequence = 0x0000; /*!< Incremented on each write, 0 is skipped. The newest valid slot is used*/
+    uint8_t __padding3[6] = {0x00}; /*!< MEMORY PADDING. DO NOT TOUCH*/
 
-    uint8_t DSP_PROFILE_NUMBER; /*!< Used DSP Profiles. Each bit correspond to a DSP Profile*/
+    uint8_t DSP_PROFILE_NUMBER; /*!< Legacy used DSP Profiles, imported once on the profiles directory. Each bit correspond to a DSP Profile*/
 
     uint8_t __padding4[12] = {0x00}; /*!< MEMORY PADDING. DO NOT TOUCH*/
 
     // END OF PAGE 0
 
-    struct DSP_PROFILE_INFO Profile[8]; /*!< DSP Profile 0-15*/
+    struct DSP_PROFILE_INFO Profile[8]; /*!< Legacy DSP Profile 0-7, imported once on the profiles directory*/
 
     // END OF PAGE 1
 };
@@ -0,0 +1,86 @@
+/**
+ * @file slots.hpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define the storage of the header on two slots, written alternately.
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @remark Each write program the slot that does not hold the newest header, with the next sequence number : a
+ *         write torn by a power loss leave the previous header on the other slot. On read, the valid slot with the
+ *         newest sequence is used, sequences being compared with wrapping.
+ *
+ */
+
+#pragma once
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+#include "modules/eeprom/header/header.hpp"
+#include "modules/eeprom/queue/queue.hpp"
+
+// STD
+#include <cstdint>
+#include <future>
+
+// ==============================================================================
+// CONSTANTS
+// ==============================================================================
+constexpr int HEADER_SIZE = 128; /*!< Define the size in bytes of the header.*/
+constexpr int HEADER_SLOTS = 2; /*!< Define the number of header copies, stored one after the other*/
+
+// ==============================================================================
+// CLASS
+// ==============================================================================
+/**
+ * @brief Header slots, accessed through the write-behind queue.
+ *
+ */
+class EEPROM_HEADER_SLOTS
+{
+private:
+    EEPROM_QUEUE* Queue;
+    int Address; /*!< Address of the first slot*/
+    int Slot; /*!< Slot holding the newest header*/
+    std::shared_future<int> Done; /*!< Result of the last write*/
+
+public:
+    /**
+     * @brief Construct new slots. Without a valid header, the first slot is written first.
+     *
+     * @param[inout] Queue The queue used to access the EEPROM.
+     * @param[in] Address Address of the first slot.
+     */
+    EEPROM_HEADER_SLOTS(EEPROM_QUEUE* const Queue, const int Address);
+
+    /**
+     * @brief Read the newest valid header. CRC is checked on each slot.
+     *
+     * @param[out] Header The header.
+     *
+     * @return  0 : OK
+     * @return -1 : Memory allocation failed.
+     * @return -2 : IOCTL error.
+     * @return -3 : No valid slot.
+     */
+    int Read(EEPROM_HEADER_V1* const Header);
+
+    /**
+     * @brief Write a header on the other slot, with the next sequence number and it's CRC. If the last write is
+     *        still pending or failed, it's slot is written again : a single slot is ever in flight.
+     *
+     * @param[inout] Header The header. Sequence and HeaderCRC16 are updated.
+     * @param[out] Done If not null, a future set once the header has been programmed.
+     *
+     * @return  0 : OK
+     * @return -1 : Memory allocation failed.
+     */
+    int Write(EEPROM_HEADER_V1* const Header, std::shared_future<int>* const Done = nullptr);
+
+    /**
+     * @brief Return the slot holding the newest header, or being written.
+     */
+    int GetSlot() const;
+};
@@ -0,0 +1,167 @@
+/**
+ * @file journal.hpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define a wear-leveled, log structured storage for a small and frequently changed state.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @remark The region is split in two banks. A bank start with a header page, followed by a snapshot of the whole
+ *         state, then by the delta records appended on each change. Once a bank is full, a snapshot of the state
+ *         is wrote on the other one, whose header is programmed last with the next generation.
+ *         Record : Len (1 byte), Offset (1 byte), Data (Len bytes), CRC16 (2 bytes, over the generation, the
+ *         sequence number of the change and the record). A record never cross a page, a null Len is a padding up
+ *         to the next page. The last record of a change has JOURNAL_RECORD_LAST set on it's Len : the records of a
+ *         change are only replayed once it is found, and the changes of a bank are numbered from 0, the snapshot.
+ *         Once a write of the bank is known to have failed, the records appended after it can't be replayed : the
+ *         next change write a snapshot instead, on the other bank, or on the same one if it's header was lost.
+ *
+ */
+
+#pragma once
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+#include "modules/eeprom/queue/queue.hpp"
+
+// STD
+#include <cstdint>
+#include <future>
+#include <vector>
+
+// ==============================================================================
+// CONSTANTS
+// ==============================================================================
+constexpr int JOURNAL_RECORD_OVERHEAD = 4; /*!< Len, Offset and CRC16 bytes of a record*/
+constexpr int JOURNAL_RECORD_MAX = PAGE_SIZE - JOURNAL_RECORD_OVERHEAD; /*!< Maximal data bytes per record*/
+constexpr uint8_t JOURNAL_RECORD_LAST = 0x80; /*!< Flag of the Len byte, set on the last record of a change*/
+
+// ==============================================================================
+// DATA STRUCTURES
+// ==============================================================================
+
+/*! Define the header of a bank, on it's first page. Programmed once the snapshot is on the EEPROM.*/
+struct JOURNAL_BANK
+{
+    uint8_t Magic[2]; /*!< 'J', 'L'*/
+    uint16_t Generation; /*!< Incremented on each compaction. The newest valid bank is used*/
+    uint16_t StateSize; /*!< Size in bytes of the state*/
+    uint16_t CRC; /*!< CRC16 of the previous fields*/
+};
+
+/*! Define the statistics of the journal*/
+struct JOURNAL_STATISTICS
+{
+    unsigned long Records; /*!< Number of appended records*/
+    unsigned long Bytes; /*!< Number of appended bytes, paddings included*/
+    unsigned long Compactions; /*!< Number of snapshots wrote*/
+};
+
+// ==============================================================================
+// CLASS
+// ==============================================================================
+/**
+ * @brief Log structured storage for a state of up to 256 bytes. Each change cost the size of the changed bytes
+ *        plus 4, instead of the whole state, and is spread over the whole region.
+ *
+ */
+class EEPROM_JOURNAL
+{
+private:
+    EEPROM_QUEUE* Queue;
+    int Address; /*!< Address of the first bank*/
+    int BankSize; /*!< Size in bytes of a bank, multiple of PAGE_SIZE*/
+    int StateSize; /*!< Size in bytes of the state*/
+    bool Ordered; /*!< Records are queued as header pages*/
+
+    uint8_t* State; /*!< Current state, as rebuilt by the replay*/
+    bool Mounted; /*!< A valid bank has been found, or formatted*/
+    int Bank; /*!< Bank in use, 0 or 1*/
+    uint16_t Generation; /*!< Generation of the bank in use*/
+    int Tail; /*!< Address where the next record shall be appended*/
+    uint16_t Sequence; /*!< Sequence number of the next change on the bank*/
+    std::vector<std::shared_future<int>> Writes; /*!< Writes of the bank not yet known to be programmed*/
+    std::shared_future<int> Header; /*!< Write of the header of the bank, if not read from the EEPROM*/
+
+    JOURNAL_STATISTICS Statistics;
+
+    uint16_t RecordCRC(const uint16_t Generation, const uint16_t Sequence, const uint8_t* const Record) const;
+    int ReadBank(const int Bank, uint8_t* const Buffer, uint16_t* const Generation);
+    int Replay(const uint8_t* const Buffer, const uint16_t Generation);
+    int Append(uint8_t* const Buffer, int* const Position, const int Offset, const int Len, const bool Last);
+    bool Lost();
+    int Compact(std::shared_future<int>* const Done, const bool Switch);
+
+public:
+    /**
+     * @brief Construct a new journal. Nothing is read until Mount().
+     *
+     * @param[inout] Queue The queue used to access the EEPROM.
+     * @param[in] Address Address of the region, aligned on a page.
+     * @param[in] Size Size in bytes of the region, multiple of 2 pages.
+     * @param[in] StateSize Size in bytes of the state, up to 256 bytes.
+     * @param[in] Ordered Queue the records as header pages : they are programmed after the data queued before them,
+     *                    and dropped if it failed.
+     */
+    EEPROM_JOURNAL(EEPROM_QUEUE* const Queue,
+                   const int Address,
+                   const int Size,
+                   const int StateSize,
+                   const bool Ordered = false);
+
+    /**
+     * @brief Destroy the journal. Pending records remain on the queue.
+     *
+     */
+    ~EEPROM_JOURNAL();
+
+    /**
+     * @brief Find the newest valid bank, and rebuild the state by replaying it's records.
+     *
+     * @return  0 : OK
+     * @return -1 : No valid bank, the journal shall be formatted.
+     * @return -2 : Read error, or memory allocation failed.
+     */
+    int Mount();
+
+    /**
+     * @brief Write a snapshot of the state on the other bank, and use it from now. Used for the first write.
+     *
+     * @param[in] State The state, StateSize bytes.
+     * @param[out] Done If not null, a future set once the bank header has been programmed.
+     *
+     * @return  0 : OK
+     */
+    int Format(const uint8_t* const State, std::shared_future<int>* const Done = nullptr);
+
+    /**
+     * @brief Return the current state.
+     *
+     * @param[out] State The state, StateSize bytes.
+     *
+     * @return  0 : OK
+     * @return -1 : Not mounted.
+     */
+    int Get(uint8_t* const State) const;
+
+    /**
+     * @brief Store a new state. Only the changed bytes are appended, or a snapshot is wrote if the bank is full or
+     *        a previous write failed. The change is atomic : after a power loss, it is either replayed as a whole,
+     *        or not at all.
+     *
+     * @param[in] State The state, StateSize bytes.
+     * @param[out] Done If not null, a future set once the change has been programmed.
+     *
+     * @return  0 : OK
+     * @return -1 : Not mounted.
+     * @return -2 : Memory allocation failed.
+     */
+    int Set(const uint8_t* const State, std::shared_future<int>* const Done = nullptr);
+
+    /**
+     * @brief Return the statistics of the journal.
+     */
+    JOURNAL_STATISTICS GetStatistics() const;
+};
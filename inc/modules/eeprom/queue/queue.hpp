@@ -0,0 +1,173 @@
+/**
+ * @file queue.hpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define a write-behind queue and an in-RAM mirror for the EEPROM, served by a worker thread.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @remark Writes are split per page and merged with the pending writes of the same page, then programmed by the
+ *         worker. Header pages are only programmed once no data page is pending, and are dropped if a data page
+ *         failed since the last header commit : the header always describe data that is on the EEPROM.
+ *         Reads are served from a mirror of the whole array, where each page is loaded from the device on first
+ *         access. Writes that do not change a loaded page are not queued.
+ *
+ */
+
+#pragma once
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+// Drivers
+#include "drivers/devices/M95256.hpp"
+
+// STD
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ==============================================================================
+// CONSTANTS
+// ==============================================================================
+constexpr int EEPROM_QUEUE_SIZE = 0x8000; /*!< Size in bytes of the mirrored array*/
+constexpr int EEPROM_QUEUE_PAGES = EEPROM_QUEUE_SIZE / PAGE_SIZE; /*!< Number of pages of the mirrored array*/
+
+// ==============================================================================
+// DATA STRUCTURES
+// ==============================================================================
+
+/*! Define a write request, that may span several pages. Completed once all of them have been programmed.*/
+struct EEPROM_WRITE
+{
+    std::promise<int> Done; /*!< Set with Result on completion*/
+    int Remaining; /*!< Number of pages not yet programmed*/
+    int Result; /*!< First error met, 0 otherwise*/
+};
+
+/*! Define a page waiting to be programmed. Writes are merged on it until the worker pick it.*/
+struct EEPROM_PAGE
+{
+    uint8_t Data[PAGE_SIZE]; /*!< Content of the page, valid where Mask is set*/
+    uint64_t Mask = 0; /*!< Bit N set if the byte N has to be programmed*/
+    bool Header = false; /*!< Page of the header, programmed after the data pages*/
+    std::vector<std::shared_ptr<EEPROM_WRITE>> Waiters; /*!< Requests that wrote on this page*/
+};
+
+/*! Define the statistics of the queue*/
+struct EEPROM_QUEUE_STATISTICS
+{
+    unsigned long Requests; /*!< Number of queued write requests*/
+    unsigned long Pages; /*!< Number of programmed pages*/
+    unsigned long Coalesced; /*!< Number of page writes merged on an already pending page*/
+    unsigned long Dropped; /*!< Number of header pages dropped after a data failure*/
+    unsigned long Unchanged; /*!< Number of page writes ignored, since the content was already there*/
+    unsigned long Loads; /*!< Number of reads done on the device to fill the mirror*/
+};
+
+// ==============================================================================
+// CLASS
+// ==============================================================================
+/**
+ * @brief Write-behind queue for an M95256. Once created, all of the accesses to the device shall be done through it.
+ *
+ */
+class EEPROM_QUEUE
+{
+private:
+    M95256* Slave;
+    std::mutex Device; /*!< Serialize the accesses to the device*/
+    std::mutex Lock; /*!< Protect the pages and the statistics*/
+    std::condition_variable Wake; /*!< Signaled on new pages, and on stop*/
+    std::condition_variable Idle; /*!< Signaled once every page has been programmed*/
+
+    std::map<int, EEPROM_PAGE> Pages; /*!< Pending pages, by page number*/
+    EEPROM_PAGE Current; /*!< Page being programmed*/
+    int CurrentPage; /*!< Number of the page being programmed, -1 if none*/
+    int DataError; /*!< Error of a data page since the last header commit*/
+    bool Running;
+
+    uint8_t* Mirror; /*!< Content of the array, pending writes included. Valid on the loaded pages*/
+    uint64_t Loaded[EEPROM_QUEUE_PAGES / 64]; /*!< Bit set for each page loaded on the mirror*/
+
+    EEPROM_QUEUE_STATISTICS Statistics;
+    std::thread Worker;
+
+    void Work();
+    int Program(const int Number, EEPROM_PAGE* const Page);
+    bool IsLoaded(const int Number) const;
+    int Load(const int First, const int Last);
+
+public:
+    /**
+     * @brief Construct a new queue, and start it's worker.
+     *
+     * @param[inout] Slave The device. Must remain valid until the queue is destroyed.
+     */
+    EEPROM_QUEUE(M95256* const Slave);
+
+    /**
+     * @brief Program all of the pending pages, then stop the worker.
+     *
+     */
+    ~EEPROM_QUEUE();
+
+    /**
+     * @brief Queue a write. The data is copied, and the call never wait for the device.
+     *
+     * @param[in] Address Address of the first byte to be wrote.
+     * @param[in] Data The bytes to be wrote.
+     * @param[in] Len The number of bytes to write.
+     * @param[in] Header The bytes belong to the header, and shall be programmed after the data.
+     *
+     * @return A future, set once every page has been programmed :
+     * @return  0 : OK
+     * @return -1 : Invalid address or length.
+     * @return -2 : IOCTL error.
+     * @return -3 : Header dropped, since a data write failed.
+     */
+    std::shared_future<int> Write(const int Address,
+                                  const uint8_t* const Data,
+                                  const int Len,
+                                  const bool Header = false);
+
+    /**
+     * @brief Read data of the EEPROM, including the pending writes. Only the pages that are not yet on the mirror
+     *        are read from the device, as a single sequential read.
+     *
+     * @param[in] Address Address of the first byte to be read.
+     * @param[out] Data A pointer to a list of Len elements to store the output.
+     * @param[in] Len The number of bytes to read.
+     *
+     * @return  0 : OK
+     * @return <0 : M95256::Read error code.
+     */
+    int Read(const int Address, uint8_t* const Data, const int Len);
+
+    /**
+     * @brief Load the whole array on the mirror, with a single sequential read. Following reads never access the
+     *        device.
+     *
+     * @return  0 : OK
+     * @return <0 : M95256::Read error code.
+     */
+    int Preload();
+
+    /**
+     * @brief Block until every pending page has been programmed.
+     *
+     * @return  0 : OK
+     */
+    int Flush();
+
+    /**
+     * @brief Return the statistics of the queue.
+     */
+    EEPROM_QUEUE_STATISTICS GetStatistics();
+};
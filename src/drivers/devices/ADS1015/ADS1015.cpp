@@ -63,6 +63,7 @@ ADS1015::ADS1015(const I2C_Bus* I2C, const VOLTAGE_MONITOR address)
 {
     this->address = (uint8_t)address;
     this->I2C = *I2C;
+    this->I2C.Priority = I2C_PRIORITY::BACKGROUND; // Telemetry, served once everything else is done.
 
     this->LowThreshold = 0.0;
     this->ActualGain = ADC_RANGE::FS2V00;
@@ -123,8 +124,9 @@ int ADS1015::Read_Voltage(const ADC_CHANNELS channel, float* const value)
     }
     usleep(microseconds);
 
-    res += I2C_Read(&this->I2C, this->address, CONVERSION_REGISTER, &buf, 1, 2);
-    buf = SWAP_BYTES(buf);
+    uint16_t word = 0;
+    res += I2C_ReadWords(&this->I2C, this->address, CONVERSION_REGISTER, &word, 1);
+    buf = word;
 
     if(res != 0)
         return -1;
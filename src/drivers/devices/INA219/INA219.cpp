@@ -38,6 +38,7 @@ INA219::INA219(const I2C_Bus* I2C, const CURRENT_MONITOR address)
 {
     this->address = (uint8_t)address;
     this->I2C = *I2C;
+    this->I2C.Priority = I2C_PRIORITY::BACKGROUND; // Telemetry, served once everything else is done.
 
     this->PGASetting = 0x01;
     return;
@@ -152,10 +153,8 @@ int INA219::Configure(const int Reset,
 
 int INA219::ReadShuntVoltage(float* const Value)
 {
-    int res = 0;
-    int buf = 0;
-
-    res += I2C_Read(&this->I2C, this->address, SHUNTVOLTAGE, &buf, 1, 2);
+    uint16_t buf = 0;
+    int res = I2C_ReadWords(&this->I2C, this->address, SHUNTVOLTAGE, &buf, 1);
 
     if(res != 0)
         return -1;
@@ -167,10 +166,8 @@ int INA219::ReadShuntVoltage(float* const Value)
 
 int INA219::ReadPower(float* const Value)
 {
-    int res = 0;
-    int buf = 0;
-
-    res += I2C_Read(&this->I2C, this->address, POWER, &buf, 1, 2);
+    uint16_t buf = 0;
+    int res = I2C_ReadWords(&this->I2C, this->address, POWER, &buf, 1);
 
     if(res != 0)
         return -1;
@@ -182,10 +179,8 @@ int INA219::ReadPower(float* const Value)
 
 int INA219::ReadCurrent(float* const Value)
 {
-    int res = 0;
-    int buf = 0;
-
-    res += I2C_Read(&this->I2C, this->address, BUSCURRENT, &buf, 1, 2);
+    uint16_t buf = 0;
+    int res = I2C_ReadWords(&this->I2C, this->address, BUSCURRENT, &buf, 1);
 
     if(res != 0)
         return -1;
@@ -214,10 +209,8 @@ int INA219::SetCalibration(const float Value)
 
 int INA219::ReadBusVoltage(float* const Value)
 {
-    int res = 0;
-    int buf = 0;
-
-    res += I2C_Read(&this->I2C, this->address, BUSVOLTAGE, &buf, 1, 2);
+    uint16_t buf = 0;
+    int res = I2C_ReadWords(&this->I2C, this->address, BUSVOLTAGE, &buf, 1);
 
     if(res != 0)
         return -1;
@@ -226,3 +219,23 @@ int INA219::ReadBusVoltage(float* const Value)
 
     return 0;
 }
+
+int INA219::ReadAll(float* const ShuntVoltage,
+                    float* const BusVoltage,
+                    float* const Power,
+                    float* const Current)
+{
+    // SHUNTVOLTAGE, BUSVOLTAGE, POWER and BUSCURRENT are contiguous : a single transaction.
+    uint16_t buf[4] = {0};
+    int res = I2C_ReadWords(&this->I2C, this->address, SHUNTVOLTAGE, buf, 4);
+
+    if(res != 0)
+        return -1;
+
+    *ShuntVoltage = this->ConvertIntToFloat(buf[0]);
+    *BusVoltage = this->ConvertIntToFloat(buf[1]);
+    *Power = this->ConvertIntToFloat(buf[2]);
+    *Current = this->ConvertIntToFloat(buf[3]);
+
+    return 0;
+}
@@ -18,10 +18,11 @@
 #include "drivers/peripherals/spi.hpp"
 
 // STD
-#include <cerrno>
-#include <cstdlib>
-#include <cstring>
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <span>
+#include <stdexcept>
 #include <unistd.h>
 
 // ==============================================================================
@@ -36,6 +37,12 @@ constexpr int WRITE = 0x02; // 2 bytes address page
 
 constexpr int MAX_ADDRESS = 0x7FFF;
 
+constexpr int HEADER_SIZE = 3; // Opcode and 2 bytes address
+
+constexpr int POLL_FIRST = 100; // us, first delay between two RDSR
+constexpr int POLL_MAX = 1000; // us, the delay is doubled up to this value
+constexpr int WRITE_TIMEOUT = 10000; // us, twice the datasheet maximal write time
+
 // ==============================================================================
 // FUNCTIONS
 // ==============================================================================
@@ -44,6 +51,9 @@ M95256::M95256(const SPI_Bus* SPI)
 {
     this->SPI = *SPI;
     this->Openned = 0x00;
+    this->WritePending = false;
+    this->Estimate = 0;
+    this->ResetStatistics();
     return;
 }
 
@@ -57,6 +67,9 @@ M95256::M95256()
 
     // copy the SPI Device
     this->SPI = *ptr;
+    this->WritePending = false;
+    this->Estimate = 0;
+    this->ResetStatistics();
 
     // Load default settings of the SPI Bus.
     SPI_Configure(&this->SPI, SPI_MODE_0, SPI_DEFAULT_WORDSIZE, SPI_DEFAULT_SPEED);
@@ -66,33 +79,136 @@ M95256::M95256()
 
 M95256::~M95256()
 {
+    // Do not leave the last write cycle unchecked.
+    this->WaitWrite();
     return;
 }
 
-int M95256::WriteEnable()
+int M95256::PollStatus(uint8_t* const Status)
+{
+    uint8_t buf[2] = {RDSR, 0x00};
+
+    if(SPI_Transfer(&this->SPI, buf, buf) != 0)
+        return -1;
+
+    *Status = buf[1];
+    return 0;
+}
+
+void M95256::StartWrite()
+{
+    this->WritePending = true;
+    this->WriteStart = std::chrono::steady_clock::now();
+}
+
+int M95256::WaitWrite()
+{
+    // The cycle stay pending until the device is actually found ready.
+    if(!this->WritePending)
+        return 0;
+
+    // Sleep through the estimated cycle, the device can't be ready before.
+    auto Elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                       std::chrono::steady_clock::now() - this->WriteStart)
+                       .count();
+    const bool Slept = Elapsed < this->Estimate;
+    if(Slept)
+        usleep((useconds_t)(this->Estimate - Elapsed));
+
+    int Delay = POLL_FIRST;
+    int Polls = 0;
+    long Busy = 0;
+    uint8_t Status = 0;
+
+    while(1)
+    {
+        if(this->PollStatus(&Status) != 0)
+            return -1;
+
+        Elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::steady_clock::now() - this->WriteStart)
+                      .count();
+
+        if((Status & 0x01) == 0)
+        {
+            this->WritePending = false;
+            break;
+        }
+
+        if(Elapsed > WRITE_TIMEOUT)
+        {
+            this->Statistics.Timeouts++;
+            std::cerr << "[ M95256 ][ WaitWrite ] : Write cycle did not complete after "
+                      << Elapsed << " us" << std::endl;
+            return -2;
+        }
+
+        Busy = Elapsed;
+        Polls++;
+        usleep(Delay);
+        Delay = std::min(2 * Delay, POLL_MAX);
+    }
+
+    this->Statistics.Polls += Polls + 1;
+
+    // Already done on the first poll : the duration of the cycle is unknown.
+    if(Polls == 0)
+    {
+        // Hidden by the caller.
+        if(!Slept)
+        {
+            this->Statistics.Overlapped++;
+            return 0;
+        }
+
+        // Or we may have slept too long : shrink the estimate, until the device is found busy again.
+        this->Statistics.Estimated++;
+        this->Estimate -= this->Estimate / 4;
+        return 0;
+    }
+
+    this->Statistics.Cycles++;
+    this->Statistics.TotalCycle += Elapsed;
+    this->Statistics.MinCycle = std::min(this->Statistics.MinCycle, (long)Elapsed);
+    this->Statistics.MaxCycle = std::max(this->Statistics.MaxCycle, (long)Elapsed);
+
+    // The device was still busy on the last poll : the cycle is at least that long.
+    this->Estimate = Busy;
+    return 0;
+}
+
+M95256_STATISTICS M95256::GetStatistics() const
+{
+    return this->Statistics;
+}
+
+void M95256::ResetStatistics()
 {
-    int buf[3] = {0};
-    int res = 0;
+    this->Statistics = M95256_STATISTICS{};
+    this->Statistics.MinCycle = WRITE_TIMEOUT;
+}
 
-    buf[0] = WREN;
+int M95256::WriteEnable()
+{
+    const uint8_t buf[1] = {WREN};
 
-    res = SPI_Transfer(&this->SPI, buf, buf, 1);
+    // Ignored by the device while a write cycle is running.
+    if(this->WaitWrite() != 0)
+        return -1;
 
-    if(res != 0)
+    if(SPI_Transfer(&this->SPI, buf, {}) != 0)
         return -1;
     return 0;
 }
 
 int M95256::WriteDisable()
 {
-    int buf[3] = {0};
-    int res = 0;
-
-    buf[0] = WRDI;
+    const uint8_t buf[1] = {WRDI};
 
-    res = SPI_Transfer(&this->SPI, buf, buf, 1);
+    if(this->WaitWrite() != 0)
+        return -1;
 
-    if(res != 0)
+    if(SPI_Transfer(&this->SPI, buf, {}) != 0)
         return -1;
     return 0;
 }
@@ -102,42 +218,39 @@ int M95256::ReadStatus(int* const WriteProtectStatus,
                        int* const WriteEnable,
                        int* const WriteInProgress)
 {
-    int buf[4] = {0};
-    int res = 0;
-
-    buf[0] = RDSR;
-
-    res = SPI_Transfer(&this->SPI, &buf[0], &buf[2], 2);
+    uint8_t Status = 0;
 
-    if(res != 0)
+    if(this->PollStatus(&Status) != 0)
         return -1;
 
-    *WriteProtectStatus = (buf[3] & 0x80) >> 7;
-    *ProtectedBlock = EEPROM_WP{(buf[3] & 0x0C) >> 2};
-    *WriteEnable = (buf[3] & 0x02) >> 1;
-    *WriteInProgress = buf[3] & 0x01;
+    *WriteProtectStatus = (Status & 0x80) >> 7;
+    *ProtectedBlock = EEPROM_WP{(Status & 0x0C) >> 2};
+    *WriteEnable = (Status & 0x02) >> 1;
+    *WriteInProgress = Status & 0x01;
 
     return 0;
 }
 
 int M95256::WriteStatus(const int WriteProtectStatus, const EEPROM_WP ProtectedBlock)
 {
-    int buf[2] = {0};
-    int res = 0;
+    const uint8_t wren[1] = {WREN};
+    const uint8_t buf[2] = {
+        WRSR, (uint8_t)((((bool)WriteProtectStatus << 5) | (int)ProtectedBlock) << 2)};
 
-    this->WriteEnable();
-
-    buf[0] = WRSR;
-    buf[1] = (bool)WriteProtectStatus;
-    buf[1] = buf[1] << 5 | (int)ProtectedBlock;
-    buf[1] = buf[1] << 2;
+    if(this->WaitWrite() != 0)
+        return -1;
 
-    res = SPI_Transfer(&this->SPI, buf, buf, 2);
+    // WREN is latched on the CS rising edge, then the status is written on the same ioctl.
+    SPI_Transaction Transaction;
+    SPI_TransactionInit(&Transaction);
+    SPI_TransactionAppend(&Transaction, wren, {}, true);
+    SPI_TransactionAppend(&Transaction, buf, {});
 
-    if(res != 0)
+    if(SPI_TransactionSubmit(&this->SPI, &Transaction) != 0)
         return -1;
 
-    usleep(7000); // 7 ms of delay, to ensure correct write.
+    // The cycle is awaited by the next operation.
+    this->StartWrite();
 
     return 0;
 }
@@ -146,35 +259,35 @@ int M95256::Read(const int Address, uint8_t* const Data, const int Len)
 {
     if((0 > Address) | (Address > MAX_ADDRESS))
         return -1;
-    if((Address + Len) > MAX_ADDRESS)
+    if((Len < 0) | ((Address + Len) > MAX_ADDRESS + 1))
         return -2;
 
-    int res = 0;
-    uint8_t* buf = (uint8_t*)malloc(Len + 3);
-    if(buf == 0)
-    {
-        std::cerr << "[ M95256 ][ Read ] Could not allocate memory for read operation "
-                  << strerror(errno) << std::endl;
-        return -1;
-    }
-
-    memset(buf, 0x00, Len + 3);
-    buf[0] = READ;
-    buf[1] = Address & 0xFF00;
-    buf[2] = Address & 0x00FF;
-
-    res = SPI_Transfer(&this->SPI, buf, buf, (Len + 3));
+    int ret = this->WaitWrite();
+    if(ret == -1)
+        return -5;
+    if(ret != 0)
+        return -4;
 
-    for(int i = 0; i < Len; i++)
-        Data[i] = buf[i + 3];
+    // A single READ for the whole range, unless longer than what the kernel accept per ioctl.
+    // The header is sent, then the data is clocked straight into the caller buffer, on the same frame.
+    const int MaxChunk = SPI_GetMaxTransfer(&this->SPI) - HEADER_SIZE;
 
-    if(res != 0)
+    for(int Done = 0; Done < Len; Done += MaxChunk)
     {
-        free(buf);
-        return -3;
+        const int Chunk = std::min(MaxChunk, Len - Done);
+        const uint8_t header[HEADER_SIZE] = {READ,
+                                             (uint8_t)(((Address + Done) & 0xFF00) >> 8),
+                                             (uint8_t)((Address + Done) & 0x00FF)};
+
+        SPI_Transaction Transaction;
+        SPI_TransactionInit(&Transaction);
+        SPI_TransactionAppend(&Transaction, header, {});
+        SPI_TransactionAppend(&Transaction, {}, std::span<uint8_t>(&Data[Done], Chunk));
+
+        if(SPI_TransactionSubmit(&this->SPI, &Transaction) != 0)
+            return -3;
     }
 
-    free(buf);
     return 0;
 }
 
@@ -182,33 +295,41 @@ int M95256::Write(const int Address, uint8_t* const Data, const int Len)
 {
     if((0 > Address) | (Address > MAX_ADDRESS))
         return -1;
-    if((Address + Len) > MAX_ADDRESS)
+    if((Len < 0) | ((Address + Len) > MAX_ADDRESS + 1))
         return -2;
 
-    int res = 0;
-    uint8_t* buf = (uint8_t*)malloc(Len + 3);
-    if(buf == 0)
+    const uint8_t wren[1] = {WREN};
+    int ret = 0;
+
+    // The device wrap within a page : one WRITE per page touched. Each one is sent as soon as the previous write
+    // cycle is over, and the last one is awaited by the next operation.
+    int Done = 0;
+    while(Done < Len)
     {
-        std::cerr << "[ M95256 ][ Write ] Could not allocate memory for read operation "
-                  << strerror(errno) << std::endl;
-        return -1;
+        const int Chunk = std::min(PAGE_SIZE - ((Address + Done) % PAGE_SIZE), Len - Done);
+        const uint8_t header[HEADER_SIZE] = {WRITE,
+                                             (uint8_t)(((Address + Done) & 0xFF00) >> 8),
+                                             (uint8_t)((Address + Done) & 0x00FF)};
+
+        // WREN, then the header and the payload sent in place on the same frame, with a single ioctl.
+        SPI_Transaction Transaction;
+        SPI_TransactionInit(&Transaction);
+        SPI_TransactionAppend(&Transaction, wren, {}, true);
+        SPI_TransactionAppend(&Transaction, header, {});
+        SPI_TransactionAppend(&Transaction, std::span<const uint8_t>(&Data[Done], Chunk), {});
+
+        ret = this->WaitWrite();
+        if(ret == -1)
+            return -5;
+        if(ret != 0)
+            return -4;
+
+        if(SPI_TransactionSubmit(&this->SPI, &Transaction) != 0)
+            return -3;
+
+        this->StartWrite();
+        Done += Chunk;
     }
 
-    memset(buf, 0x00, Len + 3);
-    buf[0] = WRITE;
-    buf[1] = (uint8_t)((Address & 0xFF00) >> 8);
-    buf[2] = (uint8_t)(Address & 0x00FF);
-    memcpy(&buf[3], Data, Len);
-
-    this->WriteEnable();
-
-    res = SPI_Transfer(&this->SPI, buf, buf, (Len + 3));
-    free(buf);
-
-    if(res != 0)
-        return -2;
-
-    usleep(7000); // 7 ms of delay, to ensure page write.
-
     return 0;
-}
\ No newline at end of file
+}
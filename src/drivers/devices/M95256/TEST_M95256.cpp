@@ -0,0 +1,108 @@
+/**
+ * @file TEST_M95256.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Source for unittesting the M95256 driver, on a simulated device.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+
+// Including the unit test framework
+#include "CppUTest/TestHarness.h"
+
+// Include the tested header
+#include "drivers/devices/M95256.hpp"
+#include "drivers/peripherals/core/SPI_EepromTest.hpp"
+
+// STD
+#include <unistd.h>
+
+// ==============================================================================
+// DEFINES
+// ==============================================================================
+#define WRITE_CYCLE 1500 // us
+
+// ==============================================================================
+// TEST GROUPS
+// ==============================================================================
+
+// An erased M95256, with a fixed write cycle.
+TEST_GROUP_BASE(M95256_Simulated, SPI_EepromTest)
+{
+    void setup() override
+    {
+        SPI_EepromTest::setup();
+        Model->SetCycle(WRITE_CYCLE);
+    }
+};
+
+// ==============================================================================
+// TESTS
+// ==============================================================================
+
+TEST(M95256_Simulated, WritesAreSplitOnPages)
+{
+    uint8_t Data[150];
+    uint8_t Back[150];
+    for(int i = 0; i < 150; i++)
+        Data[i] = (uint8_t)(i + 3);
+
+    LONGS_EQUAL(0, Eeprom->Write(0x1F0, Data, 150));
+    LONGS_EQUAL(0, Eeprom->Read(0x1F0, Back, 150));
+    MEMCMP_EQUAL(Data, Back, 150);
+
+    // 0x1F0 to 0x285 : four pages, each one awaited before the next.
+    LONGS_EQUAL(4, Model->GetLog().size());
+    LONGS_EQUAL(4, Eeprom->GetStatistics().Cycles + Eeprom->GetStatistics().Estimated);
+}
+
+TEST(M95256_Simulated, WriteCyclesKeepBeingMeasured)
+{
+    uint8_t Data[PAGE_SIZE] = {0};
+
+    for(int i = 0; i < 20; i++)
+        LONGS_EQUAL(0, Eeprom->Write(i * PAGE_SIZE, Data, PAGE_SIZE));
+    LONGS_EQUAL(0, Eeprom->WaitWrite());
+
+    // Each cycle is either measured, shrink the estimate, or has been hidden by a late caller.
+    M95256_STATISTICS Statistics = Eeprom->GetStatistics();
+    LONGS_EQUAL(20, Statistics.Cycles + Statistics.Estimated + Statistics.Overlapped);
+    if(Statistics.Cycles > 0)
+        CHECK_TRUE(Statistics.MinCycle <= Statistics.MaxCycle);
+}
+
+TEST(M95256_Simulated, BusErrorWhileWaitingIsReported)
+{
+    uint8_t Data[4] = {1, 2, 3, 4};
+    uint8_t Back[4];
+
+    // The power is lost on the first write : the status can't be read anymore.
+    Model->CutPower(0);
+    LONGS_EQUAL(0, Eeprom->Write(0x00, Data, 4));
+    LONGS_EQUAL(-5, Eeprom->Read(0x00, Back, 4));
+    LONGS_EQUAL(-5, Eeprom->Write(0x40, Data, 4));
+    LONGS_EQUAL(0, Eeprom->GetStatistics().Polls);
+
+    // The cycle is still awaited once the bus is back.
+    Model->Restore();
+    LONGS_EQUAL(0, Eeprom->Read(0x00, Back, 4));
+    LONGS_EQUAL(1, Eeprom->GetStatistics().Polls);
+}
+
+TEST(M95256_Simulated, HiddenCyclesAreOverlapped)
+{
+    uint8_t Data[4] = {1, 2, 3, 4};
+
+    LONGS_EQUAL(0, Eeprom->Write(0x00, Data, 4));
+    usleep(2 * WRITE_CYCLE);
+    LONGS_EQUAL(0, Eeprom->WaitWrite());
+
+    LONGS_EQUAL(1, Eeprom->GetStatistics().Overlapped);
+    LONGS_EQUAL(0, Eeprom->GetStatistics().Cycles);
+}
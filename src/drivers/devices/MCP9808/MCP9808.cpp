@@ -35,6 +35,9 @@ constexpr int MANUFACTURER = 0x06;
 constexpr int DEVICEID = 0x07;
 constexpr int TEMP_RESOLUTION_REG = 0x08;
 
+// Identification
+constexpr int MCP9808_MANUFACTURER_ID = 0x0054;
+
 // ==============================================================================
 // MACROS
 // ==============================================================================
@@ -52,6 +55,7 @@ MCP9808::MCP9808(const I2C_Bus* I2C, const TEMP_SENSOR address)
 {
     this->address = (uint8_t)address;
     this->I2C = *I2C;
+    this->I2C.Priority = I2C_PRIORITY::BACKGROUND; // Telemetry, served once everything else is done.
     return;
 }
 
@@ -118,6 +122,47 @@ int IntsToFloat(const int Input, float* const OutputBuf)
 // FUNCTIONS
 // =====================
 
+I2C_Task MCP9808::Initialize(const TEMP_RESOLUTION Resolution,
+                             const float Minimal,
+                             const float Maximal,
+                             const float Critical)
+{
+    if((Minimal < -128) | (Minimal > 128) | (Maximal < -128) | (Maximal > 128) | (Critical < -128) |
+       (Critical > 128))
+        co_return -1;
+
+    // The buffers live in the coroutine frame, thus remain valid until each access is served.
+    // The ID is read by a combined transfer, whose NACK is reported.
+    uint16_t ID = 0;
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+    I2C_TransactionRead(&Transaction, this->address, REGISTER(MANUFACTURER), (uint8_t*)&ID, 2);
+    if(co_await I2C_TransactionSubmitAsync(&this->I2C, &Transaction) != 0)
+        co_return -2;
+    if(I2C_FromBigEndian(ID) != MCP9808_MANUFACTURER_ID)
+        co_return -3;
+
+    // Single byte register : the value is wrote as is.
+    int TResolution = (int)Resolution;
+    if(co_await I2C_WriteAsync(&this->I2C, this->address, REGISTER(TEMP_RESOLUTION_REG), &TResolution, 1, 1) !=
+       0)
+        co_return -2;
+
+    // Same encoding as SetAlertTemperatures().
+    const int Registers[3] = {UPPER_TEMP, LOWER_TEMP, CRIT_TEMP};
+    const float Limits[3] = {Maximal, Minimal, Critical};
+    for(int i = 0; i < 3; i++)
+    {
+        int buf = 0;
+        FloatToInts(Limits[i], &buf);
+        buf = SWAP_BYTES(buf);
+        if(co_await I2C_WriteAsync(&this->I2C, this->address, REGISTER(Registers[i]), &buf, 1, 2) != 0)
+            co_return -2;
+    }
+
+    co_return 0;
+}
+
 int MCP9808::ConfigureResolution(const TEMP_RESOLUTION Resolution)
 {
     int TResolution = SWAP_BYTES((int)Resolution);
@@ -166,21 +211,16 @@ int MCP9808::Configure(const TEMP_HYSTERESIS Hysteresis,
 
 int MCP9808::GetIDs(int* const DeviceID, int* const DeviceRevision, int* const ManufacturerID)
 {
-    int res = 0;
-    int buf = 0;
-    res += I2C_Read(&this->I2C, this->address, REGISTER(DEVICEID), &buf, 1, 2);
-    buf = SWAP_BYTES(buf);
-
-    *DeviceID = buf & 0x00FF;
-    *DeviceRevision = buf & 0xFF00;
-
-    buf = 0;
-    res += I2C_Read(&this->I2C, this->address, REGISTER(MANUFACTURER), &buf, 1, 2);
-    buf = SWAP_BYTES(buf);
-    *ManufacturerID = buf;
+    // MANUFACTURER and DEVICEID are contiguous, fetch both at once.
+    uint16_t buf[2] = {0};
+    int res = I2C_ReadWords(&this->I2C, this->address, REGISTER(MANUFACTURER), buf, 2);
 
     if(res != 0)
         return -1;
+
+    *ManufacturerID = buf[0];
+    *DeviceID = buf[1] & 0x00FF;
+    *DeviceRevision = buf[1] & 0xFF00;
     return 0;
 }
 
@@ -218,9 +258,9 @@ int MCP9808::SetAlertTemperatures(const float Minimal, const float Maximal, cons
 
 int MCP9808::ReadTemperature(float* const Temperature, int* const Status)
 {
-    int buf = 0;
-    int res = I2C_Read(&this->I2C, this->address, REGISTER(READ_TEMP), &buf, 1, 2);
-    buf = SWAP_BYTES(buf);
+    uint16_t word = 0;
+    int res = I2C_ReadWords(&this->I2C, this->address, REGISTER(READ_TEMP), &word, 1);
+    int buf = word;
 
     if(res != 0)
         return -1;
@@ -13,12 +13,16 @@
 #include "drivers/devices/PCM5252.hpp"
 
 // Drivers
+#include "drivers/peripherals/core/REG_Map.hpp"
 #include "drivers/peripherals/i2c.hpp"
 
 // STD
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <math.h>
+#include <string.h>
 #include <unistd.h>
 
 // ==============================================================================
@@ -30,7 +34,8 @@ constexpr int PAGE_SELECT = 0x00;
 
 // WARNING :
 // This device use multiple pages registers.
-// No checks are done in software, please verify your works.
+// Registers carry their page : bursts are checked at compile time (REG_Burst), and the page register is only
+// wrote when the page change.
 // Somes register contain RESERVED bits. Read the documentation before attempting write to it.
 
 // =====================
@@ -38,121 +43,220 @@ constexpr int PAGE_SELECT = 0x00;
 // =====================
 constexpr int PAGE_0 = 0x00;
 // PLL Config
-constexpr int PLL_P_FACTOR = 0x14;
-constexpr int PLL_J_FACTOR = 0x15;
-constexpr int PLL_D_FACTOR_MSB = 0x16;
-constexpr int PLL_D_FACTOR_LSB = 0x17;
-constexpr int PLL_R_FACTOR = 0x18;
-constexpr int PLL_CONTROL = 0x04;
-constexpr int PLL_INPUT_SOURCE = 0x0D;
-constexpr int PLL_INPUT_GPIO = 0x12;
+constexpr REG_Register PLL_P_FACTOR = {PAGE_0, 0x14};
+constexpr REG_Register PLL_J_FACTOR = {PAGE_0, 0x15};
+constexpr REG_Register PLL_D_FACTOR_MSB = {PAGE_0, 0x16};
+constexpr REG_Register PLL_D_FACTOR_LSB = {PAGE_0, 0x17};
+constexpr REG_Register PLL_R_FACTOR = {PAGE_0, 0x18};
+constexpr REG_Register PLL_CONTROL = {PAGE_0, 0x04};
+constexpr REG_Register PLL_INPUT_SOURCE = {PAGE_0, 0x0D};
+constexpr REG_Register PLL_INPUT_GPIO = {PAGE_0, 0x12};
 
 // GPIO Config
-constexpr int GPIO1_OUTPUT_FUNCTION = 0x50;
-constexpr int GPIO2_OUTPUT_FUNCTION = 0x51;
-constexpr int GPIO3_OUTPUT_FUNCTION = 0x52;
-constexpr int GPIO4_OUTPUT_FUNCTION = 0x53;
-constexpr int GPIO5_OUTPUT_FUNCTION = 0x54;
-constexpr int GPIO6_OUTPUT_FUNCTION = 0x55;
-constexpr int GPIO_OUTPUT_STATUS = 0x56;
-constexpr int GPIO_POLARITY = 0x57;
-constexpr int EXTERNAL_DIGITAL_FILTER = 0x7A;
-constexpr int GPIO12_EXTERNAL_FILTER = 0x7B;
-constexpr int GPIO34_EXTERNAL_FILTER = 0x7C;
-constexpr int GPIO56_EXTERNAL_FILTER = 0x7D;
-constexpr int GPIO_INPUT_VALUES = 0x77;
-constexpr int GPIO_CONTROL = 0x08;
+constexpr REG_Register GPIO1_OUTPUT_FUNCTION = {PAGE_0, 0x50};
+constexpr REG_Register GPIO2_OUTPUT_FUNCTION = {PAGE_0, 0x51};
+constexpr REG_Register GPIO3_OUTPUT_FUNCTION = {PAGE_0, 0x52};
+constexpr REG_Register GPIO4_OUTPUT_FUNCTION = {PAGE_0, 0x53};
+constexpr REG_Register GPIO5_OUTPUT_FUNCTION = {PAGE_0, 0x54};
+constexpr REG_Register GPIO6_OUTPUT_FUNCTION = {PAGE_0, 0x55};
+constexpr REG_Register GPIO_OUTPUT_STATUS = {PAGE_0, 0x56};
+constexpr REG_Register GPIO_POLARITY = {PAGE_0, 0x57};
+constexpr REG_Register EXTERNAL_DIGITAL_FILTER = {PAGE_0, 0x7A};
+constexpr REG_Register GPIO12_EXTERNAL_FILTER = {PAGE_0, 0x7B};
+constexpr REG_Register GPIO34_EXTERNAL_FILTER = {PAGE_0, 0x7C};
+constexpr REG_Register GPIO56_EXTERNAL_FILTER = {PAGE_0, 0x7D};
+constexpr REG_Register GPIO_INPUT_VALUES = {PAGE_0, 0x77};
+constexpr REG_Register GPIO_CONTROL = {PAGE_0, 0x08};
 
 // SPI Config
-constexpr int SPI_MISO_MODE = 0x06;
+constexpr REG_Register SPI_MISO_MODE = {PAGE_0, 0x06};
 
 // DSP Config
-constexpr int DSP_CLOCK_DIVIDER = 0x1B;
-constexpr int DSP_INPUT = 0x0A;
-constexpr int DSP_OVERFLOW = 0x5A;
-constexpr int DSP_PROGRAM_SELECT = 0x2B;
-constexpr int AUDIO_DATA_PATH = 0x2A;
-constexpr int SDOUT_EMPHASIS = 0x07;
-constexpr int IDAC_MSB = 0x23;
-constexpr int IDAC_LSB = 0x24;
+constexpr REG_Register DSP_CLOCK_DIVIDER = {PAGE_0, 0x1B};
+constexpr REG_Register DSP_INPUT = {PAGE_0, 0x0A};
+constexpr REG_Register DSP_OVERFLOW = {PAGE_0, 0x5A};
+constexpr REG_Register DSP_PROGRAM_SELECT = {PAGE_0, 0x2B};
+constexpr REG_Register AUDIO_DATA_PATH = {PAGE_0, 0x2A};
+constexpr REG_Register SDOUT_EMPHASIS = {PAGE_0, 0x07};
+constexpr REG_Register IDAC_MSB = {PAGE_0, 0x23};
+constexpr REG_Register IDAC_LSB = {PAGE_0, 0x24};
 
 // I2S Config
-constexpr int I2S_CLOCK_CONFIG = 0x09;
-constexpr int I2S_CONFIG = 0x28;
-constexpr int I2S_OFFSET = 0x29;
-constexpr int FS_SPEED = 0x22;
-constexpr int MASTER_MODE_CONTROL = 0x0C;
+constexpr REG_Register I2S_CLOCK_CONFIG = {PAGE_0, 0x09};
+constexpr REG_Register I2S_CONFIG = {PAGE_0, 0x28};
+constexpr REG_Register I2S_OFFSET = {PAGE_0, 0x29};
+constexpr REG_Register FS_SPEED = {PAGE_0, 0x22};
+constexpr REG_Register MASTER_MODE_CONTROL = {PAGE_0, 0x0C};
 
 // Clocks
-constexpr int DAC_CLOCK_DIVIDER = 0x1C;
-constexpr int IGNORE_DETECTION = 0x25;
-constexpr int CLOCK_MISSING_DETECT = 0x2C;
-constexpr int CLOCK_SYSTEM_STATUS = 0x5E;
-constexpr int CLOCK_SYSTEM_ERRORS = 0x5F;
-constexpr int DAC_CLOCK_SOURCE = 0x0E;
-constexpr int DAC_RESYNC = 0x13;
-constexpr int NCP_CLOCK_DIVIDER = 0x1D;
-constexpr int OSR_CLOCK_DIVIDER = 0x1E;
-constexpr int MASTER_BCK_DIVIDER = 0x20;
-constexpr int LRCK_DIVIDER = 0x21;
-constexpr int DETECTED_AUDIO_SPECS = 0x5B;
-constexpr int DETECTED_BCK_RATIO_MSB = 0x5C;
-constexpr int DETECTED_BCK_RATIO_LSB = 0x5D;
+constexpr REG_Register DAC_CLOCK_DIVIDER = {PAGE_0, 0x1C};
+constexpr REG_Register IGNORE_DETECTION = {PAGE_0, 0x25};
+constexpr REG_Register CLOCK_MISSING_DETECT = {PAGE_0, 0x2C};
+constexpr REG_Register CLOCK_SYSTEM_STATUS = {PAGE_0, 0x5E};
+constexpr REG_Register CLOCK_SYSTEM_ERRORS = {PAGE_0, 0x5F};
+constexpr REG_Register DAC_CLOCK_SOURCE = {PAGE_0, 0x0E};
+constexpr REG_Register DAC_RESYNC = {PAGE_0, 0x13};
+constexpr REG_Register NCP_CLOCK_DIVIDER = {PAGE_0, 0x1D};
+constexpr REG_Register OSR_CLOCK_DIVIDER = {PAGE_0, 0x1E};
+constexpr REG_Register MASTER_BCK_DIVIDER = {PAGE_0, 0x20};
+constexpr REG_Register LRCK_DIVIDER = {PAGE_0, 0x21};
+constexpr REG_Register DETECTED_AUDIO_SPECS = {PAGE_0, 0x5B};
+constexpr REG_Register DETECTED_BCK_RATIO_MSB = {PAGE_0, 0x5C};
+constexpr REG_Register DETECTED_BCK_RATIO_LSB = {PAGE_0, 0x5D};
 
 // Misc. DAC Controls
-constexpr int DAC_RESET = 0x01;
-constexpr int POWER_CONTROL = 0x02;
-constexpr int MUTE_CONTROL = 0x03;
-constexpr int DAC_ARCHITECTURE = 0x79;
+constexpr REG_Register DAC_RESET = {PAGE_0, 0x01};
+constexpr REG_Register POWER_CONTROL = {PAGE_0, 0x02};
+constexpr REG_Register MUTE_CONTROL = {PAGE_0, 0x03};
+constexpr REG_Register DAC_ARCHITECTURE = {PAGE_0, 0x79};
 
 // DAC Status (for most read-only)
-constexpr int MUTE_STATUS = 0x6C;
-constexpr int OUTPUT_SHORT_STATUS = 0x6D;
-constexpr int XSMUTE_STATUS = 0x72;
-constexpr int FS_SPEED_MONITOR = 0x73;
-constexpr int DSP_STATUS = 0x76;
-constexpr int AUTO_MUTE_STATUS = 0x78;
+constexpr REG_Register MUTE_STATUS = {PAGE_0, 0x6C};
+constexpr REG_Register OUTPUT_SHORT_STATUS = {PAGE_0, 0x6D};
+constexpr REG_Register XSMUTE_STATUS = {PAGE_0, 0x72};
+constexpr REG_Register FS_SPEED_MONITOR = {PAGE_0, 0x73};
+constexpr REG_Register DSP_STATUS = {PAGE_0, 0x76};
+constexpr REG_Register AUTO_MUTE_STATUS = {PAGE_0, 0x78};
 
 // Analog Output Config
-constexpr int AUTOMUTE_DELAY = 0x3B;
-constexpr int GLOBAL_DIGITAL_VOLUME = 0x3C;
-constexpr int LEFT_DIGITAl_VOLUME = 0x3D;
-constexpr int RIGHT_DIGITAl_VOLUME = 0x3E;
-constexpr int NORMAL_VOLUME_RAMPS = 0x3F;
-constexpr int ERROR_VOLUME_RAMPS = 0x40;
-constexpr int AUTO_MUTE = 0x41;
+constexpr REG_Register AUTOMUTE_DELAY = {PAGE_0, 0x3B};
+constexpr REG_Register GLOBAL_DIGITAL_VOLUME = {PAGE_0, 0x3C};
+constexpr REG_Register LEFT_DIGITAl_VOLUME = {PAGE_0, 0x3D};
+constexpr REG_Register RIGHT_DIGITAl_VOLUME = {PAGE_0, 0x3E};
+constexpr REG_Register NORMAL_VOLUME_RAMPS = {PAGE_0, 0x3F};
+constexpr REG_Register ERROR_VOLUME_RAMPS = {PAGE_0, 0x40};
+constexpr REG_Register AUTO_MUTE = {PAGE_0, 0x41};
 
 // =====================
 // PAGE 1
 // =====================
 constexpr int PAGE_1 = 0x01;
 // Analog Config
-constexpr int OUTPUT_AMPLITUDE_REF = 0x01;
-constexpr int ANALOG_GAIN = 0x02;
-constexpr int EXTERNAL_UVP = 0x05;
-constexpr int ANALOG_MUTE = 0x06;
-constexpr int ANALOG_GAIN_BOOST = 0x07;
-constexpr int VCOM_RAMP = 0x08;
-constexpr int VCOM_POWER = 0x09;
+constexpr REG_Register OUTPUT_AMPLITUDE_REF = {PAGE_1, 0x01};
+constexpr REG_Register ANALOG_GAIN = {PAGE_1, 0x02};
+constexpr REG_Register EXTERNAL_UVP = {PAGE_1, 0x05};
+constexpr REG_Register ANALOG_MUTE = {PAGE_1, 0x06};
+constexpr REG_Register ANALOG_GAIN_BOOST = {PAGE_1, 0x07};
+constexpr REG_Register VCOM_RAMP = {PAGE_1, 0x08};
+constexpr REG_Register VCOM_POWER = {PAGE_1, 0x09};
 
 // =====================
 // PAGE 44
 // =====================
 constexpr int PAGE_44 = 0x2C;
-constexpr int DSP_ADAPTATIVE = 0x01;
+constexpr REG_Register DSP_ADAPTATIVE = {PAGE_44, 0x01};
 
 // =====================
 // PAGE 253
 // =====================
 constexpr int PAGE_253 = 0xFD;
-constexpr int CLOCK_FLEX_1 = 0x3F;
-constexpr int CLOCK_FLEX_2 = 0x40;
+constexpr REG_Register CLOCK_FLEX_1 = {PAGE_253, 0x3F};
+constexpr REG_Register CLOCK_FLEX_2 = {PAGE_253, 0x40};
 
 // =====================
 // DSP
 // =====================
 constexpr int INSTR = 0x98;
 
+// Coefficient and instruction RAM : 30 words per page, from register 8, one every 4 registers.
+constexpr int DSP_WORDS_PER_PAGE = 30;
+constexpr int DSP_WORDS_REGISTER = 0x08;
+constexpr int COEFFICIENT_PAGES = 9;
+constexpr int COEFFICIENT_WIDTH = 3;
+constexpr int INSTRUCTION_PAGE = 0x7D;
+constexpr int INSTRUCTION_PAGES = 52;
+constexpr int INSTRUCTION_WIDTH = 4;
+constexpr int CRAM_SWAP_POLL = 100; // us between two reads of the CRAM switch status
+
+// ==============================================================================
+// IC REGISTER FIELDS
+// ==============================================================================
+
+// Reset, power and mute
+using RSTM = REG_Field<DAC_RESET, 4>;
+using RSTR = REG_Field<DAC_RESET, 0>;
+using RQST = REG_Field<POWER_CONTROL, 4>;
+using RQPD = REG_Field<POWER_CONTROL, 0>;
+using RQML = REG_Field<MUTE_CONTROL, 4>;
+using RQMR = REG_Field<MUTE_CONTROL, 0>;
+
+// PLL
+using PLLE = REG_Field<PLL_CONTROL, 0>;
+using PLCK = REG_Field<PLL_CONTROL, 4>;
+using SREF = REG_Field<PLL_INPUT_SOURCE, 4, 3>;
+using GREF = REG_Field<PLL_INPUT_GPIO, 0, 3>;
+
+// I2S
+using BCKP = REG_Field<I2S_CLOCK_CONFIG, 5>;
+using BCKO = REG_Field<I2S_CLOCK_CONFIG, 4>;
+using LRKO = REG_Field<I2S_CLOCK_CONFIG, 0>;
+using RBCK = REG_Field<MASTER_MODE_CONTROL, 1>;
+using RLRK = REG_Field<MASTER_MODE_CONTROL, 0>;
+using I16E = REG_Field<FS_SPEED, 4>;
+using FSSP = REG_Field<FS_SPEED, 0, 2>;
+using AFMT = REG_Field<I2S_CONFIG, 4, 2>;
+using ALEN = REG_Field<I2S_CONFIG, 0, 2>;
+
+// DAC
+using SDAC = REG_Field<DAC_CLOCK_SOURCE, 4, 3>;
+using AUPL = REG_Field<AUDIO_DATA_PATH, 4, 2>;
+using AUPR = REG_Field<AUDIO_DATA_PATH, 0, 2>;
+using PCTL = REG_Field<GLOBAL_DIGITAL_VOLUME, 0, 2>;
+using DAMD = REG_Field<DAC_ARCHITECTURE, 0>;
+using RQSY = REG_Field<DAC_RESYNC, 0>;
+
+// Auto mute and volume ramps
+using ATML = REG_Field<AUTOMUTE_DELAY, 4, 3>;
+using ATMR = REG_Field<AUTOMUTE_DELAY, 0, 3>;
+using VNDF = REG_Field<NORMAL_VOLUME_RAMPS, 6, 2>;
+using VNDS = REG_Field<NORMAL_VOLUME_RAMPS, 4, 2>;
+using VNUF = REG_Field<NORMAL_VOLUME_RAMPS, 2, 2>;
+using VNUS = REG_Field<NORMAL_VOLUME_RAMPS, 0, 2>;
+using VEDF = REG_Field<ERROR_VOLUME_RAMPS, 6, 2>;
+using VEDS = REG_Field<ERROR_VOLUME_RAMPS, 4, 2>;
+using ACTL = REG_Field<AUTO_MUTE, 2>;
+using AMLE = REG_Field<AUTO_MUTE, 1>;
+using AMRE = REG_Field<AUTO_MUTE, 0>;
+
+// DSP
+using DEMP = REG_Field<SDOUT_EMPHASIS, 4>;
+using SDSL = REG_Field<SDOUT_EMPHASIS, 0>;
+using AMDC = REG_Field<DSP_ADAPTATIVE, 3>;
+using AMCE = REG_Field<DSP_ADAPTATIVE, 2>;
+using ACRM = REG_Field<DSP_ADAPTATIVE, 1>;
+using ACRS = REG_Field<DSP_ADAPTATIVE, 0>;
+
+// External interpolation filter
+using EXTF = REG_Field<EXTERNAL_DIGITAL_FILTER, 0>;
+using G1SL = REG_Field<GPIO12_EXTERNAL_FILTER, 4, 3>;
+using G2SL = REG_Field<GPIO12_EXTERNAL_FILTER, 0, 3>;
+using G3SL = REG_Field<GPIO34_EXTERNAL_FILTER, 4, 3>;
+using G4SL = REG_Field<GPIO34_EXTERNAL_FILTER, 0, 3>;
+using G5SL = REG_Field<GPIO56_EXTERNAL_FILTER, 4, 3>;
+using G6SL = REG_Field<GPIO56_EXTERNAL_FILTER, 0, 3>;
+
+// Clock errors
+using IDFS = REG_Field<IGNORE_DETECTION, 6>;
+using IDBK = REG_Field<IGNORE_DETECTION, 5>;
+using IDSK = REG_Field<IGNORE_DETECTION, 4>;
+using IDCH = REG_Field<IGNORE_DETECTION, 3>;
+using IDCM = REG_Field<IGNORE_DETECTION, 2>;
+using DCAS = REG_Field<IGNORE_DETECTION, 1>;
+using IPLK = REG_Field<IGNORE_DETECTION, 0>;
+using CMDP = REG_Field<CLOCK_MISSING_DETECT, 0, 3>;
+
+// Analog (page 1)
+using AOSL = REG_Field<OUTPUT_AMPLITUDE_REF, 0>;
+using LAGN = REG_Field<ANALOG_GAIN, 4>;
+using RAGN = REG_Field<ANALOG_GAIN, 0>;
+using UEPD = REG_Field<EXTERNAL_UVP, 1>;
+using UIPD = REG_Field<EXTERNAL_UVP, 0>;
+using RCMP = REG_Field<ANALOG_MUTE, 0>;
+using AGBL = REG_Field<ANALOG_GAIN_BOOST, 4>;
+using AGBR = REG_Field<ANALOG_GAIN_BOOST, 0>;
+using RCMF = REG_Field<VCOM_RAMP, 0>;
+using VCPD = REG_Field<VCOM_POWER, 0>;
+
 // =====================
 // MACROS
 // =====================
@@ -169,9 +273,212 @@ constexpr int REGISTER_NONINCREMENT(int x)
 // PRIVATE FUNCTIONS
 // =====================
 
+// Pages mirrored by the shadow, in slot order.
+constexpr int SHADOWED_PAGES[] = {PAGE_0, PAGE_1, PAGE_44, PAGE_253};
+
 int PCM5252::SelectPage(int Page)
 {
-    return I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(PAGE_SELECT), &Page);
+    if(this->CurrentPage == Page)
+        return 0;
+
+    int res = I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(PAGE_SELECT), &Page);
+    this->CurrentPage = (res == 0) ? Page : -1;
+    return res;
+}
+
+int PCM5252::SelectPage(I2C_Transaction* const Transaction, const uint8_t* const Page)
+{
+    if(this->CurrentPage == *Page)
+        return 0;
+
+    // The page is assumed selected once queued : on failure, Submit() forget it.
+    int res = I2C_TransactionWrite(
+        Transaction, this->address, REGISTER_NONINCREMENT(PAGE_SELECT), Page, 1);
+    if(res == 0)
+        this->CurrentPage = *Page;
+    return res;
+}
+
+int PCM5252::ShadowSlot(const int Page)
+{
+    for(int slot = 0; slot < SHADOW_PAGES; slot++)
+        if(SHADOWED_PAGES[slot] == Page)
+            return slot;
+    return -1;
+}
+
+void PCM5252::InvalidateShadow()
+{
+    // Values are kept, thus pending registers can still be flushed.
+    memset(this->ShadowValid, 0x00, sizeof(this->ShadowValid));
+    this->CurrentPage = -1;
+}
+
+int PCM5252::QueueWrite(I2C_Transaction* const Transaction,
+                        const REG_Register Register,
+                        const uint8_t* const Values,
+                        const int Size)
+{
+    int res = 0;
+    res += this->SelectPage(Transaction, &Register.Page);
+
+    int Command = (Size > 1) ? REGISTER_AUTOINCREMENT(Register) : REGISTER_NONINCREMENT(Register);
+    res += I2C_TransactionWrite(Transaction, this->address, Command, Values, Size);
+    return res;
+}
+
+int PCM5252::WriteRegisters(I2C_Transaction* const Transaction,
+                            const REG_Register Register,
+                            const uint8_t* const Values,
+                            const int Size)
+{
+    int slot = this->ShadowSlot(Register.Page);
+    if(slot < 0)
+        return this->QueueWrite(Transaction, Register, Values, Size);
+
+    for(int i = 0; i < Size; i++)
+    {
+        int reg = Register.Address + i;
+        uint64_t bit = 1ULL << (reg & 0x3F);
+        bool changed = ((this->ShadowValid[slot][reg >> 6] & bit) == 0)
+            | (this->Shadow[slot][reg] != Values[i]);
+
+        this->Shadow[slot][reg] = Values[i];
+        this->ShadowValid[slot][reg >> 6] |= bit;
+        if((this->WriteMode == DAC_WRITE::DEFERRED) & changed)
+            this->ShadowDirty[slot][reg >> 6] |= bit;
+    }
+
+    if(this->WriteMode == DAC_WRITE::DEFERRED)
+        return 0;
+    return this->QueueWrite(Transaction, Register, Values, Size);
+}
+
+int PCM5252::ReadRegister(const REG_Register Register, int* const Value)
+{
+    int slot = this->ShadowSlot(Register.Page);
+    uint64_t bit = 1ULL << (Register.Address & 0x3F);
+
+    if((slot >= 0) && (this->ShadowValid[slot][Register.Address >> 6] & bit))
+    {
+        *Value = this->Shadow[slot][Register.Address];
+        return 0;
+    }
+
+    int res = 0;
+    res += this->SelectPage(Register.Page);
+    res += I2C_Read(&this->I2C, this->address, REGISTER_NONINCREMENT(Register), Value);
+    if((res != 0) | (slot < 0))
+        return res;
+
+    this->Shadow[slot][Register.Address] = (uint8_t)*Value;
+    this->ShadowValid[slot][Register.Address >> 6] |= bit;
+    return 0;
+}
+
+int PCM5252::Submit(I2C_Transaction* const Transaction)
+{
+    if(Transaction->MessageCount == 0)
+        return 0;
+
+    int res = I2C_TransactionSubmit(&this->I2C, Transaction);
+    if(res != 0)
+        this->InvalidateShadow();
+    return res;
+}
+
+int PCM5252::WriteDSPWords(const int FirstPage,
+                           const int Pages,
+                           const int Width,
+                           uint8_t* const Resident,
+                           uint64_t* const Known,
+                           const int First,
+                           const uint8_t* const Values,
+                           const int Count)
+{
+    if((First < 0) | (Count < 0) | (First + Count > Pages * DSP_WORDS_PER_PAGE))
+        return -1;
+
+    // A word is only sent if it differ from the one known to be on the DAC.
+    auto Changed = [&](const int i) {
+        const int Word = First + i;
+        return ((Known[Word >> 6] & (1ULL << (Word & 0x3F))) == 0) ||
+               (memcmp(&Resident[Word * Width], &Values[i * Width], Width) != 0);
+    };
+
+    const auto Start = std::chrono::steady_clock::now();
+    uint8_t Image[DSP_WORDS_PER_PAGE * 4];
+    int res = 0;
+    int i = 0;
+
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+    while((i < Count) & (res == 0))
+    {
+        if(!Changed(i))
+        {
+            this->Upload.Skipped++;
+            i++;
+            continue;
+        }
+
+        // Run of changed words, within the page.
+        const int Word = First + i;
+        const uint8_t Page = (uint8_t)(FirstPage + Word / DSP_WORDS_PER_PAGE);
+        const int Slot = Word % DSP_WORDS_PER_PAGE;
+        const int Limit = std::min(Count - i, DSP_WORDS_PER_PAGE - Slot);
+        int n = 1;
+        while((n < Limit) && Changed(i + n))
+            n++;
+
+        // Image of the run : 4 registers per word, MSB first, the unused ones cleared. The last one is not sent.
+        memset(Image, 0x00, sizeof(Image));
+        for(int w = 0; w < n; w++)
+            memcpy(&Image[w * 4], &Values[(i + w) * Width], Width);
+        const int Len = n * 4 - (4 - Width);
+
+        // Runs are packed on the same transfer, as long as the page selection and the burst fit.
+        if((Transaction.MessageCount + 2 > I2C_MAX_MESSAGES) |
+           (Transaction.BufferUsed + Len + 3 > I2C_TRANSACTION_BUFFER))
+        {
+            res += this->Submit(&Transaction);
+            I2C_TransactionInit(&Transaction);
+            this->Upload.Transfers++;
+        }
+
+        res += this->SelectPage(&Transaction, &Page);
+        res += I2C_TransactionWrite(&Transaction,
+                                    this->address,
+                                    REGISTER_AUTOINCREMENT(DSP_WORDS_REGISTER + Slot * 4),
+                                    Image,
+                                    Len);
+        this->Upload.Bursts++;
+        this->Upload.Bytes += Len;
+        i += n;
+    }
+
+    if(Transaction.MessageCount > 0)
+        this->Upload.Transfers++;
+    res += this->Submit(&Transaction);
+
+    // On failure, the words of the range may or may not have been wrote : they're forgotten.
+    for(int w = First; w < First + Count; w++)
+    {
+        if(res == 0)
+        {
+            memcpy(&Resident[w * Width], &Values[(w - First) * Width], Width);
+            Known[w >> 6] |= 1ULL << (w & 0x3F);
+        }
+        else
+            Known[w >> 6] &= ~(1ULL << (w & 0x3F));
+    }
+
+    this->Upload.Duration += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::steady_clock::now() - Start)
+                                 .count();
+    if(res != 0)
+        return -2;
+    return 0;
 }
 
 // =====================
@@ -183,6 +490,18 @@ PCM5252::PCM5252(const I2C_Bus* I2C, const DAC address)
     // Global I2C variables
     this->address = (uint8_t)address;
     this->I2C = *I2C;
+    this->I2C.Priority = I2C_PRIORITY::CONTROL; // Volume and mute changes must overtake telemetry polling.
+
+    // Shadow of the registers, nothing is known yet.
+    memset(this->Shadow, 0x00, sizeof(this->Shadow));
+    memset(this->ShadowValid, 0x00, sizeof(this->ShadowValid));
+    memset(this->ShadowDirty, 0x00, sizeof(this->ShadowDirty));
+    this->CurrentPage = -1;
+    this->WriteMode = DAC_WRITE::THROUGH;
+    this->Upload = DAC_UPLOAD_STATISTICS{};
+
+    // Content of the CRAM, nothing is known yet.
+    this->InvalidateDSPImage();
 
     // PLL Variables
     this->PLLINPUTFREQ = 16'000'000;
@@ -205,12 +524,23 @@ PCM5252::~PCM5252()
 // SIMPLE FUNCTIONS
 int PCM5252::ConfigureReset(const int Registers, const int DSP)
 {
-    int buf = (bool)DSP;
-    buf = (buf << 4) | (bool)Registers;
+    uint8_t buf = REG_Pack<RSTM, RSTR>(DSP, Registers);
 
+    // Reset requests are not mirrored, and always sent immediately.
     int res = 0;
-    res += this->SelectPage(PAGE_0);
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(DAC_RESET), &buf);
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+    res += this->QueueWrite(&Transaction, DAC_RESET, &buf, 1);
+    res += this->Submit(&Transaction);
+
+    // Registers are back to their default values, pending writes are lost.
+    if((bool)Registers)
+    {
+        this->InvalidateShadow();
+        memset(this->ShadowDirty, 0x00, sizeof(this->ShadowDirty));
+    }
+    if((bool)DSP)
+        this->InvalidateDSPImage();
 
     if(res != 0)
         return -1;
@@ -219,12 +549,14 @@ int PCM5252::ConfigureReset(const int Registers, const int DSP)
 
 int PCM5252::ConfigureLowPower(const int Standby, const int PowerDown)
 {
-    int buf = (bool)Standby;
-    buf = (buf << 4) | (bool)PowerDown;
+    uint8_t buf = REG_Pack<RQST, RQPD>(Standby, PowerDown);
 
+    // A single message, once the page is selected.
     int res = 0;
-    res += this->SelectPage(PAGE_0);
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(POWER_CONTROL), &buf);
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+    res += this->WriteRegisters(&Transaction, POWER_CONTROL, &buf, 1);
+    res += this->Submit(&Transaction);
 
     if(res != 0)
         return -1;
@@ -233,12 +565,14 @@ int PCM5252::ConfigureLowPower(const int Standby, const int PowerDown)
 
 int PCM5252::Mute(const int MuteLeft, const int MuteRight)
 {
-    int buf = (bool)MuteLeft;
-    buf = (buf << 4) | (bool)MuteRight;
+    uint8_t buf = REG_Pack<RQML, RQMR>(MuteLeft, MuteRight);
 
+    // A single message, once the page is selected.
     int res = 0;
-    res += this->SelectPage(PAGE_0);
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(MUTE_CONTROL), &buf);
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+    res += this->WriteRegisters(&Transaction, MUTE_CONTROL, &buf, 1);
+    res += this->Submit(&Transaction);
 
     if(res != 0)
         return -1;
@@ -250,15 +584,120 @@ int PCM5252::DSPSwitchCRAM()
     int res = 0;
     int buf = 0;
 
+    res += this->ReadRegister(DSP_ADAPTATIVE, &buf);
+
+    // The switch request clear itself, thus it's not mirrored.
+    uint8_t request = ACRS::Update(buf, 1);
+
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+    res += this->QueueWrite(&Transaction, DSP_ADAPTATIVE, &request, 1);
+    res += this->Submit(&Transaction);
+
+    if(res != 0)
+        return -1;
+    return 0;
+}
+
+int PCM5252::ReadActiveCRAM(DAC_BUFFER* const Active)
+{
+    int res = 0;
+    int status = 0;
+
+    // ACRM is a status bit : it's always read from the DAC, and never from the shadow.
     res += this->SelectPage(PAGE_44);
-    res += I2C_Read(&this->I2C, this->address, REGISTER_NONINCREMENT(DSP_ADAPTATIVE), &buf);
+    res += I2C_Read(&this->I2C, this->address, REGISTER_NONINCREMENT(DSP_ADAPTATIVE), &status);
+    if(res != 0)
+        return -1;
+
+    *Active = (ACRM::Extract(status) == 0) ? DAC_BUFFER::A : DAC_BUFFER::B;
+    return 0;
+}
+
+int PCM5252::DSPSwapCRAM(const int Timeout, DAC_BUFFER* const Active)
+{
+    DAC_BUFFER Previous;
+    if(this->ReadActiveCRAM(&Previous) != 0)
+        return -1;
+    if(this->DSPSwitchCRAM() != 0)
+        return -1;
+
+    // The switch is done on the next audio frame : the request clear itself, and the active CRAM change.
+    int status = 0;
+    for(int elapsed = 0;; elapsed += CRAM_SWAP_POLL)
+    {
+        int res = 0;
+        res += this->SelectPage(PAGE_44);
+        res += I2C_Read(&this->I2C, this->address, REGISTER_NONINCREMENT(DSP_ADAPTATIVE), &status);
+        if(res != 0)
+            return -1;
+
+        DAC_BUFFER Current = (ACRM::Extract(status) == 0) ? DAC_BUFFER::A : DAC_BUFFER::B;
+        if((ACRS::Extract(status) == 0) & (Current != Previous))
+        {
+            if(Active != nullptr)
+                *Active = Current;
+            return 0;
+        }
+
+        if(elapsed >= Timeout * 1000)
+            return -2;
+        usleep(CRAM_SWAP_POLL);
+    }
+}
+
+// SHADOW FUNCTIONS
+int PCM5252::SetWriteMode(const DAC_WRITE Mode)
+{
+    int res = 0;
+    if(Mode == DAC_WRITE::THROUGH)
+        res = this->Flush();
 
-    buf = buf | 0x01; // Set the last bit to '1'
+    this->WriteMode = Mode;
+    return res;
+}
 
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(DSP_ADAPTATIVE), &buf);
+int PCM5252::Flush()
+{
+    int res = 0;
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+
+    for(int slot = 0; slot < SHADOW_PAGES; slot++)
+    {
+        // Each run of contiguous dirty registers is sent as a single burst. R0 is the page register.
+        int reg = 1;
+        while(reg < 128)
+        {
+            if((this->ShadowDirty[slot][reg >> 6] & (1ULL << (reg & 0x3F))) == 0)
+            {
+                reg++;
+                continue;
+            }
+
+            int end = reg;
+            while((end < 128) && (this->ShadowDirty[slot][end >> 6] & (1ULL << (end & 0x3F))))
+                end++;
+
+            // Room for the page selection and the burst, otherwise send what has been staged.
+            if((Transaction.MessageCount + 2 > I2C_MAX_MESSAGES)
+               | (Transaction.BufferUsed + (end - reg) + 3 > I2C_TRANSACTION_BUFFER))
+            {
+                res += this->Submit(&Transaction);
+                I2C_TransactionInit(&Transaction);
+            }
+
+            REG_Register Register = {(uint8_t)SHADOWED_PAGES[slot], (uint8_t)reg};
+            res += this->QueueWrite(&Transaction, Register, &this->Shadow[slot][reg], end - reg);
+            reg = end;
+        }
+    }
+    res += this->Submit(&Transaction);
 
     if(res != 0)
         return -1;
+
+    memset(this->ShadowDirty, 0x00, sizeof(this->ShadowDirty));
     return 0;
 }
 
@@ -271,9 +710,9 @@ int PCM5252::ConfigurePLL(const int EnablePLL,
                           const int PLLR,
                           int* const PLLLock)
 {
-    if((PLLReference > 0x03) | (PLLReference == 0x02))
+    if(!SREF::Valid(PLLReference) | (PLLReference > 0x03) | (PLLReference == 0x02))
         return -1;
-    if((0x00 > PLLSource) | (PLLSource > 0x05))
+    if(!GREF::Valid(PLLSource) | (PLLSource > 0x05))
         return -2;
     if((0 > PLLP) | (PLLP > 14))
         return -3;
@@ -299,36 +738,43 @@ int PCM5252::ConfigurePLL(const int EnablePLL,
         return -5;
 
     // Creating buffers
-    int buf[9] = {0};
-    buf[0] = (bool)EnablePLL; // R4
-    buf[1] = PLLReference << 4; // R13
-    buf[2] = PLLSource; // R18
+    using PLL_FACTORS =
+        REG_Burst<PLL_P_FACTOR, PLL_J_FACTOR, PLL_D_FACTOR_MSB, PLL_D_FACTOR_LSB, PLL_R_FACTOR>;
+
+    uint8_t buf[8] = {0};
+    buf[0] = PLLE::Pack(EnablePLL); // R4
+    buf[1] = SREF::Pack(PLLReference); // R13
+    buf[2] = GREF::Pack(PLLSource); // R18
     buf[3] = PLLP; // R20
     buf[4] = PLLJ; // R21
-    buf[5] = PLLD & 0x00FF; // R22
-    buf[6] = PLLD & 0xFF00; // R23
+    buf[5] = (PLLD & 0x3F00) >> 8; // R22
+    buf[6] = PLLD & 0x00FF; // R23
     buf[7] = PLLR; // R24
 
     int res = 0;
+    int lock = 0;
 
-    // Writes
-    res += this->SelectPage(PAGE_0);
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(PLL_CONTROL), &buf[0]);
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(PLL_INPUT_SOURCE), &buf[1]);
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(PLL_INPUT_GPIO), &buf[2]);
+    // Writes : the whole sequence is sent as a single I2C_RDWR transaction.
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+    res += this->WriteRegisters(&Transaction, PLL_CONTROL, &buf[0], 1);
+    res += this->WriteRegisters(&Transaction, PLL_INPUT_SOURCE, &buf[1], 1);
+    res += this->WriteRegisters(&Transaction, PLL_INPUT_GPIO, &buf[2], 1);
 
-    // Since five registers are contigous, we iterate over them inside of the I2C_Write function. We only pass the address of begining.
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(PLL_P_FACTOR), &buf[3], 5);
+    // Since five registers are contigous, they're sent as a single auto-incremented burst.
+    res += this->WriteRegisters(&Transaction, PLL_FACTORS::Register, &buf[3], PLL_FACTORS::Length);
+    res += this->Submit(&Transaction);
 
     // Read back the lock flag
     usleep(
         800); // 800 us delay to ensure that the PLL will lock if settings are correctly configured.
-    res += I2C_Read(&this->I2C, this->address, REGISTER_NONINCREMENT(PLL_CONTROL), &buf[8]);
+    res += this->SelectPage(PLL_CONTROL.Page);
+    res += I2C_Read(&this->I2C, this->address, REGISTER_NONINCREMENT(PLL_CONTROL), &lock);
 
     if(res != 0)
         return -6;
 
-    *PLLLock = (buf[8] >> 4) & 0x01;
+    *PLLLock = PLCK::Extract(lock);
     return 0;
 }
 
@@ -344,7 +790,7 @@ int PCM5252::ConfigureGPIO(const int MISOFunction,
                            const int GPIOInversion)
 {
     int res = 0;
-    int buf[10] = {0}; // Our buffers
+    uint8_t buf[10] = {0}; // Our buffers
 
     // MISO Function Selection
     if((0 > MISOFunction) | (MISOFunction > 1))
@@ -387,17 +833,25 @@ int PCM5252::ConfigureGPIO(const int MISOFunction,
         return -10;
     buf[9] = GPIOInversion;
 
+    using GPIO_FUNCTIONS = REG_Burst<GPIO1_OUTPUT_FUNCTION,
+                                     GPIO2_OUTPUT_FUNCTION,
+                                     GPIO3_OUTPUT_FUNCTION,
+                                     GPIO4_OUTPUT_FUNCTION,
+                                     GPIO5_OUTPUT_FUNCTION,
+                                     GPIO6_OUTPUT_FUNCTION,
+                                     GPIO_OUTPUT_STATUS,
+                                     GPIO_POLARITY>;
+
     // I2C Writes
-    res += this->SelectPage(PAGE_0);
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(SPI_MISO_MODE), &buf[0]);
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(GPIO_CONTROL), &buf[1]);
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+    res += this->WriteRegisters(&Transaction, SPI_MISO_MODE, &buf[0], 1);
+    res += this->WriteRegisters(&Transaction, GPIO_CONTROL, &buf[1], 1);
 
-    // Since eight registers are contigous, we iterate over them inside of the I2C_Write function. We only pass the address of begining.
-    res += I2C_Write(&this->I2C,
-                     this->address,
-                     REGISTER_NONINCREMENT(GPIO1_OUTPUT_FUNCTION),
-                     buf + 2 * sizeof(buf[0]),
-                     8);
+    // Since eight registers are contigous, they're sent as a single auto-incremented burst.
+    res += this->WriteRegisters(
+        &Transaction, GPIO_FUNCTIONS::Register, &buf[2], GPIO_FUNCTIONS::Length);
+    res += this->Submit(&Transaction);
 
     if(res != 0)
         return -11;
@@ -409,7 +863,7 @@ int PCM5252::ReadGPIOInput(int* const GPIOInputStatus)
     int res = 0;
     int buf = 0;
 
-    res += this->SelectPage(PAGE_0);
+    res += this->SelectPage(GPIO_INPUT_VALUES.Page);
     res += I2C_Read(&this->I2C, this->address, REGISTER_NONINCREMENT(GPIO_INPUT_VALUES), &buf);
 
     if(res != 0)
@@ -430,42 +884,36 @@ int PCM5252::ConfigureI2S(const int BCKPolarity,
                           const int I2SWordLength,
                           const int I2SDataShift)
 {
-    if((0x00 > FSSpeedMode) | (FSSpeedMode > 0x03))
+    if(!FSSP::Valid(FSSpeedMode))
         return -1;
-    if((0x00 > I2SDataFormat) | (I2SDataFormat > 0x03))
+    if(!AFMT::Valid(I2SDataFormat))
         return -2;
-    if((0x00 > I2SWordLength) | (I2SWordLength > 0x03))
+    if(!ALEN::Valid(I2SWordLength))
         return -3;
     if((0x00 > I2SDataShift) | (I2SDataShift > 0xFF))
         return -4;
 
     int res = 0;
-    int buf[5] = {0};
-
-    buf[0] = (bool)BCKPolarity;
-    buf[0] = buf[0] << 1 | (bool)BCKOutputEnable;
-    buf[0] = buf[0] << 4 | (bool)LRCLKOutputEnable; // R9
+    uint8_t buf[5] = {0};
 
-    buf[1] = (bool)MasterModeBCKDivider;
-    buf[1] = buf[1] << 1 | (bool)MasterModeLRCLKDivider; // R12
-
-    buf[2] = (bool)Enable16xInterpolation;
-    buf[2] = buf[2] << 4 | FSSpeedMode; // R34
-
-    buf[3] = I2SDataFormat;
-    buf[3] = buf[3] << 4 | I2SWordLength; // R40
+    using I2S_FORMAT = REG_Burst<I2S_CONFIG, I2S_OFFSET>;
 
+    buf[0] = REG_Pack<BCKP, BCKO, LRKO>(BCKPolarity, BCKOutputEnable, LRCLKOutputEnable); // R9
+    buf[1] = REG_Pack<RBCK, RLRK>(MasterModeBCKDivider, MasterModeLRCLKDivider); // R12
+    buf[2] = REG_Pack<I16E, FSSP>(Enable16xInterpolation, FSSpeedMode); // R34
+    buf[3] = REG_Pack<AFMT, ALEN>(I2SDataFormat, I2SWordLength); // R40
     buf[4] = I2SDataShift; // R41
 
     // Writes
-    res += this->SelectPage(PAGE_0);
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(I2S_CLOCK_CONFIG), &buf[0]);
-    res +=
-        I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(MASTER_MODE_CONTROL), &buf[1]);
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(FS_SPEED), &buf[2]);
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+    res += this->WriteRegisters(&Transaction, I2S_CLOCK_CONFIG, &buf[0], 1);
+    res += this->WriteRegisters(&Transaction, MASTER_MODE_CONTROL, &buf[1], 1);
+    res += this->WriteRegisters(&Transaction, FS_SPEED, &buf[2], 1);
 
-    // Since two registers are contigous, we iterate over them inside of the I2C_Write function. We only pass the address of begining.
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(I2S_CONFIG), &buf[3], 2);
+    // Since two registers are contigous, they're sent as a single auto-incremented burst.
+    res += this->WriteRegisters(&Transaction, I2S_FORMAT::Register, &buf[3], I2S_FORMAT::Length);
+    res += this->Submit(&Transaction);
 
     if(res != 0)
         return -5;
@@ -482,29 +930,26 @@ int PCM5252::ConfigureAnalogOutput(const int OutputAmplitudeMode,
                                    const int VCOMPowerDown)
 {
     int res = 0;
-    int buf[6] = {0};
-
-    buf[0] = (bool)OutputAmplitudeMode; // R1
-
-    buf[1] = (bool)LeftAnalogGain;
-    buf[1] = buf[1] << 4 | (bool)RightAnalogGain; // R2
-
-    buf[2] = (bool)AnalogMute; // R6
-
-    buf[3] = (bool)LeftAnalogBoost;
-    buf[3] = buf[3] << 4 | (bool)RightAnalogBoost; // R7
-
-    buf[4] = (bool)VCOMRampUp; // R8
-
-    buf[5] = (bool)VCOMPowerDown; // R9
-
-    res += this->SelectPage(PAGE_1);
-    res +=
-        I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(OUTPUT_AMPLITUDE_REF), &buf[0]);
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(ANALOG_GAIN), &buf[1]);
-
-    // Since four registers are contigous, we iterate over them inside of the I2C_Write function. We only pass the address of begining.
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(ANALOG_MUTE), &buf[2], 4);
+    uint8_t buf[6] = {0};
+
+    using ANALOG_GAINS = REG_Burst<OUTPUT_AMPLITUDE_REF, ANALOG_GAIN>;
+    using ANALOG_CONTROLS = REG_Burst<ANALOG_MUTE, ANALOG_GAIN_BOOST, VCOM_RAMP, VCOM_POWER>;
+
+    buf[0] = AOSL::Pack(OutputAmplitudeMode); // R1
+    buf[1] = REG_Pack<LAGN, RAGN>(LeftAnalogGain, RightAnalogGain); // R2
+    buf[2] = RCMP::Pack(AnalogMute); // R6
+    buf[3] = REG_Pack<AGBL, AGBR>(LeftAnalogBoost, RightAnalogBoost); // R7
+    buf[4] = RCMF::Pack(VCOMRampUp); // R8
+    buf[5] = VCPD::Pack(VCOMPowerDown); // R9
+
+    // Since registers R1 and R2 are contigous, as R6 to R9, they're sent as two auto-incremented bursts.
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+    res += this->WriteRegisters(
+        &Transaction, ANALOG_GAINS::Register, &buf[0], ANALOG_GAINS::Length);
+    res += this->WriteRegisters(
+        &Transaction, ANALOG_CONTROLS::Register, &buf[2], ANALOG_CONTROLS::Length);
+    res += this->Submit(&Transaction);
 
     if(res != 0)
         return -1;
@@ -518,37 +963,33 @@ int PCM5252::ConfigureDAC(const int DACClockSource,
                           const int DACArchitecture,
                           const int RequestSync)
 {
-    if((0 > DACClockSource) | (DACClockSource > 0x04))
+    if(!SDAC::Valid(DACClockSource) | (DACClockSource > 0x04))
         return -1;
-    if((0 > LeftDataSource) | (LeftDataSource > 0x03))
+    if(!AUPL::Valid(LeftDataSource))
         return -2;
-    if((0 > RightDataSource) | (RightDataSource > 0x03))
+    if(!AUPR::Valid(RightDataSource))
         return -3;
-    if((0 > DigitalVolumeMode) | (DigitalVolumeMode > 0x03))
+    if(!PCTL::Valid(DigitalVolumeMode))
         return -3;
 
     int res = 0;
-    int buf[5] = {0};
-
-    buf[0] = DACClockSource << 4; // R14
-
-    buf[1] = LeftDataSource;
-    buf[1] = buf[1] << 4 | RightDataSource; // R42
-
-    buf[2] = DigitalVolumeMode; // R60
+    uint8_t buf[5] = {0};
 
-    buf[3] = (bool)DACArchitecture; // R121
-
-    buf[4] = (bool)RequestSync; // R19
+    buf[0] = SDAC::Pack(DACClockSource); // R14
+    buf[1] = REG_Pack<AUPL, AUPR>(LeftDataSource, RightDataSource); // R42
+    buf[2] = PCTL::Pack(DigitalVolumeMode); // R60
+    buf[3] = DAMD::Pack(DACArchitecture); // R121
+    buf[4] = RQSY::Pack(RequestSync); // R19
 
     // Writes
-    res += this->SelectPage(PAGE_0);
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(DAC_CLOCK_SOURCE), &buf[0]);
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(AUDIO_DATA_PATH), &buf[1]);
-    res +=
-        I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(GLOBAL_DIGITAL_VOLUME), &buf[2]);
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(DAC_ARCHITECTURE), &buf[3]);
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(DAC_RESYNC), &buf[4]);
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+    res += this->WriteRegisters(&Transaction, DAC_CLOCK_SOURCE, &buf[0], 1);
+    res += this->WriteRegisters(&Transaction, AUDIO_DATA_PATH, &buf[1], 1);
+    res += this->WriteRegisters(&Transaction, GLOBAL_DIGITAL_VOLUME, &buf[2], 1);
+    res += this->WriteRegisters(&Transaction, DAC_ARCHITECTURE, &buf[3], 1);
+    res += this->QueueWrite(&Transaction, DAC_RESYNC, &buf[4], 1); // Request, not mirrored.
+    res += this->Submit(&Transaction);
 
     if(res != 0)
         return -4;
@@ -567,49 +1008,44 @@ int PCM5252::ConfigureAutoMute(const int EnableAutoMute,
                                const int EmergencyVolumeRampDownSpeed,
                                const int EMergencyVolumeRampDownStep)
 {
-    if((0 > LeftAutoMuteDelay) | (LeftAutoMuteDelay > 0x07))
+    if(!ATML::Valid(LeftAutoMuteDelay))
         return -1;
-    if((0 > RightAutoMuteDelay) | (RightAutoMuteDelay > 0x07))
+    if(!ATMR::Valid(RightAutoMuteDelay))
         return -2;
-    if((0 > VolumeRampDownSpeed) | (VolumeRampDownSpeed > 0x03))
+    if(!VNDF::Valid(VolumeRampDownSpeed))
         return -3;
-    if((0 > VolumeRampDownStep) | (VolumeRampDownStep > 0x03))
+    if(!VNDS::Valid(VolumeRampDownStep))
         return -4;
-    if((0 > VolumeRampUpSpeed) | (VolumeRampUpSpeed > 0x03))
+    if(!VNUF::Valid(VolumeRampUpSpeed))
         return -5;
-    if((0 > VolumeRampUpStep) | (VolumeRampUpStep > 0x03))
+    if(!VNUS::Valid(VolumeRampUpStep))
         return -6;
-    if((0 > EmergencyVolumeRampDownSpeed) | (EmergencyVolumeRampDownSpeed > 0x03))
+    if(!VEDF::Valid(EmergencyVolumeRampDownSpeed))
         return -7;
-    if((0 > EMergencyVolumeRampDownStep) | (EMergencyVolumeRampDownStep > 0x03))
+    if(!VEDS::Valid(EMergencyVolumeRampDownStep))
         return -8;
 
     int res = 0;
-    int buf[4] = {0};
-
-    buf[0] = LeftAutoMuteDelay;
-    buf[0] = buf[0] << 4 | RightAutoMuteDelay; // R59
+    uint8_t buf[4] = {0};
 
-    buf[1] = VolumeRampDownSpeed;
-    buf[1] = buf[1] << 2 | VolumeRampDownStep;
-    buf[1] = buf[1] << 2 | VolumeRampUpSpeed;
-    buf[1] = buf[1] << 2 | VolumeRampUpStep; // R63
+    using VOLUME_RAMPS = REG_Burst<NORMAL_VOLUME_RAMPS, ERROR_VOLUME_RAMPS, AUTO_MUTE>;
 
-    buf[2] = EmergencyVolumeRampDownSpeed;
-    buf[2] = buf[2] << 2 | EMergencyVolumeRampDownStep;
-    buf[2] = buf[2] << 4; // R64
-
-    buf[3] = (bool)EnableAutoMute;
-    buf[3] = buf[3] << 1 | (bool)LeftEnableAutoMute;
-    buf[3] = buf[3] << 1 | (bool)RightEnableAutoMute; // R65
+    buf[0] = REG_Pack<ATML, ATMR>(LeftAutoMuteDelay, RightAutoMuteDelay); // R59
+    buf[1] = REG_Pack<VNDF, VNDS, VNUF, VNUS>(
+        VolumeRampDownSpeed, VolumeRampDownStep, VolumeRampUpSpeed, VolumeRampUpStep); // R63
+    buf[2] = REG_Pack<VEDF, VEDS>(EmergencyVolumeRampDownSpeed, EMergencyVolumeRampDownStep); // R64
+    buf[3] = REG_Pack<ACTL, AMLE, AMRE>(
+        EnableAutoMute, LeftEnableAutoMute, RightEnableAutoMute); // R65
 
     // Writes
-    res += this->SelectPage(PAGE_0);
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(AUTOMUTE_DELAY), &buf[0]);
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+    res += this->WriteRegisters(&Transaction, AUTOMUTE_DELAY, &buf[0], 1);
 
-    // Since three registers are contigous, we iterate over them inside of the I2C_Write function. We only pass the address of begining.
-    res += I2C_Write(
-        &this->I2C, this->address, REGISTER_NONINCREMENT(NORMAL_VOLUME_RAMPS), &buf[1], 3);
+    // Since three registers are contigous, they're sent as a single auto-incremented burst.
+    res += this->WriteRegisters(
+        &Transaction, VOLUME_RAMPS::Register, &buf[1], VOLUME_RAMPS::Length);
+    res += this->Submit(&Transaction);
 
     if(res != 0)
         return -10000;
@@ -624,15 +1060,18 @@ int PCM5252::ConfigureVolume(const int LeftVolume, const int RightVolume)
         return -2;
 
     int res = 0;
-    int buf[2] = {0};
+    uint8_t buf[2] = {0};
+
+    using VOLUMES = REG_Burst<LEFT_DIGITAl_VOLUME, RIGHT_DIGITAl_VOLUME>;
 
     buf[0] = LeftVolume;
     buf[1] = RightVolume;
 
-    // Writes
-    res += this->SelectPage(PAGE_0);
-    res +=
-        I2C_Write(&this->I2C, this->address, REGISTER_AUTOINCREMENT(LEFT_DIGITAl_VOLUME), buf, 2);
+    // Writes : a single message, once the page is selected.
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+    res += this->WriteRegisters(&Transaction, VOLUMES::Register, &buf[0], VOLUMES::Length);
+    res += this->Submit(&Transaction);
 
     if(res != 0)
         return -3;
@@ -655,29 +1094,29 @@ int PCM5252::ConfigureDSP(const int EnableDeEmphasis,
         return -2;
 
     int res = 0;
-    int buf[4] = {0};
+    int adaptative = 0;
+    uint8_t buf[4] = {0};
 
-    buf[0] = (bool)EnableDeEmphasis;
-    buf[0] = buf[0] << 4 | (bool)SelectSDOUT; // R7
+    buf[0] = REG_Pack<DEMP, SDSL>(EnableDeEmphasis, SelectSDOUT); // R7
 
     buf[1] = GPIOInput; // R10
 
     buf[2] = DSPProgramSelection; // R43
 
-    // Writes
-    res += this->SelectPage(PAGE_0);
-    res += I2C_Write(&this->I2C, this->address, REGISTER_AUTOINCREMENT(SDOUT_EMPHASIS), &buf[0]);
-    res += I2C_Write(&this->I2C, this->address, REGISTER_AUTOINCREMENT(DSP_INPUT), &buf[1]);
-    res +=
-        I2C_Write(&this->I2C, this->address, REGISTER_AUTOINCREMENT(DSP_PROGRAM_SELECT), &buf[2]);
+    // Read-modify-write of P44 R1, served by the shadow once known. ACRS is cleared : the value may have been read
+    // while a CRAM switch was pending, and writing it back would request another one.
+    res += this->ReadRegister(DSP_ADAPTATIVE, &adaptative);
+    adaptative = ACRS::Update(adaptative, 0);
+    buf[3] = AMCE::Update(adaptative, EnableAdaptativeMode);
 
-    res += this->SelectPage(PAGE_44); // R1
-    res += I2C_Read(&this->I2C, this->address, REGISTER_NONINCREMENT(DSP_ADAPTATIVE), &buf[3]);
-    if((bool)EnableAdaptativeMode)
-        buf[3] = buf[3] | 0x04; // Set the 3rd bit to '1'
-    else
-        buf[3] = buf[3] & 0xFB; // Set the 3rd bit to '0'
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(DSP_ADAPTATIVE), &buf[3]);
+    // Writes
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+    res += this->WriteRegisters(&Transaction, SDOUT_EMPHASIS, &buf[0], 1);
+    res += this->WriteRegisters(&Transaction, DSP_INPUT, &buf[1], 1);
+    res += this->WriteRegisters(&Transaction, DSP_PROGRAM_SELECT, &buf[2], 1);
+    res += this->WriteRegisters(&Transaction, DSP_ADAPTATIVE, &buf[3], 1);
+    res += this->Submit(&Transaction);
 
     if(res != 0)
         return -3;
@@ -692,38 +1131,39 @@ int PCM5252::ConfigureExternalInterpolationFilter(const int Enable,
                                                   const int GPIO5OutputFunction,
                                                   const int GPIO6OutputFunction)
 {
-    if((0 > GPIO1OutputFunction) | (GPIO1OutputFunction > 0x07))
+    if(!G1SL::Valid(GPIO1OutputFunction))
         return -1;
-    if((0 > GPIO2OutputFunction) | (GPIO2OutputFunction > 0x07))
+    if(!G2SL::Valid(GPIO2OutputFunction))
         return -3;
-    if((0 > GPIO3OutputFunction) | (GPIO3OutputFunction > 0x07))
+    if(!G3SL::Valid(GPIO3OutputFunction))
         return -3;
-    if((0 > GPIO4OutputFunction) | (GPIO4OutputFunction > 0x07))
+    if(!G4SL::Valid(GPIO4OutputFunction))
         return -4;
-    if((0 > GPIO5OutputFunction) | (GPIO5OutputFunction > 0x07))
+    if(!G5SL::Valid(GPIO5OutputFunction))
         return -5;
-    if((0 > GPIO6OutputFunction) | (GPIO6OutputFunction > 0x07))
+    if(!G6SL::Valid(GPIO6OutputFunction))
         return -6;
 
     int res = 0;
-    int buf[4] = {0};
-
-    buf[0] = (bool)Enable; // R122
+    uint8_t buf[4] = {0};
 
-    buf[1] = GPIO1OutputFunction;
-    buf[1] = buf[1] << 4 | GPIO2OutputFunction; // R123
+    using EXTERNAL_FILTER = REG_Burst<EXTERNAL_DIGITAL_FILTER,
+                                      GPIO12_EXTERNAL_FILTER,
+                                      GPIO34_EXTERNAL_FILTER,
+                                      GPIO56_EXTERNAL_FILTER>;
 
-    buf[2] = GPIO3OutputFunction;
-    buf[2] = buf[2] << 4 | GPIO4OutputFunction; // R124
-
-    buf[3] = GPIO5OutputFunction;
-    buf[3] = buf[3] << 4 | GPIO6OutputFunction; // R125
+    buf[0] = EXTF::Pack(Enable); // R122
+    buf[1] = REG_Pack<G1SL, G2SL>(GPIO1OutputFunction, GPIO2OutputFunction); // R123
+    buf[2] = REG_Pack<G3SL, G4SL>(GPIO3OutputFunction, GPIO4OutputFunction); // R124
+    buf[3] = REG_Pack<G5SL, G6SL>(GPIO5OutputFunction, GPIO6OutputFunction); // R125
 
     // Writes
-    res += this->SelectPage(PAGE_0);
-    // Chained writes.
-    res += I2C_Write(
-        &this->I2C, this->address, REGISTER_NONINCREMENT(EXTERNAL_DIGITAL_FILTER), buf, 4);
+    // Chained writes, as a single auto-incremented burst.
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+    res += this->WriteRegisters(
+        &Transaction, EXTERNAL_FILTER::Register, &buf[0], EXTERNAL_FILTER::Length);
+    res += this->Submit(&Transaction);
 
     if(res != 0)
         return -7;
@@ -734,14 +1174,15 @@ int PCM5252::ConfigureVoltageProtection(const int EnableXSMUTEPowerLoss,
                                         const int EnableInternalPowerLoss)
 {
     int res = 0;
-    int buf = 0;
+    uint8_t buf = 0;
 
-    buf = (bool)EnableXSMUTEPowerLoss;
-    buf = buf << 1 | (bool)EnableInternalPowerLoss; // R5
+    buf = REG_Pack<UEPD, UIPD>(EnableXSMUTEPowerLoss, EnableInternalPowerLoss); // R5
 
     // Writes
-    res += this->SelectPage(PAGE_1);
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(EXTERNAL_UVP), &buf);
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+    res += this->WriteRegisters(&Transaction, EXTERNAL_UVP, &buf, 1);
+    res += this->Submit(&Transaction);
 
     if(res != 0)
         return -1;
@@ -758,21 +1199,21 @@ int PCM5252::ConfigureClockErrors(const int AutoClockSet,
                                   const int ClockMissingDelay,
                                   const int AdvancedClock)
 {
-    if((0 > ClockMissingDelay) | (ClockMissingDelay > 0x07))
+    if(!CMDP::Valid(ClockMissingDelay))
         return -1;
 
     int res = 0;
-    int buf[4] = {0};
+    uint8_t buf[4] = {0};
 
-    buf[0] = (bool)IgnoreFSDetection;
-    buf[0] = buf[0] << 1 | (bool)IgnoreBCKDetection;
-    buf[0] = buf[0] << 1 | (bool)IgnoreSCKDetection;
-    buf[0] = buf[0] << 1 | (bool)IgnoreClockHaltDetection;
-    buf[0] = buf[0] << 1 | (bool)IgnoreLRCLKBCKDetection;
-    buf[0] = buf[0] << 1 | (bool)AutoClockSet;
-    buf[0] = buf[0] << 1 | (bool)IgnorePLLUnlocks; // R37
+    buf[0] = REG_Pack<IDFS, IDBK, IDSK, IDCH, IDCM, DCAS, IPLK>(IgnoreFSDetection,
+                                                                IgnoreBCKDetection,
+                                                                IgnoreSCKDetection,
+                                                                IgnoreClockHaltDetection,
+                                                                IgnoreLRCLKBCKDetection,
+                                                                AutoClockSet,
+                                                                IgnorePLLUnlocks); // R37
 
-    buf[1] = ClockMissingDelay; // R44
+    buf[1] = CMDP::Pack(ClockMissingDelay); // R44
 
     if((bool)AdvancedClock) // Values given according the datasheet.
     {
@@ -785,14 +1226,15 @@ int PCM5252::ConfigureClockErrors(const int AutoClockSet,
         buf[3] = 0x00;
     }
 
-    // Writes
-    res += this->SelectPage(PAGE_0);
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(IGNORE_DETECTION), &buf[0]);
-    res +=
-        I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(CLOCK_MISSING_DETECT), &buf[1]);
+    using CLOCK_FLEX = REG_Burst<CLOCK_FLEX_1, CLOCK_FLEX_2>;
 
-    res += this->SelectPage(PAGE_44);
-    res += I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(CLOCK_FLEX_1), &buf[2], 2);
+    // Writes : both pages are handled within the same transaction.
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+    res += this->WriteRegisters(&Transaction, IGNORE_DETECTION, &buf[0], 1);
+    res += this->WriteRegisters(&Transaction, CLOCK_MISSING_DETECT, &buf[1], 1);
+    res += this->WriteRegisters(&Transaction, CLOCK_FLEX::Register, &buf[2], CLOCK_FLEX::Length);
+    res += this->Submit(&Transaction);
 
     if(res != 0)
         return -2;
@@ -816,7 +1258,7 @@ int PCM5252::ConfigureClockDividers(
         return -6;
 
     int res = 0;
-    int buf[6] = {0};
+    uint8_t buf[6] = {0};
 
     buf[0] = DSP; // R27
     buf[1] = DDAC; // R28
@@ -825,12 +1267,18 @@ int PCM5252::ConfigureClockDividers(
     buf[4] = BCK; // R32 WARNING GAP HERE !
     buf[5] = LRLCK; // R33
 
+    using CLOCK_DIVIDERS =
+        REG_Burst<DSP_CLOCK_DIVIDER, DAC_CLOCK_DIVIDER, NCP_CLOCK_DIVIDER, OSR_CLOCK_DIVIDER>;
+    using MASTER_DIVIDERS = REG_Burst<MASTER_BCK_DIVIDER, LRCK_DIVIDER>;
+
     // Writes
-    res += this->SelectPage(PAGE_0);
-    res +=
-        I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(DSP_CLOCK_DIVIDER), &buf[0], 4);
-    res +=
-        I2C_Write(&this->I2C, this->address, REGISTER_NONINCREMENT(MASTER_BCK_DIVIDER), &buf[4], 2);
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+    res += this->WriteRegisters(
+        &Transaction, CLOCK_DIVIDERS::Register, &buf[0], CLOCK_DIVIDERS::Length);
+    res += this->WriteRegisters(
+        &Transaction, MASTER_DIVIDERS::Register, &buf[4], MASTER_DIVIDERS::Length);
+    res += this->Submit(&Transaction);
 
     if(res != 0)
         return -7;
@@ -841,81 +1289,96 @@ int PCM5252::ConfigureDSPCoefficientBuffer(const DAC_BUFFER Buffer,
                                            int* const Values,
                                            const size_t CoeffNumber)
 {
-    if(CoeffNumber > 255)
+    if((Buffer != DAC_BUFFER::A) & (Buffer != DAC_BUFFER::B))
+        return -1;
+    if(CoeffNumber > COEFFICIENT_PAGES * DSP_WORDS_PER_PAGE)
         return -2;
 
-    int res = 0;
-    int buf[3] = {0};
-    int temp = 0;
-    int coeff = 1;
-
-    // First, we iterate over the pages.
-    for(int page = (int)Buffer; page < (int)Buffer + 9; page++)
+    // The whole buffer is formatted first, then sent as a burst per page.
+    uint8_t Words[COEFFICIENT_PAGES * DSP_WORDS_PER_PAGE * COEFFICIENT_WIDTH];
+    for(size_t i = 0; i < CoeffNumber; i++)
     {
-        res += this->SelectPage(page);
-        // Then, we iterate over each coefficients.
-        for(int coefficient = 0; coefficient < 30; coefficient++)
-        {
-            temp = *(Values + (page * 30 + coefficient) * sizeof(int));
-
-            // We write the MSB first
-            buf[0] = temp & 0x00FF0000;
-            buf[1] = temp & 0x0000FF00;
-            buf[2] = temp & 0x000000FF;
-
-            res += I2C_Write(
-                &this->I2C, this->address, REGISTER_NONINCREMENT(((coefficient * 4) + 8)), buf, 3);
-            coeff++;
-
-            // Check if we reached the end coefficient, or the end of the provided list.
-            if((coeff == (int)CoeffNumber) | (coeff == 255))
-            {
-                if(res != 0)
-                    return -3;
-                return 0;
-            }
-        }
+        Words[i * 3 + 0] = (uint8_t)((Values[i] >> 16) & 0xFF);
+        Words[i * 3 + 1] = (uint8_t)((Values[i] >> 8) & 0xFF);
+        Words[i * 3 + 2] = (uint8_t)(Values[i] & 0xFF);
     }
-    return -4;
+
+    if(this->WriteDSPCoefficients(Buffer, 0, Words, (int)CoeffNumber) != 0)
+        return -3;
+    return 0;
 }
 
 int PCM5252::ConfigureDSPIntructions(int* const Instructions, const size_t InstrNumber)
 {
-    if(InstrNumber > 1023)
+    if(InstrNumber > INSTRUCTION_PAGES * DSP_WORDS_PER_PAGE)
         return -1;
 
-    int res = 0;
-    int buf[4] = {0};
-    int temp = 0;
-    int instr = 1;
+    // The whole program is formatted first, then sent as a burst per page.
+    uint8_t* Words = (uint8_t*)malloc(InstrNumber * INSTRUCTION_WIDTH + 1);
+    if(Words == nullptr)
+        return -3;
 
-    // First, we iterate over the pages.
-    for(int page = 0x7D; page < 0xB1; page++)
+    for(size_t i = 0; i < InstrNumber; i++)
     {
-        res += this->SelectPage(page);
-        // Then, we iterate over each instruction.
-        for(int instruction = 0; instruction < 30; instruction++)
-        {
-            temp = *(Instructions + ((page * 30) + instruction) * sizeof(int));
-            buf[0] = temp & 0xFF000000;
-            buf[1] = temp & 0x00FF0000;
-            buf[2] = temp & 0x0000FF00;
-            buf[2] = temp & 0x000000FF;
-
-            res += I2C_Write(
-                &this->I2C, this->address, REGISTER_NONINCREMENT(((instruction * 4) + 8)), buf, 4);
-            instr++;
-
-            // Check if we reached the end instruction, or the end of the provided list.
-            if((instr == (int)InstrNumber) | (instr == 1023))
-            {
-                if(res != 0)
-                    return -2;
-                return 0;
-            }
-        }
+        Words[i * 4 + 0] = (uint8_t)((Instructions[i] >> 24) & 0xFF);
+        Words[i * 4 + 1] = (uint8_t)((Instructions[i] >> 16) & 0xFF);
+        Words[i * 4 + 2] = (uint8_t)((Instructions[i] >> 8) & 0xFF);
+        Words[i * 4 + 3] = (uint8_t)(Instructions[i] & 0xFF);
     }
-    return -3;
+
+    int res = this->WriteDSPInstructions(0, Words, (int)InstrNumber);
+    free(Words);
+
+    if(res != 0)
+        return -2;
+    return 0;
+}
+
+int PCM5252::WriteDSPCoefficients(const DAC_BUFFER Buffer,
+                                  const int First,
+                                  const uint8_t* const Values,
+                                  const int Count)
+{
+    if((Buffer != DAC_BUFFER::A) & (Buffer != DAC_BUFFER::B))
+        return -1;
+
+    const int Bank = (Buffer == DAC_BUFFER::A) ? 0 : 1;
+    return this->WriteDSPWords((int)Buffer,
+                               COEFFICIENT_PAGES,
+                               COEFFICIENT_WIDTH,
+                               this->CoefficientImage[Bank],
+                               this->CoefficientKnown[Bank],
+                               First,
+                               Values,
+                               Count);
+}
+
+int PCM5252::WriteDSPInstructions(const int First, const uint8_t* const Values, const int Count)
+{
+    return this->WriteDSPWords(INSTRUCTION_PAGE,
+                               INSTRUCTION_PAGES,
+                               INSTRUCTION_WIDTH,
+                               this->InstructionImage,
+                               this->InstructionKnown,
+                               First,
+                               Values,
+                               Count);
+}
+
+void PCM5252::InvalidateDSPImage()
+{
+    memset(this->CoefficientKnown, 0x00, sizeof(this->CoefficientKnown));
+    memset(this->InstructionKnown, 0x00, sizeof(this->InstructionKnown));
+}
+
+DAC_UPLOAD_STATISTICS PCM5252::GetUploadStatistics() const
+{
+    return this->Upload;
+}
+
+void PCM5252::ResetUploadStatistics()
+{
+    this->Upload = DAC_UPLOAD_STATISTICS{};
 }
 
 // READ BACK FUNCTIONS
@@ -936,44 +1399,41 @@ int PCM5252::ReadClockStatus(int* const DetectedBCKRatio,
                              int* const DetectedSCK)
 {
     int res = 0;
-    int buf[6] = {0};
-
-    res += this->SelectPage(PAGE_0);
-    res += I2C_Read(
-        &this->I2C, this->address, REGISTER_NONINCREMENT(DETECTED_BCK_RATIO_MSB), &buf[0]); // R92
-    res += I2C_Read(
-        &this->I2C, this->address, REGISTER_NONINCREMENT(DETECTED_BCK_RATIO_LSB), &buf[1]); // R93
-    res += I2C_Read(
-        &this->I2C, this->address, REGISTER_NONINCREMENT(CLOCK_SYSTEM_STATUS), &buf[2]); // R94
-    res += I2C_Read(
-        &this->I2C, this->address, REGISTER_NONINCREMENT(CLOCK_SYSTEM_ERRORS), &buf[3]); // R95
-    res += I2C_Read(
-        &this->I2C, this->address, REGISTER_NONINCREMENT(FS_SPEED_MONITOR), &buf[4]); // R115
-    res += I2C_Read(
-        &this->I2C, this->address, REGISTER_NONINCREMENT(DETECTED_AUDIO_SPECS), &buf[5]); // R91
+    uint8_t buf[6] = {0};
+    uint8_t page = PAGE_0;
+
+    // R91 to R95 are contigous, and read as a single burst. Page selection and reads are combined.
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+    res += this->SelectPage(&Transaction, &page);
+    res += I2C_TransactionRead(
+        &Transaction, this->address, REGISTER_AUTOINCREMENT(DETECTED_AUDIO_SPECS), &buf[0], 5);
+    res += I2C_TransactionRead(
+        &Transaction, this->address, REGISTER_NONINCREMENT(FS_SPEED_MONITOR), &buf[5], 1);
+    res += this->Submit(&Transaction);
 
     if(res != 0)
         return -1;
 
-    *DetectedBCKRatio = buf[0] << 8 | buf[1];
+    *DetectedBCKRatio = buf[1] << 8 | buf[2]; // R92 - R93
 
-    *SCKPresent = (buf[2] & 0x40) >> 6;
-    *PLLLocked = (buf[2] & 0x20) >> 5;
-    *LRCLKBCKPresent = (buf[2] & 0x10) >> 4;
-    *SCKRatio = (buf[2] & 0x08) >> 3;
-    *SCKRatioValid = (buf[2] & 0x04) >> 2;
-    *BCKValid = (buf[2] & 0x02) >> 1;
-    *FSValid = buf[2] & 0x01;
+    *SCKPresent = (buf[3] & 0x40) >> 6; // R94
+    *PLLLocked = (buf[3] & 0x20) >> 5;
+    *LRCLKBCKPresent = (buf[3] & 0x10) >> 4;
+    *SCKRatio = (buf[3] & 0x08) >> 3;
+    *SCKRatioValid = (buf[3] & 0x04) >> 2;
+    *BCKValid = (buf[3] & 0x02) >> 1;
+    *FSValid = buf[3] & 0x01;
 
-    *LatchedClockHalt = (buf[3] & 0x10) >> 4;
-    *ClockMissing = (buf[3] & 0x04) >> 2;
-    *ClockResync = (buf[3] & 0x02) >> 1;
-    *ClockError = buf[3] & 0x01;
+    *LatchedClockHalt = (buf[4] & 0x10) >> 4; // R95
+    *ClockMissing = (buf[4] & 0x04) >> 2;
+    *ClockResync = (buf[4] & 0x02) >> 1;
+    *ClockError = buf[4] & 0x01;
 
-    *FSSpeedMonitor = buf[4] & 0x03;
+    *FSSpeedMonitor = buf[5] & 0x03; // R115
 
-    *DetectedFS = (buf[5] & 0x70) >> 4;
-    *DetectedSCK = buf[5] & 0x0F;
+    *DetectedFS = (buf[0] & 0x70) >> 4; // R91
+    *DetectedSCK = buf[0] & 0x0F;
 
     return 0;
 }
@@ -1038,8 +1498,8 @@ int PCM5252::ReadDSPStatus(int* const DSPBootStatus,
 
     *IDAC = buf[2] << 8 | buf[3];
 
-    *ActiveCRAM = (buf[4] & 0x02) >> 1;
-    *UsedCRAM = (buf[4] & 0x08) >> 3;
+    *ActiveCRAM = ACRM::Extract(buf[4]);
+    *UsedCRAM = AMDC::Extract(buf[4]);
 
     return 0;
 }
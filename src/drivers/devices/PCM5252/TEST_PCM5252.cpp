@@ -0,0 +1,300 @@
+/**
+ * @file TEST_PCM5252.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Source for unittesting the register shadow of the PCM5252 driver, over a simulated bus.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+
+// Including the unit test framework
+#include "CppUTest/TestHarness.h"
+
+// Include the tested header
+#include "drivers/devices/PCM5252.hpp"
+#include "drivers/peripherals/core/I2C_Simulator.hpp"
+#include "drivers/peripherals/i2c.hpp"
+
+// STD
+#include <cstring>
+
+// ==============================================================================
+// MODELS
+// ==============================================================================
+
+// A DAC modeled by it's pages : register 0 select the page, the MSB of the command enable the auto-increment.
+class PCM5252_Model : public I2C_DeviceModel
+{
+public:
+    uint8_t Pages[256][128] = {};
+    int Page = 0;
+    int Pointer = 0;
+    bool Increment = false;
+
+    int Write(const uint8_t* const Data, const int Size) override
+    {
+        if(Size <= 0)
+            return 0;
+
+        this->Pointer = Data[0] & 0x7F;
+        this->Increment = (Data[0] & 0x80) != 0;
+        for(int i = 1; i < Size; i++)
+        {
+            if(this->Pointer == 0)
+                this->Page = Data[i];
+            else
+                this->Pages[this->Page][this->Pointer] = Data[i];
+            if(this->Increment)
+                this->Pointer = (this->Pointer + 1) & 0x7F;
+        }
+        return 0;
+    }
+
+    int Read(uint8_t* const Data, const int Size) override
+    {
+        for(int i = 0; i < Size; i++)
+        {
+            Data[i] = (this->Pointer == 0) ? this->Page : this->Pages[this->Page][this->Pointer];
+            if(this->Increment)
+                this->Pointer = (this->Pointer + 1) & 0x7F;
+        }
+        return 0;
+    }
+};
+
+// ==============================================================================
+// TEST GROUPS
+// ==============================================================================
+
+// A single DAC, modeled as a plain register file.
+TEST_GROUP(PCM5252_Shadow)
+{
+    I2C_SimulatedBus* Simulator;
+    I2C_RegisterFile* Registers;
+    I2C_Bus* Bus;
+    PCM5252* Dac;
+
+    void setup()
+    {
+        Simulator = new I2C_SimulatedBus();
+        Registers = new I2C_RegisterFile(1, true);
+        Simulator->Attach((int)DAC::DAC_0, Registers);
+        Bus = I2C_Open(Simulator);
+        Dac = new PCM5252(Bus, DAC::DAC_0);
+    }
+    void teardown()
+    {
+        delete Dac;
+        I2C_Close(Bus);
+        delete Registers;
+    }
+};
+
+// A single DAC, modeled with it's pages.
+TEST_GROUP(PCM5252_CRAM)
+{
+    I2C_SimulatedBus* Simulator;
+    PCM5252_Model* Model;
+    I2C_Bus* Bus;
+    PCM5252* Dac;
+
+    void setup()
+    {
+        Simulator = new I2C_SimulatedBus();
+        Model = new PCM5252_Model();
+        Simulator->Attach((int)DAC::DAC_0, Model);
+        Bus = I2C_Open(Simulator);
+        Dac = new PCM5252(Bus, DAC::DAC_0);
+    }
+    void teardown()
+    {
+        delete Dac;
+        I2C_Close(Bus);
+        delete Model;
+    }
+};
+
+// ==============================================================================
+// TESTS
+// ==============================================================================
+
+TEST(PCM5252_Shadow, PageIsOnlySelectedOnce)
+{
+    // First access : page selection and volume burst, in a single transfer.
+    LONGS_EQUAL(0, Dac->ConfigureVolume(0x30, 0x30));
+    UNSIGNED_LONGS_EQUAL(1, Simulator->GetStatistics().Transfers);
+    UNSIGNED_LONGS_EQUAL(2, Simulator->GetStatistics().Messages);
+
+    // Then, a single message per call.
+    Simulator->ResetStatistics();
+    LONGS_EQUAL(0, Dac->ConfigureVolume(0x40, 0x40));
+    LONGS_EQUAL(0, Dac->Mute(1, 1));
+    UNSIGNED_LONGS_EQUAL(2, Simulator->GetStatistics().Transfers);
+    UNSIGNED_LONGS_EQUAL(2, Simulator->GetStatistics().Messages);
+}
+
+TEST(PCM5252_Shadow, ReadModifyWriteUseTheShadow)
+{
+    LONGS_EQUAL(0, Dac->ConfigureDSP(0, 0, 0, 1, 1));
+    unsigned long Reads = Simulator->GetStatistics().Transfers;
+
+    // P44 R1 is now known : the second call is a single transfer, without read.
+    LONGS_EQUAL(0, Dac->ConfigureDSP(0, 0, 0, 1, 0));
+    UNSIGNED_LONGS_EQUAL(Reads + 1, Simulator->GetStatistics().Transfers);
+}
+
+TEST(PCM5252_Shadow, FlushOnlySendChangedRegisters)
+{
+    LONGS_EQUAL(0, Dac->ConfigureVolume(0x30, 0x30));
+    Simulator->ResetStatistics();
+
+    // Nothing is sent until the flush.
+    LONGS_EQUAL(0, Dac->SetWriteMode(DAC_WRITE::DEFERRED));
+    LONGS_EQUAL(0, Dac->ConfigureVolume(0x30, 0x50));
+    LONGS_EQUAL(0, Dac->Mute(0, 1));
+    UNSIGNED_LONGS_EQUAL(0, Simulator->GetStatistics().Transfers);
+
+    // R3 (mute) and R62 (right volume) only, the left volume is unchanged.
+    LONGS_EQUAL(0, Dac->Flush());
+    UNSIGNED_LONGS_EQUAL(1, Simulator->GetStatistics().Transfers);
+    UNSIGNED_LONGS_EQUAL(2, Simulator->GetStatistics().Messages);
+    LONGS_EQUAL(0x01, Registers->Peek(0x03));
+    LONGS_EQUAL(0x50, Registers->Peek(0x3E));
+
+    // Nothing left.
+    Simulator->ResetStatistics();
+    LONGS_EQUAL(0, Dac->SetWriteMode(DAC_WRITE::THROUGH));
+    UNSIGNED_LONGS_EQUAL(0, Simulator->GetStatistics().Transfers);
+}
+
+TEST(PCM5252_CRAM, CoefficientsAreWroteAsPageBursts)
+{
+    uint8_t Values[40 * 3];
+    for(int i = 0; i < (int)sizeof(Values); i++)
+        Values[i] = (uint8_t)(i + 1);
+
+    // Coefficients 25 to 64 : the end of page 44, all of page 45 and the start of page 46. A single transfer, with
+    // a page selection and a burst per page.
+    LONGS_EQUAL(0, Dac->WriteDSPCoefficients(DAC_BUFFER::A, 25, Values, 40));
+    UNSIGNED_LONGS_EQUAL(1, Simulator->GetStatistics().Transfers);
+    UNSIGNED_LONGS_EQUAL(6, Simulator->GetStatistics().Messages);
+
+    MEMCMP_EQUAL(&Values[0], &Model->Pages[0x2C][8 + 25 * 4], 3);
+    MEMCMP_EQUAL(&Values[5 * 3], &Model->Pages[0x2D][8], 3);
+    MEMCMP_EQUAL(&Values[39 * 3], &Model->Pages[0x2E][8 + 4 * 4], 3);
+    LONGS_EQUAL(0x00, Model->Pages[0x2D][8 + 3]);
+}
+
+TEST(PCM5252_CRAM, InstructionsAreWrotePerPage)
+{
+    uint8_t Values[2 * 4] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+
+    LONGS_EQUAL(0, Dac->WriteDSPInstructions(29, Values, 2));
+    MEMCMP_EQUAL(&Values[0], &Model->Pages[0x7D][8 + 29 * 4], 4);
+    MEMCMP_EQUAL(&Values[4], &Model->Pages[0x7E][8], 4);
+}
+
+TEST(PCM5252_CRAM, OutOfRangeWordsAreRejected)
+{
+    uint8_t Values[4] = {0};
+
+    LONGS_EQUAL(-1, Dac->WriteDSPCoefficients(DAC_BUFFER::B, 270, Values, 1));
+    LONGS_EQUAL(-1, Dac->WriteDSPInstructions(-1, Values, 1));
+    UNSIGNED_LONGS_EQUAL(0, Simulator->GetStatistics().Transfers);
+}
+
+TEST(PCM5252_CRAM, FullProgramIsPackedOnFewTransfers)
+{
+    int Coefficients[270];
+    for(int i = 0; i < 270; i++)
+        Coefficients[i] = 0x7F0000 | i;
+    int Instructions[1024];
+    for(int i = 0; i < 1024; i++)
+        Instructions[i] = 0x10000000 | i;
+
+    // 9 pages of coefficients, 8 per transfer.
+    LONGS_EQUAL(0, Dac->ConfigureDSPCoefficientBuffer(DAC_BUFFER::B, Coefficients, 270));
+    UNSIGNED_LONGS_EQUAL(2, Simulator->GetStatistics().Transfers);
+    LONGS_EQUAL(0x7F, Model->Pages[0x3E][8]);
+    LONGS_EQUAL(0x01, Model->Pages[0x3E][8 + 4 + 2]);
+    LONGS_EQUAL(0x0D, Model->Pages[0x46][8 + 29 * 4 + 2]);
+
+    // 35 pages of instructions.
+    Simulator->ResetStatistics();
+    LONGS_EQUAL(0, Dac->ConfigureDSPIntructions(Instructions, 1024));
+    UNSIGNED_LONGS_EQUAL(5, Simulator->GetStatistics().Transfers);
+    LONGS_EQUAL(0x10, Model->Pages[0x7D][8]);
+    LONGS_EQUAL(0x03, Model->Pages[0x7D + 1023 / 30][8 + (1023 % 30) * 4 + 2]);
+    LONGS_EQUAL(0xFF, Model->Pages[0x7D + 1023 / 30][8 + (1023 % 30) * 4 + 3]);
+
+    DAC_UPLOAD_STATISTICS Upload = Dac->GetUploadStatistics();
+    UNSIGNED_LONGS_EQUAL(9 + 35, Upload.Bursts);
+    UNSIGNED_LONGS_EQUAL(2 + 5, Upload.Transfers);
+    UNSIGNED_LONGS_EQUAL(9 * 119 + 1024 * 4, Upload.Bytes);
+}
+
+TEST(PCM5252_CRAM, OnlyChangedRunsAreSent)
+{
+    uint8_t Values[270 * 3];
+    for(int i = 0; i < (int)sizeof(Values); i++)
+        Values[i] = (uint8_t)(i * 7);
+    LONGS_EQUAL(0, Dac->WriteDSPCoefficients(DAC_BUFFER::A, 0, Values, 270));
+
+    // Nothing changed, nothing sent.
+    Simulator->ResetStatistics();
+    Dac->ResetUploadStatistics();
+    LONGS_EQUAL(0, Dac->WriteDSPCoefficients(DAC_BUFFER::A, 0, Values, 270));
+    UNSIGNED_LONGS_EQUAL(0, Simulator->GetStatistics().Transfers);
+
+    // Coefficients 40, 41 and 200 : two bursts on pages 45 and 50, in a single transfer.
+    Values[40 * 3] ^= 0xFF;
+    Values[41 * 3 + 2] ^= 0xFF;
+    Values[200 * 3 + 1] ^= 0xFF;
+    LONGS_EQUAL(0, Dac->WriteDSPCoefficients(DAC_BUFFER::A, 0, Values, 270));
+    UNSIGNED_LONGS_EQUAL(1, Simulator->GetStatistics().Transfers);
+    UNSIGNED_LONGS_EQUAL(4, Simulator->GetStatistics().Messages);
+    MEMCMP_EQUAL(&Values[40 * 3], &Model->Pages[0x2D][8 + 10 * 4], 3);
+    MEMCMP_EQUAL(&Values[41 * 3], &Model->Pages[0x2D][8 + 11 * 4], 3);
+    MEMCMP_EQUAL(&Values[200 * 3], &Model->Pages[0x32][8 + 20 * 4], 3);
+
+    DAC_UPLOAD_STATISTICS Upload = Dac->GetUploadStatistics();
+    UNSIGNED_LONGS_EQUAL(2, Upload.Bursts);
+    UNSIGNED_LONGS_EQUAL(270 + 267, Upload.Skipped);
+    UNSIGNED_LONGS_EQUAL(7 + 3, Upload.Bytes);
+
+    // The other buffer is not known yet.
+    Simulator->ResetStatistics();
+    LONGS_EQUAL(0, Dac->WriteDSPCoefficients(DAC_BUFFER::B, 0, Values, 1));
+    UNSIGNED_LONGS_EQUAL(1, Simulator->GetStatistics().Transfers);
+}
+
+TEST(PCM5252_CRAM, FailedOrResetWordsAreSentAgain)
+{
+    uint8_t Values[4 * 3] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+
+    // The burst is NACKed : the words are unknown, and sent again.
+    Simulator->InjectNack((int)DAC::DAC_0, 1);
+    LONGS_EQUAL(-2, Dac->WriteDSPCoefficients(DAC_BUFFER::A, 0, Values, 4));
+    LONGS_EQUAL(0, Dac->WriteDSPCoefficients(DAC_BUFFER::A, 0, Values, 4));
+    MEMCMP_EQUAL(&Values[9], &Model->Pages[0x2C][8 + 3 * 4], 3);
+
+    // A DSP reset clear the CRAM.
+    LONGS_EQUAL(0, Dac->ConfigureReset(0, 1));
+    Simulator->ResetStatistics();
+    LONGS_EQUAL(0, Dac->WriteDSPCoefficients(DAC_BUFFER::A, 0, Values, 4));
+    UNSIGNED_LONGS_EQUAL(1, Simulator->GetStatistics().Transfers);
+}
+
+TEST(PCM5252_CRAM, PendingSwitchIsNotRequestedAgain)
+{
+    // P44 R1 is read while a CRAM switch is pending : the write back only change AMCE.
+    Model->Pages[0x2C][1] = 0x01;
+    LONGS_EQUAL(0, Dac->ConfigureDSP(0, 0, 0, 1, 1));
+    LONGS_EQUAL(0x04, Model->Pages[0x2C][1]);
+}
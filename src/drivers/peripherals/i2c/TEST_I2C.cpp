@@ -0,0 +1,482 @@
+/**
+ * @file TEST_I2C.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Source for unittesting the I2C engine, and the drivers above it, on the simulated bus.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+
+// Including the unit test framework
+#include "CppUTest/TestHarness.h"
+
+// STD
+#include <atomic>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+// Include the tested header
+#include "drivers/devices/MCP9808.hpp"
+#include "drivers/peripherals/core/I2C_Arbiter.hpp"
+#include "drivers/peripherals/core/I2C_Async.hpp"
+#include "drivers/peripherals/core/I2C_Simulator.hpp"
+#include "drivers/peripherals/core/I2C_Trace.hpp"
+#include "drivers/peripherals/i2c.hpp"
+
+// ==============================================================================
+// DEFINES
+// ==============================================================================
+#define SENSOR_ADDRESS 0x18
+
+// ==============================================================================
+// OPERATIONS
+// ==============================================================================
+
+// Hold the bus until the gate is opened : 1 once held, set to 2 to release.
+static int HoldBus([[maybe_unused]] I2C_Bus* I2C, void* Arguments)
+{
+    std::atomic<int>* Gate = (std::atomic<int>*)Arguments;
+    Gate->store(1);
+    while(Gate->load() != 2)
+        std::this_thread::yield();
+    return 0;
+}
+
+// Record the order of execution, on the worker.
+static std::vector<int> Executed;
+
+static int RecordOrder([[maybe_unused]] I2C_Bus* I2C, void* Arguments)
+{
+    Executed.push_back(*(int*)Arguments);
+    return 0;
+}
+
+static void CountCompletion(I2C_Request* Request)
+{
+    ((std::atomic<int>*)Request->User)->fetch_add(1);
+    return;
+}
+
+// Read a register, and record the thread that resumed the coroutine.
+static I2C_Task ReadRegister(I2C_Bus* I2C, const int Register, uint16_t* const Value, std::thread::id* const Resumed)
+{
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+    I2C_TransactionRead(&Transaction, SENSOR_ADDRESS, Register, (uint8_t*)Value, 2);
+
+    const int res = co_await I2C_TransactionSubmitAsync(I2C, &Transaction);
+    *Resumed = std::this_thread::get_id();
+    *Value = I2C_FromBigEndian(*Value);
+    co_return res;
+}
+
+// ==============================================================================
+// TEST GROUPS
+// ==============================================================================
+
+// A single MCP9808 like device (16 bits registers, no auto-increment) on a simulated bus.
+TEST_GROUP(I2C_SimulatedBus)
+{
+    I2C_SimulatedBus* Simulator;
+    I2C_RegisterFile* Sensor;
+    I2C_Bus* Bus;
+
+    void setup()
+    {
+        Simulator = new I2C_SimulatedBus();
+        Sensor = new I2C_RegisterFile(2, false);
+        Simulator->Attach(SENSOR_ADDRESS, Sensor);
+        Bus = I2C_Open(Simulator);
+    }
+    void teardown()
+    {
+        I2C_Close(Bus);
+        delete Sensor;
+    }
+};
+
+// The same device, with the arbiter of the bus running.
+TEST_GROUP(I2C_Arbiter)
+{
+    I2C_SimulatedBus* Simulator;
+    I2C_RegisterFile* Sensor;
+    I2C_Bus* Bus;
+
+    std::atomic<int> Gate;
+    std::atomic<int> Completed;
+    I2C_Request Requests[8];
+    int Tags[8];
+
+    void setup()
+    {
+        Simulator = new I2C_SimulatedBus();
+        Sensor = new I2C_RegisterFile(2, false);
+        Simulator->Attach(SENSOR_ADDRESS, Sensor);
+        Bus = I2C_Open(Simulator);
+        LONGS_EQUAL(0, I2C_ArbiterStart(Bus));
+
+        Gate.store(0);
+        Completed.store(0);
+        Executed.clear();
+    }
+    void teardown()
+    {
+        I2C_Close(Bus);
+        delete Sensor;
+    }
+
+    // Queue an asynchronous request through a copy of the bus, of the given class.
+    void Submit(const int Index, const I2C_PRIORITY Priority, I2C_Operation Operation, void* Arguments)
+    {
+        I2C_Bus* Copy = new I2C_Bus(*Bus);
+        I2C_SetPriority(Copy, Priority);
+
+        I2C_Request* Request = &Requests[Index];
+        Request->Operation = Operation;
+        Request->Arguments = Arguments;
+        Request->I2C = Copy;
+        Request->Result = -1;
+        Request->Complete = CountCompletion;
+        Request->User = &Completed;
+        LONGS_EQUAL(0, I2C_ArbiterSubmit(Bus, Request));
+    }
+
+    // Hold the bus with the first request, once the worker is executing it.
+    void Hold()
+    {
+        Submit(0, I2C_PRIORITY::NORMAL, HoldBus, &Gate);
+        while(Gate.load() != 1)
+            std::this_thread::yield();
+    }
+
+    // Wait for Count asynchronous requests, and release their bus copies.
+    void WaitCompletions(const int Count)
+    {
+        while(Completed.load() < Count)
+            std::this_thread::yield();
+        for(int i = 0; i < Count; i++)
+            delete Requests[i].I2C;
+    }
+};
+
+// ==============================================================================
+// TESTS (Engine)
+// ==============================================================================
+
+TEST(I2C_SimulatedBus, ReadWordsIsASingleTransfer)
+{
+    for(int i = 1; i <= 4; i++)
+        Sensor->Poke(i, 0x1200 + i);
+
+    uint16_t Words[4] = {0};
+    LONGS_EQUAL(0, I2C_ReadWords(Bus, SENSOR_ADDRESS, 1, Words, 4));
+
+    for(int i = 0; i < 4; i++)
+        LONGS_EQUAL(0x1201 + i, Words[i]);
+
+    I2C_SimulatorStatistics Statistics = Simulator->GetStatistics();
+    LONGS_EQUAL(1, Statistics.Transfers);
+    LONGS_EQUAL(8, Statistics.Messages);
+}
+
+TEST(I2C_SimulatedBus, SMBusWordsAreLittleEndian)
+{
+    int Value = 0x3412;
+    LONGS_EQUAL(0, I2C_Write(Bus, SENSOR_ADDRESS, 2, &Value, 1, 2));
+    LONGS_EQUAL(0x1234, Sensor->Peek(2));
+
+    Value = 0;
+    LONGS_EQUAL(0, I2C_Read(Bus, SENSOR_ADDRESS, 2, &Value, 1, 2));
+    LONGS_EQUAL(0x3412, Value);
+}
+
+TEST(I2C_SimulatedBus, AddressIsOnlySelectedOnce)
+{
+    int Value = 0;
+    for(int i = 0; i < 4; i++)
+        I2C_Read(Bus, SENSOR_ADDRESS, 5, &Value, 1, 2);
+
+    unsigned long Issued = 0;
+    unsigned long Saved = 0;
+    I2C_GetAddressStatistics(Bus, &Issued, &Saved);
+    LONGS_EQUAL(1, Issued);
+    LONGS_EQUAL(3, Saved);
+    LONGS_EQUAL(1, Simulator->GetStatistics().AddressSelects);
+}
+
+TEST(I2C_SimulatedBus, NackIsReported)
+{
+    uint16_t Word = 0;
+    Simulator->InjectNack(SENSOR_ADDRESS, 1);
+    LONGS_EQUAL(-5, I2C_ReadWords(Bus, SENSOR_ADDRESS, 5, &Word, 1));
+    LONGS_EQUAL(0, I2C_ReadWords(Bus, SENSOR_ADDRESS, 5, &Word, 1));
+
+    // Nobody at this address
+    LONGS_EQUAL(-5, I2C_ReadWords(Bus, SENSOR_ADDRESS + 1, 5, &Word, 1));
+    LONGS_EQUAL(2, Simulator->GetStatistics().Nacks);
+}
+
+TEST(I2C_SimulatedBus, BusTimeFollowTheClock)
+{
+    uint16_t Word = 0;
+    Simulator->SetLatency(100'000, 0, false);
+    I2C_ReadWords(Bus, SENSOR_ADDRESS, 5, &Word, 1);
+
+    // STOP, then (START + address + ACK) and 9 clocks per byte for both messages : 1 + 19 + 28 = 48 clocks at 10 us.
+    UNSIGNED_LONGS_EQUAL(480'000, Simulator->GetStatistics().BusTime);
+}
+
+#ifdef I2C_TRACE
+TEST(I2C_SimulatedBus, TraceCountPerDeviceAndRegister)
+{
+    uint16_t Word = 0;
+    I2C_ReadWords(Bus, SENSOR_ADDRESS, 5, &Word, 1);
+    I2C_ReadWords(Bus, SENSOR_ADDRESS, 5, &Word, 1);
+    Simulator->InjectNack(SENSOR_ADDRESS, 1);
+    I2C_ReadWords(Bus, SENSOR_ADDRESS, 6, &Word, 1);
+
+    I2C_TraceCounters Counters;
+    LONGS_EQUAL(0, I2C_TraceGetDevice(Bus, SENSOR_ADDRESS, &Counters));
+    LONGS_EQUAL(3, Counters.Transactions);
+    LONGS_EQUAL(9, Counters.Bytes);
+    LONGS_EQUAL(1, Counters.Errors);
+
+    LONGS_EQUAL(0, I2C_TraceGetRegister(Bus, SENSOR_ADDRESS, 5, &Counters));
+    LONGS_EQUAL(2, Counters.Transactions);
+    LONGS_EQUAL(0, Counters.Errors);
+
+    // Dump : header, then the 3 records, oldest first.
+    const char* Filename = "/tmp/TEST_I2C_trace.bin";
+    LONGS_EQUAL(0, I2C_TraceDump(Bus, Filename));
+
+    I2C_TraceHeader Header;
+    I2C_TraceRecord Records[3];
+    FILE* File = fopen(Filename, "rb");
+    CHECK(File != nullptr);
+    LONGS_EQUAL(1, fread(&Header, sizeof(Header), 1, File));
+    LONGS_EQUAL(3, fread(Records, sizeof(I2C_TraceRecord), 3, File));
+    fclose(File);
+    remove(Filename);
+
+    LONGS_EQUAL(I2C_TRACE_MAGIC, Header.Magic);
+    LONGS_EQUAL(3, Header.Count);
+    LONGS_EQUAL(5, Records[0].Register);
+    LONGS_EQUAL(6, Records[2].Register);
+    CHECK(Records[2].Result < 0);
+}
+#endif
+
+// ==============================================================================
+// TESTS (Arbiter)
+// ==============================================================================
+
+TEST(I2C_Arbiter, AccessesFromSeveralThreadsAreSerialized)
+{
+    // Each thread use it's own copy of the bus, as the drivers do, and it's own registers.
+    // The checks are done once joined, failures can't be reported from the threads.
+    std::vector<std::thread> Threads;
+    std::atomic<int> Errors(0);
+    for(int t = 0; t < 4; t++)
+    {
+        Threads.emplace_back([this, t, &Errors]() {
+            I2C_Bus Copy = *Bus;
+            for(int i = 0; i < 50; i++)
+            {
+                int Value = (t << 8) | i;
+                if(I2C_Write(&Copy, SENSOR_ADDRESS, 0x10 + t, &Value, 1, 2) != 0)
+                    Errors.fetch_add(1);
+            }
+        });
+    }
+    for(std::thread& Thread : Threads)
+        Thread.join();
+    LONGS_EQUAL(0, Errors.load());
+
+    for(int t = 0; t < 4; t++)
+    {
+        int Value = 0;
+        LONGS_EQUAL(0, I2C_Read(Bus, SENSOR_ADDRESS, 0x10 + t, &Value, 1, 2));
+        LONGS_EQUAL((t << 8) | 49, Value);
+    }
+
+    I2C_QueueStatistics Statistics;
+    LONGS_EQUAL(0, I2C_GetQueueStatistics(Bus, I2C_PRIORITY::NORMAL, &Statistics));
+    UNSIGNED_LONGS_EQUAL(4 * 50 + 4, Statistics.Requests);
+}
+
+TEST(I2C_Arbiter, ControlRequestOvertakeBackgroundPolls)
+{
+    // The bus is held while the polls, then the control request, are queued.
+    Hold();
+    for(int i = 1; i <= 4; i++)
+    {
+        Tags[i] = i;
+        Submit(i, I2C_PRIORITY::BACKGROUND, RecordOrder, &Tags[i]);
+    }
+    Tags[5] = 5;
+    Submit(5, I2C_PRIORITY::CONTROL, RecordOrder, &Tags[5]);
+
+    Gate.store(2);
+    WaitCompletions(6);
+
+    // The control request is served first, the polls keep their order.
+    const std::vector<int> Expected = {5, 1, 2, 3, 4};
+    CHECK_TRUE(Executed == Expected);
+}
+
+TEST(I2C_Arbiter, LatencyIsCountedPerClass)
+{
+    I2C_QueueStatistics Statistics;
+    LONGS_EQUAL(0, I2C_GetQueueStatistics(Bus, I2C_PRIORITY::BACKGROUND, &Statistics));
+    UNSIGNED_LONGS_EQUAL(0, Statistics.Requests);
+
+    // Two polls and a control request wait 5 ms behind the held bus.
+    Hold();
+    for(int i = 1; i <= 3; i++)
+    {
+        Tags[i] = i;
+        Submit(i, (i < 3) ? I2C_PRIORITY::BACKGROUND : I2C_PRIORITY::CONTROL, RecordOrder, &Tags[i]);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    Gate.store(2);
+    WaitCompletions(4);
+
+    LONGS_EQUAL(0, I2C_GetQueueStatistics(Bus, I2C_PRIORITY::BACKGROUND, &Statistics));
+    UNSIGNED_LONGS_EQUAL(2, Statistics.Requests);
+    CHECK_TRUE(Statistics.MaxLatency >= 5'000'000);
+    CHECK_TRUE(Statistics.TotalLatency >= 2 * 5'000'000ULL);
+    CHECK_TRUE(Statistics.TotalLatency <= 2 * Statistics.MaxLatency);
+
+    LONGS_EQUAL(0, I2C_GetQueueStatistics(Bus, I2C_PRIORITY::CONTROL, &Statistics));
+    UNSIGNED_LONGS_EQUAL(1, Statistics.Requests);
+    CHECK_TRUE(Statistics.MaxLatency >= 5'000'000);
+    UNSIGNED_LONGS_EQUAL(Statistics.MaxLatency, Statistics.TotalLatency);
+
+    LONGS_EQUAL(0, I2C_GetQueueStatistics(Bus, I2C_PRIORITY::NORMAL, &Statistics));
+    UNSIGNED_LONGS_EQUAL(1, Statistics.Requests);
+}
+
+// ==============================================================================
+// TESTS (Coroutines)
+// ==============================================================================
+
+TEST(I2C_Arbiter, TaskIsResumedOnTheWorker)
+{
+    Sensor->Poke(5, 0x1234);
+
+    // The bus is held : the task is suspended on it's access, without blocking the caller.
+    Hold();
+    uint16_t Value = 0;
+    std::thread::id Resumed;
+    I2C_Task Task = ReadRegister(Bus, 5, &Value, &Resumed);
+    CHECK_FALSE(Task.Ready());
+
+    Gate.store(2);
+    LONGS_EQUAL(0, Task.Wait());
+    CHECK_TRUE(Task.Ready());
+    LONGS_EQUAL(0x1234, Value);
+    CHECK_TRUE(Resumed != std::this_thread::get_id());
+    WaitCompletions(1);
+}
+
+TEST(I2C_Arbiter, NackReachTheAwaitingCoroutine)
+{
+    uint16_t Value = 0;
+    std::thread::id Resumed;
+    Simulator->InjectNack(SENSOR_ADDRESS, 1);
+    const int Expected = I2C_ReadWords(Bus, SENSOR_ADDRESS, 5, &Value, 1);
+    CHECK_TRUE(Expected < 0);
+
+    // Same error code as the blocking access, then the next access succeed.
+    Simulator->InjectNack(SENSOR_ADDRESS, 1);
+    I2C_Task Failed = ReadRegister(Bus, 5, &Value, &Resumed);
+    LONGS_EQUAL(Expected, Failed.Wait());
+
+    I2C_Task Next = ReadRegister(Bus, 5, &Value, &Resumed);
+    LONGS_EQUAL(0, Next.Wait());
+}
+
+TEST(I2C_Arbiter, MCP9808InitializeOnTheWorker)
+{
+    MCP9808 TempSensor(Bus, TEMP_SENSOR::TEMP_0);
+    Sensor->Poke(0x06, 0x0054);
+
+    I2C_Task Task = TempSensor.Initialize(TEMP_RESOLUTION::C0_0625, -10.0f, 30.0f, 40.0f);
+    LONGS_EQUAL(0, Task.Wait());
+    LONGS_EQUAL(0x01E0, Sensor->Peek(0x02));
+    LONGS_EQUAL(0x10A0, Sensor->Peek(0x03));
+    LONGS_EQUAL(0x0280, Sensor->Peek(0x04));
+
+    // Served as telemetry.
+    I2C_QueueStatistics Statistics;
+    LONGS_EQUAL(0, I2C_GetQueueStatistics(Bus, I2C_PRIORITY::BACKGROUND, &Statistics));
+    UNSIGNED_LONGS_EQUAL(5, Statistics.Requests);
+}
+
+TEST(I2C_Arbiter, MCP9808InitializeReportNacks)
+{
+    MCP9808 TempSensor(Bus, TEMP_SENSOR::TEMP_0);
+    Sensor->Poke(0x06, 0x0054);
+
+    Simulator->InjectNack(SENSOR_ADDRESS, 1);
+    I2C_Task Task = TempSensor.Initialize(TEMP_RESOLUTION::C0_0625, -10.0f, 30.0f, 40.0f);
+    LONGS_EQUAL(-2, Task.Wait());
+
+    // Not a MCP9808
+    Sensor->Poke(0x06, 0x0055);
+    I2C_Task Other = TempSensor.Initialize(TEMP_RESOLUTION::C0_0625, -10.0f, 30.0f, 40.0f);
+    LONGS_EQUAL(-3, Other.Wait());
+}
+
+// ==============================================================================
+// TESTS (Drivers)
+// ==============================================================================
+
+TEST(I2C_SimulatedBus, MCP9808ReadTemperature)
+{
+    MCP9808 TempSensor(Bus, TEMP_SENSOR::TEMP_0);
+    Sensor->Poke(0x05, 0x01A5);
+
+    float Temperature = 0.0f;
+    int Status = -1;
+    LONGS_EQUAL(0, TempSensor.ReadTemperature(&Temperature, &Status));
+    DOUBLES_EQUAL(26.3125f, Temperature, 0.01f);
+    LONGS_EQUAL(0, Status);
+}
+
+TEST(I2C_SimulatedBus, MCP9808GetIDs)
+{
+    MCP9808 TempSensor(Bus, TEMP_SENSOR::TEMP_0);
+    Sensor->Poke(0x06, 0x0054);
+    Sensor->Poke(0x07, 0x0400);
+
+    int DeviceID = 0;
+    int DeviceRevision = 0;
+    int ManufacturerID = 0;
+    LONGS_EQUAL(0, TempSensor.GetIDs(&DeviceID, &DeviceRevision, &ManufacturerID));
+    LONGS_EQUAL(0x0054, ManufacturerID);
+    LONGS_EQUAL(0x0400, DeviceRevision);
+    LONGS_EQUAL(1, Simulator->GetStatistics().Transfers);
+}
+
+TEST(I2C_SimulatedBus, MCP9808InitializeCompleteOnCall)
+{
+    MCP9808 TempSensor(Bus, TEMP_SENSOR::TEMP_0);
+    Sensor->Poke(0x06, 0x0054);
+
+    // Without arbiter, every access is done in place.
+    I2C_Task Task = TempSensor.Initialize(TEMP_RESOLUTION::C0_0625, -10.0f, 30.0f, 40.0f);
+    CHECK_TRUE(Task.Ready());
+    LONGS_EQUAL(0, Task.Wait());
+    LONGS_EQUAL(0x0280, Sensor->Peek(0x04));
+
+    I2C_Task Invalid = TempSensor.Initialize(TEMP_RESOLUTION::C0_0625, -10.0f, 130.0f, 40.0f);
+    LONGS_EQUAL(-1, Invalid.Wait());
+}
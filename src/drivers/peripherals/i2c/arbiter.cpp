@@ -0,0 +1,263 @@
+/**
+ * @file arbiter.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Serialize the accesses of all of the threads to an I2C bus, with priority classes.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+// Header
+#include "drivers/peripherals/core/I2C_Arbiter.hpp"
+
+// STD
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+// ==============================================================================
+// DATA STRUCTURES
+// ==============================================================================
+
+/*! Define the arbiter. Producers only push on the per class stacks, everything else is owned by the worker.*/
+struct I2C_Arbiter
+{
+    std::atomic<I2C_Request*> Queues[I2C_PRIORITY_COUNT]; /*!< Lock-free stacks, pushed by any thread*/
+    I2C_Request* Pending[I2C_PRIORITY_COUNT]; /*!< FIFO lists, owned by the worker*/
+
+    std::atomic<uint32_t> Signal; /*!< Incremented on each push, the worker sleep on it*/
+    std::atomic<uint32_t> Completed; /*!< Incremented on each completion, callers sleep on it*/
+    std::atomic<bool> Running;
+
+    std::atomic<unsigned long> Requests[I2C_PRIORITY_COUNT];
+    std::atomic<unsigned long long> TotalLatency[I2C_PRIORITY_COUNT];
+    std::atomic<unsigned long long> MaxLatency[I2C_PRIORITY_COUNT];
+
+    std::thread Worker;
+    std::thread::id WorkerId;
+};
+
+// ==============================================================================
+// PRIVATE FUNCTIONS
+// ==============================================================================
+void I2C_ArbiterWorker(I2C_Arbiter* Arbiter);
+I2C_Request* I2C_ArbiterPop(I2C_Arbiter* Arbiter, int* const Class);
+void I2C_ArbiterPush(I2C_Arbiter* Arbiter, I2C_Request* const Request);
+
+// ==============================================================================
+// FUNCTIONS
+// ==============================================================================
+
+// ------------------------------------------------------------------------------
+int I2C_ArbiterStart(I2C_Bus* I2C)
+{
+    if(I2C->Context == nullptr)
+        return -1;
+    if(I2C->Context->Arbiter != nullptr)
+        return -2;
+
+    I2C_Arbiter* Arbiter = new I2C_Arbiter;
+    for(int i = 0; i < I2C_PRIORITY_COUNT; i++)
+    {
+        Arbiter->Queues[i].store(nullptr);
+        Arbiter->Pending[i] = nullptr;
+        Arbiter->Requests[i].store(0);
+        Arbiter->TotalLatency[i].store(0);
+        Arbiter->MaxLatency[i].store(0);
+    }
+    Arbiter->Signal.store(0);
+    Arbiter->Completed.store(0);
+    Arbiter->Running.store(true);
+
+    Arbiter->Worker = std::thread(I2C_ArbiterWorker, Arbiter);
+    Arbiter->WorkerId = Arbiter->Worker.get_id();
+
+    I2C->Context->Arbiter = Arbiter;
+    return 0;
+}
+
+// ------------------------------------------------------------------------------
+int I2C_ArbiterStop(I2C_Bus* I2C)
+{
+    if((I2C->Context == nullptr) || (I2C->Context->Arbiter == nullptr))
+        return -1;
+
+    I2C_Arbiter* Arbiter = I2C->Context->Arbiter;
+
+    Arbiter->Running.store(false, std::memory_order_release);
+    Arbiter->Signal.fetch_add(1, std::memory_order_release);
+    Arbiter->Signal.notify_one();
+    Arbiter->Worker.join();
+
+    I2C->Context->Arbiter = nullptr;
+    delete Arbiter;
+    return 0;
+}
+
+// ------------------------------------------------------------------------------
+int I2C_ArbiterExecute(I2C_Bus* I2C, I2C_Operation Operation, void* Arguments)
+{
+    I2C_Arbiter* Arbiter = (I2C->Context != nullptr) ? I2C->Context->Arbiter : nullptr;
+
+    // No arbiter, or nested call from the worker : we already own the bus.
+    if((Arbiter == nullptr) || (std::this_thread::get_id() == Arbiter->WorkerId))
+        return Operation(I2C, Arguments);
+
+    I2C_Request Request;
+    Request.Operation = Operation;
+    Request.Arguments = Arguments;
+    Request.I2C = I2C;
+    Request.Result = 0;
+    Request.Complete = nullptr;
+    Request.User = nullptr;
+    Request.Done.store(0, std::memory_order_relaxed);
+
+    I2C_ArbiterPush(Arbiter, &Request);
+
+    // Wait on the shared completion counter, the worker never touch the request once Done is set.
+    uint32_t Completed = Arbiter->Completed.load(std::memory_order_acquire);
+    while(Request.Done.load(std::memory_order_acquire) == 0)
+    {
+        Arbiter->Completed.wait(Completed, std::memory_order_acquire);
+        Completed = Arbiter->Completed.load(std::memory_order_acquire);
+    }
+
+    return Request.Result;
+}
+
+// ------------------------------------------------------------------------------
+int I2C_ArbiterSubmit(I2C_Bus* I2C, I2C_Request* const Request)
+{
+    if((I2C->Context == nullptr) || (I2C->Context->Arbiter == nullptr))
+        return -1;
+
+    I2C_ArbiterPush(I2C->Context->Arbiter, Request);
+    return 0;
+}
+
+// ------------------------------------------------------------------------------
+int I2C_SetPriority(I2C_Bus* I2C, const I2C_PRIORITY Priority)
+{
+    I2C->Priority = Priority;
+    return 0;
+}
+
+// ------------------------------------------------------------------------------
+int I2C_GetQueueStatistics(I2C_Bus* I2C,
+                           const I2C_PRIORITY Priority,
+                           I2C_QueueStatistics* const Statistics)
+{
+    if((I2C->Context == nullptr) || (I2C->Context->Arbiter == nullptr))
+        return -1;
+
+    I2C_Arbiter* Arbiter = I2C->Context->Arbiter;
+    int Class = (int)Priority;
+
+    Statistics->Requests = Arbiter->Requests[Class].load(std::memory_order_relaxed);
+    Statistics->TotalLatency = Arbiter->TotalLatency[Class].load(std::memory_order_relaxed);
+    Statistics->MaxLatency = Arbiter->MaxLatency[Class].load(std::memory_order_relaxed);
+    return 0;
+}
+
+// ==============================================================================
+// PRIVATE FUNCTIONS
+// ==============================================================================
+
+// ------------------------------------------------------------------------------
+void I2C_ArbiterWorker(I2C_Arbiter* Arbiter)
+{
+    while(true)
+    {
+        // Sample the signal before looking at the queues, to never miss a push.
+        uint32_t Signal = Arbiter->Signal.load(std::memory_order_acquire);
+
+        int Class = 0;
+        I2C_Request* Request = I2C_ArbiterPop(Arbiter, &Class);
+
+        if(Request == nullptr)
+        {
+            if(!Arbiter->Running.load(std::memory_order_acquire))
+                return;
+            Arbiter->Signal.wait(Signal, std::memory_order_acquire);
+            continue;
+        }
+
+        // Queueing latency
+        unsigned long long Latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now() - Request->Queued)
+                                         .count();
+        Arbiter->Requests[Class].fetch_add(1, std::memory_order_relaxed);
+        Arbiter->TotalLatency[Class].fetch_add(Latency, std::memory_order_relaxed);
+        if(Latency > Arbiter->MaxLatency[Class].load(std::memory_order_relaxed))
+            Arbiter->MaxLatency[Class].store(Latency, std::memory_order_relaxed);
+
+        Request->Result = Request->Operation(Request->I2C, Request->Arguments);
+
+        // Asynchronous request : the owner may release it from the callback.
+        if(Request->Complete != nullptr)
+        {
+            Request->Complete(Request);
+            continue;
+        }
+
+        Request->Done.store(1, std::memory_order_release);
+        Arbiter->Completed.fetch_add(1, std::memory_order_release);
+        Arbiter->Completed.notify_all();
+    }
+}
+
+// ------------------------------------------------------------------------------
+I2C_Request* I2C_ArbiterPop(I2C_Arbiter* Arbiter, int* const Class)
+{
+    // Classes are scanned in order on each call, thus a new CONTROL request overtake any pending one.
+    for(int i = 0; i < I2C_PRIORITY_COUNT; i++)
+    {
+        if(Arbiter->Pending[i] == nullptr)
+        {
+            // Take the whole stack at once, and reverse it to restore the submission order.
+            I2C_Request* Stack = Arbiter->Queues[i].exchange(nullptr, std::memory_order_acquire);
+            I2C_Request* List = nullptr;
+            while(Stack != nullptr)
+            {
+                I2C_Request* Next = Stack->Next;
+                Stack->Next = List;
+                List = Stack;
+                Stack = Next;
+            }
+            Arbiter->Pending[i] = List;
+        }
+
+        if(Arbiter->Pending[i] != nullptr)
+        {
+            I2C_Request* Request = Arbiter->Pending[i];
+            Arbiter->Pending[i] = Request->Next;
+            *Class = i;
+            return Request;
+        }
+    }
+    return nullptr;
+}
+
+// ------------------------------------------------------------------------------
+void I2C_ArbiterPush(I2C_Arbiter* Arbiter, I2C_Request* const Request)
+{
+    int Class = (int)Request->I2C->Priority;
+    if((Class < 0) || (Class >= I2C_PRIORITY_COUNT))
+        Class = (int)I2C_PRIORITY::NORMAL;
+
+    Request->Queued = std::chrono::steady_clock::now();
+
+    // Push on the class stack, and wake the worker.
+    Request->Next = Arbiter->Queues[Class].load(std::memory_order_relaxed);
+    while(!Arbiter->Queues[Class].compare_exchange_weak(
+        Request->Next, Request, std::memory_order_release, std::memory_order_relaxed))
+        ;
+    Arbiter->Signal.fetch_add(1, std::memory_order_release);
+    Arbiter->Signal.notify_one();
+}
@@ -0,0 +1,213 @@
+/**
+ * @file async.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define an asynchronous, coroutine based, access to the I2C bus.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+// Header
+#include "drivers/peripherals/core/I2C_Async.hpp"
+
+// STD
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+
+// ==============================================================================
+// PRIVATE VARIABLES
+// ==============================================================================
+
+// Incremented on each task completion, the waiting threads sleep on it.
+// A task frame may be destroyed as soon as Done is seen, thus it can't be notified directly.
+static std::atomic<uint32_t> I2C_TaskCompletions{0};
+
+// Stored as continuation once the task is done.
+static char I2C_TaskFinished;
+
+// ==============================================================================
+// PRIVATE FUNCTIONS
+// ==============================================================================
+void I2C_AwaitableComplete(I2C_Request* Request);
+
+// ==============================================================================
+// AWAITABLE
+// ==============================================================================
+
+// ------------------------------------------------------------------------------
+I2C_Awaitable::I2C_Awaitable(I2C_Bus* I2C, I2C_Operation Operation, const I2C_AccessArguments& Access)
+    : I2C_Awaitable(I2C, Operation, (void*)nullptr)
+{
+    this->Access = Access;
+    this->Request.Arguments = &this->Access;
+}
+
+// ------------------------------------------------------------------------------
+I2C_Awaitable::I2C_Awaitable(I2C_Bus* I2C, I2C_Operation Operation, void* Arguments)
+{
+    this->Request.Operation = Operation;
+    this->Request.Arguments = Arguments;
+    this->Request.I2C = I2C;
+    this->Request.Result = 0;
+    this->Request.Complete = I2C_AwaitableComplete;
+    this->Request.User = nullptr;
+    this->Request.Done.store(0, std::memory_order_relaxed);
+}
+
+// ------------------------------------------------------------------------------
+bool I2C_Awaitable::await_ready()
+{
+    I2C_Bus* I2C = this->Request.I2C;
+
+    // Without arbiter, the access is done in place.
+    if((I2C->Context == nullptr) || (I2C->Context->Arbiter == nullptr))
+    {
+        this->Request.Result = this->Request.Operation(I2C, this->Request.Arguments);
+        return true;
+    }
+    return false;
+}
+
+// ------------------------------------------------------------------------------
+void I2C_Awaitable::await_suspend(std::coroutine_handle<> Coroutine)
+{
+    this->Request.User = Coroutine.address();
+    I2C_ArbiterSubmit(this->Request.I2C, &this->Request);
+}
+
+// ------------------------------------------------------------------------------
+int I2C_Awaitable::await_resume() const noexcept
+{
+    return this->Request.Result;
+}
+
+// ------------------------------------------------------------------------------
+void I2C_AwaitableComplete(I2C_Request* Request)
+{
+    // The awaitable live in the coroutine frame, and is not accessed anymore once resumed.
+    std::coroutine_handle<>::from_address(Request->User).resume();
+}
+
+// ==============================================================================
+// TASK
+// ==============================================================================
+
+// ------------------------------------------------------------------------------
+I2C_Task::I2C_Task(Handle Coroutine) noexcept
+{
+    this->Coroutine = Coroutine;
+}
+
+// ------------------------------------------------------------------------------
+I2C_Task::I2C_Task(I2C_Task&& Other) noexcept
+{
+    this->Coroutine = Other.Coroutine;
+    Other.Coroutine = nullptr;
+}
+
+// ------------------------------------------------------------------------------
+I2C_Task::~I2C_Task()
+{
+    if(!this->Coroutine)
+        return;
+
+    this->Wait();
+    this->Coroutine.destroy();
+}
+
+// ------------------------------------------------------------------------------
+bool I2C_Task::Ready() const
+{
+    return this->Coroutine.promise().Done.load(std::memory_order_acquire) != 0;
+}
+
+// ------------------------------------------------------------------------------
+int I2C_Task::Wait() const
+{
+    promise_type& Promise = this->Coroutine.promise();
+
+    uint32_t Completions = I2C_TaskCompletions.load(std::memory_order_acquire);
+    while(Promise.Done.load(std::memory_order_acquire) == 0)
+    {
+        I2C_TaskCompletions.wait(Completions, std::memory_order_acquire);
+        Completions = I2C_TaskCompletions.load(std::memory_order_acquire);
+    }
+    return Promise.Result;
+}
+
+// ------------------------------------------------------------------------------
+bool I2C_Task::await_ready() const noexcept
+{
+    return this->Ready();
+}
+
+// ------------------------------------------------------------------------------
+bool I2C_Task::await_suspend(std::coroutine_handle<> Coroutine) noexcept
+{
+    // Register as continuation, unless the task completed in the meantime.
+    void* Expected = nullptr;
+    return this->Coroutine.promise().Continuation.compare_exchange_strong(
+        Expected, Coroutine.address(), std::memory_order_acq_rel);
+}
+
+// ------------------------------------------------------------------------------
+int I2C_Task::await_resume() const noexcept
+{
+    return this->Coroutine.promise().Result;
+}
+
+// ------------------------------------------------------------------------------
+std::coroutine_handle<> I2C_Task::FinalAwaiter::await_suspend(Handle Coroutine) noexcept
+{
+    promise_type& Promise = Coroutine.promise();
+
+    void* Continuation = Promise.Continuation.exchange(&I2C_TaskFinished, std::memory_order_acq_rel);
+
+    // The frame may be destroyed by a waiter from here, only local copies are used.
+    Promise.Done.store(1, std::memory_order_release);
+    I2C_TaskCompletions.fetch_add(1, std::memory_order_release);
+    I2C_TaskCompletions.notify_all();
+
+    if(Continuation != nullptr)
+        return std::coroutine_handle<>::from_address(Continuation);
+    return std::noop_coroutine();
+}
+
+// ------------------------------------------------------------------------------
+void I2C_Task::promise_type::unhandled_exception() const noexcept
+{
+    std::terminate();
+}
+
+// ==============================================================================
+// FUNCTIONS
+// ==============================================================================
+
+// ------------------------------------------------------------------------------
+I2C_Awaitable I2C_WriteAsync(
+    I2C_Bus* I2C, int Address, int Register, int* Payload, int Size, int DataSize)
+{
+    return I2C_Awaitable(
+        I2C, I2C_WriteDirect, I2C_AccessArguments{Address, Register, Payload, Size, DataSize});
+}
+
+// ------------------------------------------------------------------------------
+I2C_Awaitable I2C_ReadAsync(
+    I2C_Bus* I2C, int Address, int Register, int* Payload, int Size, int DataSize)
+{
+    return I2C_Awaitable(
+        I2C, I2C_ReadDirect, I2C_AccessArguments{Address, Register, Payload, Size, DataSize});
+}
+
+// ------------------------------------------------------------------------------
+I2C_Awaitable I2C_TransactionSubmitAsync(I2C_Bus* I2C, I2C_Transaction* const Transaction)
+{
+    return I2C_Awaitable(I2C, I2C_TransactionSubmitDirect, (void*)Transaction);
+}
@@ -0,0 +1,84 @@
+/**
+ * @file backend.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Linux i2c-dev implementation of the I2C backend.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+// Header
+#include "drivers/peripherals/core/I2C_Backend.hpp"
+
+// STD
+#include <cstdint>
+#include <errno.h>
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+// Custom builded smbus.h file, from the original repo : https://github.com/Sensirion/i2c-tools/tree/master
+// Only includes path were modified.
+// File extension was changed to C++ to make the compilation easier.
+#include "drivers/peripherals/core/smbus.h"
+
+// =====================
+// CONSTRUCTORS
+// =====================
+
+I2C_KernelBackend::I2C_KernelBackend(const int File)
+{
+    this->File = File;
+    return;
+}
+
+// =====================
+// DESTRUCTORS
+// =====================
+
+I2C_KernelBackend::~I2C_KernelBackend()
+{
+    if(this->File >= 0)
+        close(this->File);
+    return;
+}
+
+// =====================
+// FUNCTIONS
+// =====================
+
+int I2C_KernelBackend::SelectAddress(const int Address)
+{
+    if(ioctl(this->File, I2C_SLAVE, Address) < 0)
+        return -errno;
+    return 0;
+}
+
+int I2C_KernelBackend::SMBusAccess(const char ReadWrite,
+                                   const uint8_t Command,
+                                   const int Size,
+                                   union i2c_smbus_data* const Data)
+{
+    // Already return -errno on failure.
+    int res = i2c_smbus_access(this->File, ReadWrite, Command, Size, Data);
+    if(res < 0)
+        return res;
+    return 0;
+}
+
+int I2C_KernelBackend::Transfer(struct i2c_msg* const Messages, const int Count)
+{
+    struct i2c_rdwr_ioctl_data data;
+    data.msgs = Messages;
+    data.nmsgs = (__u32)Count;
+
+    if(ioctl(this->File, I2C_RDWR, &data) < 0)
+        return -errno;
+    return 0;
+}
@@ -16,6 +16,9 @@
 // ==============================================================================
 // Header
 #include "drivers/peripherals/i2c.hpp"
+#include "drivers/peripherals/core/I2C_Arbiter.hpp"
+#include "drivers/peripherals/core/I2C_Backend.hpp"
+#include "drivers/peripherals/core/I2C_Trace.hpp"
 
 // STD
 #include <cstdint>
@@ -23,27 +26,25 @@
 #include <fcntl.h>
 #include <iostream>
 #include <linux/i2c-dev.h>
+#include <linux/i2c.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
 
-// ==============================================================================
-// FUNCTIONS
-// ==============================================================================
-
-// Custom builded smbus.h file, from the original repo : https://github.com/Sensirion/i2c-tools/tree/master
-// Only includes path were modified.
-// File extension was changed to C++ to make the compilation easier.
-#include "drivers/peripherals/core/smbus.h"
-
 // ==============================================================================
 // PRIVATE FUNCTIONS
 // ==============================================================================
 int I2C_ConfigureAddress(I2C_Bus* I2C, int Address);
 int I2C_CheckRegister(int Register);
 int I2C_CheckAddress(int Address);
+int I2C_SMBusWrite(I2C_Bus* I2C, int Command, int Size, int Value);
+int I2C_SMBusRead(I2C_Bus* I2C, int Command, int Size);
+I2C_Bus* I2C_CreateBus(I2C_Backend* Backend);
+int I2C_DispatchSMBus(
+    I2C_Bus* I2C, char ReadWrite, int Command, int Size, union i2c_smbus_data* Data);
+int I2C_DispatchTransfer(I2C_Bus* I2C, struct i2c_msg* Messages, int Count);
 
 // ==============================================================================
 // FUNCTIONS
@@ -52,56 +53,100 @@ int I2C_CheckAddress(int Address);
 // ------------------------------------------------------------------------------
 I2C_Bus* I2C_GetInfos()
 {
-    // Create struct
-    I2C_Bus* I2C = new I2C_Bus;
-
-    I2C->I2C_bus = I2C_BUS_NUMBER;
+    char Filename[30];
 
     // Generate the file
-    snprintf(I2C->I2C_filename, sizeof(I2C->I2C_filename), "/dev/i2c-%ld", I2C->I2C_bus);
-    I2C->I2C_filename[sizeof(I2C->I2C_filename) - 1] = '\0';
+    snprintf(Filename, sizeof(Filename), "/dev/i2c-%d", I2C_BUS_NUMBER);
+    Filename[sizeof(Filename) - 1] = '\0';
 
     // Open the file
-    I2C->I2C_file = open(I2C->I2C_filename, O_RDWR);
+    int File = open(Filename, O_RDWR);
 
-    if(I2C->I2C_file < 0)
+    if(File < 0)
     {
         std::cerr << "[ I2C ][ GetInfos ] : Could not open the requested I2C bus : "
                   << strerror(errno) << std::endl;
-        I2C->I2C_file = (int)NULL;
     }
 
+    // Create struct
+    I2C_Bus* I2C = I2C_CreateBus(new I2C_KernelBackend(File));
+
+    I2C->I2C_file = (File < 0) ? (int)NULL : File;
+    I2C->I2C_bus = I2C_BUS_NUMBER;
+    memcpy(I2C->I2C_filename, Filename, sizeof(I2C->I2C_filename));
+
+    return I2C;
+}
+
+// ------------------------------------------------------------------------------
+I2C_Bus* I2C_Open(I2C_Backend* Backend)
+{
+    I2C_Bus* I2C = I2C_CreateBus(Backend);
+
+    I2C->I2C_file = -1;
+    I2C->I2C_bus = -1;
+    snprintf(I2C->I2C_filename, sizeof(I2C->I2C_filename), "backend");
+
     return I2C;
 }
 
 // ------------------------------------------------------------------------------
 int I2C_Close(I2C_Bus* I2C)
 {
-    close(I2C->I2C_file);
+    if(I2C->Context->Arbiter != nullptr)
+        I2C_ArbiterStop(I2C);
+
+    // The backend own the file, if any.
+    delete I2C->Context->Backend;
+    I2C_TraceDestroy(I2C->Context->Trace);
+    delete I2C->Context;
     delete I2C;
     return 0;
 }
 
+// ------------------------------------------------------------------------------
+int I2C_GetAddressStatistics(I2C_Bus* I2C, unsigned long* const Issued, unsigned long* const Saved)
+{
+    if(I2C->Context == nullptr)
+        return -1;
+
+    *Issued = I2C->Context->AddressIoctls;
+    *Saved = I2C->Context->AddressRequests - I2C->Context->AddressIoctls;
+    return 0;
+}
+
 // ------------------------------------------------------------------------------
 int I2C_Write(I2C_Bus* I2C, int Address, int Register, int* Payload, int Size, int DataSize)
 {
+    I2C_AccessArguments Arguments = {Address, Register, Payload, Size, DataSize};
+    return I2C_ArbiterExecute(I2C, I2C_WriteDirect, &Arguments);
+}
+
+// ------------------------------------------------------------------------------
+int I2C_WriteDirect(I2C_Bus* I2C, void* Arguments)
+{
+    I2C_AccessArguments* Args = (I2C_AccessArguments*)Arguments;
+
     // basics checks
-    if(I2C_CheckAddress(Address) != 0)
+    if(I2C_CheckAddress(Args->Address) != 0)
         return -1;
-    if(I2C_CheckRegister(Register) != 0)
+    if(I2C_CheckRegister(Args->Register) != 0)
         return -2;
 
     int res = 0;
 
     // address conf to the driver
-    I2C_ConfigureAddress(I2C, (uint8_t)Address);
+    if(I2C_ConfigureAddress(I2C, (uint8_t)Args->Address) != 0)
+        return -5;
 
-    for(int i = 0; i < Size; i++)
+    for(int i = 0; i < Args->Size; i++)
     {
-        if(DataSize == 1)
-            res = i2c_smbus_write_byte_data(I2C->I2C_file, Register + i, (uint8_t)Payload[i]);
+        if(Args->DataSize == 1)
+            res = I2C_SMBusWrite(
+                I2C, Args->Register + i, I2C_SMBUS_BYTE_DATA, (uint8_t)Args->Payload[i]);
         else
-            res = i2c_smbus_write_word_data(I2C->I2C_file, Register + i, (uint16_t)Payload[i]);
+            res = I2C_SMBusWrite(
+                I2C, Args->Register + i, I2C_SMBUS_WORD_DATA, (uint16_t)Args->Payload[i]);
     }
 
     if(res != 0)
@@ -112,42 +157,316 @@ int I2C_Write(I2C_Bus* I2C, int Address, int Register, int* Payload, int Size, i
 // ------------------------------------------------------------------------------
 int I2C_Read(I2C_Bus* I2C, int Address, int Register, int* Payload, int Size, int DataSize)
 {
+    I2C_AccessArguments Arguments = {Address, Register, Payload, Size, DataSize};
+    return I2C_ArbiterExecute(I2C, I2C_ReadDirect, &Arguments);
+}
+
+// ------------------------------------------------------------------------------
+int I2C_ReadDirect(I2C_Bus* I2C, void* Arguments)
+{
+    I2C_AccessArguments* Args = (I2C_AccessArguments*)Arguments;
+
     // basics checks
-    if(I2C_CheckAddress(Address) != 0)
+    if(I2C_CheckAddress(Args->Address) != 0)
         return -1;
-    if(I2C_CheckRegister(Register) != 0)
+    if(I2C_CheckRegister(Args->Register) != 0)
         return -2;
-    if(Size > 0xFF)
+    if(Args->Size > 0xFF)
         return -3;
 
     int res = 0;
 
     // address conf to the driver// Configure the I2C Slave address
-    I2C_ConfigureAddress(I2C, Address);
+    if(I2C_ConfigureAddress(I2C, Args->Address) != 0)
+        return -5;
 
     // If data == 0 (We send only a command !)
-    for(int i = 0; i < Size; i++)
+    for(int i = 0; i < Args->Size; i++)
+    {
+        if(Args->DataSize == 1)
+            res = I2C_SMBusRead(I2C, Args->Register + i, I2C_SMBUS_BYTE_DATA);
+        else if(Args->DataSize == 2)
+            res = I2C_SMBusRead(I2C, Args->Register + i, I2C_SMBUS_WORD_DATA);
+        Args->Payload[i] = res;
+    }
+    return 0;
+}
+
+// ------------------------------------------------------------------------------
+int I2C_TransactionInit(I2C_Transaction* const Transaction)
+{
+    Transaction->MessageCount = 0;
+    Transaction->BufferUsed = 0;
+    return 0;
+}
+
+// ------------------------------------------------------------------------------
+int I2C_TransactionWrite(I2C_Transaction* const Transaction,
+                         int Address,
+                         int Register,
+                         const uint8_t* const Payload,
+                         int Size)
+{
+    // basics checks
+    if(I2C_CheckAddress(Address) != 0)
+        return -1;
+    if(I2C_CheckRegister(Register) != 0)
+        return -2;
+    if(Transaction->MessageCount >= I2C_MAX_MESSAGES)
+        return -3;
+    if((Size < 0) | (Transaction->BufferUsed + Size + 1 > I2C_TRANSACTION_BUFFER))
+        return -4;
+
+    // Stage the register, followed by the payload, on the same message.
+    uint8_t* buf = &Transaction->Buffer[Transaction->BufferUsed];
+    buf[0] = (uint8_t)Register;
+    if(Size > 0)
+        memcpy(&buf[1], Payload, Size);
+    Transaction->BufferUsed += Size + 1;
+
+    struct i2c_msg* msg = &Transaction->Messages[Transaction->MessageCount++];
+    msg->addr = (__u16)Address;
+    msg->flags = 0;
+    msg->len = (__u16)(Size + 1);
+    msg->buf = buf;
+
+    return 0;
+}
+
+// ------------------------------------------------------------------------------
+int I2C_TransactionRead(
+    I2C_Transaction* const Transaction, int Address, int Register, uint8_t* const Payload, int Size)
+{
+    // basics checks
+    if(I2C_CheckAddress(Address) != 0)
+        return -1;
+    if(I2C_CheckRegister(Register) != 0)
+        return -2;
+    if(Transaction->MessageCount + 2 > I2C_MAX_MESSAGES)
+        return -3;
+    if((Size <= 0) | (Transaction->BufferUsed + 1 > I2C_TRANSACTION_BUFFER))
+        return -4;
+
+    // Register pointer write, without STOP.
+    uint8_t* buf = &Transaction->Buffer[Transaction->BufferUsed];
+    buf[0] = (uint8_t)Register;
+    Transaction->BufferUsed += 1;
+
+    struct i2c_msg* msg = &Transaction->Messages[Transaction->MessageCount++];
+    msg->addr = (__u16)Address;
+    msg->flags = 0;
+    msg->len = 1;
+    msg->buf = buf;
+
+    // Then the read itself, with a repeated START, directly on the caller buffer.
+    msg = &Transaction->Messages[Transaction->MessageCount++];
+    msg->addr = (__u16)Address;
+    msg->flags = I2C_M_RD;
+    msg->len = (__u16)Size;
+    msg->buf = Payload;
+
+    return 0;
+}
+
+// ------------------------------------------------------------------------------
+int I2C_TransactionSubmit(I2C_Bus* I2C, I2C_Transaction* const Transaction)
+{
+    if(Transaction->MessageCount == 0)
+        return 0;
+
+    return I2C_ArbiterExecute(I2C, I2C_TransactionSubmitDirect, Transaction);
+}
+
+// ------------------------------------------------------------------------------
+int I2C_TransactionSubmitDirect(I2C_Bus* I2C, void* Arguments)
+{
+    I2C_Transaction* Transaction = (I2C_Transaction*)Arguments;
+
+    if(Transaction->MessageCount == 0)
+        return 0;
+
+    int res = I2C_DispatchTransfer(I2C, Transaction->Messages, Transaction->MessageCount);
+
+    if(res < 0)
+    {
+        std::cerr << "[ I2C ][ TransactionSubmit ] : Could not perform transfer : " << strerror(-res)
+                  << std::endl;
+        return -5;
+    }
+    return 0;
+}
+
+// ------------------------------------------------------------------------------
+int I2C_WriteBurst(
+    I2C_Bus* I2C, int Address, int Register, const uint8_t* const Payload, int Size)
+{
+    if(Size <= 0)
+        return -3;
+
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+
+    int res = I2C_TransactionWrite(&Transaction, Address, Register, Payload, Size);
+    if(res == -4)
+        return -3;
+    if(res != 0)
+        return res;
+
+    return I2C_TransactionSubmit(I2C, &Transaction);
+}
+
+// ------------------------------------------------------------------------------
+int I2C_ReadBurst(I2C_Bus* I2C, int Address, int Register, uint8_t* const Payload, int Size)
+{
+    if((Size <= 0) | (Size > 0xFFFF))
+        return -3;
+
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+
+    int res = I2C_TransactionRead(&Transaction, Address, Register, Payload, Size);
+    if(res != 0)
+        return res;
+
+    return I2C_TransactionSubmit(I2C, &Transaction);
+}
+
+// ------------------------------------------------------------------------------
+int I2C_ReadWords(I2C_Bus* I2C, int Address, int Register, uint16_t* const Words, int Count)
+{
+    if((Count <= 0) | (Count > I2C_MAX_MESSAGES / 2))
+        return -3;
+    if(I2C_CheckRegister(Register + Count - 1) != 0)
+        return -2;
+
+    I2C_Transaction Transaction;
+    I2C_TransactionInit(&Transaction);
+
+    // One combined read per register, straight into the caller buffer.
+    for(int i = 0; i < Count; i++)
     {
-        if(DataSize == 1)
-            res = i2c_smbus_read_byte_data(I2C->I2C_file, Register + i);
-        else if(DataSize == 2)
-            res = i2c_smbus_read_word_data(I2C->I2C_file, Register + i);
-        Payload[i] = res;
+        int res = I2C_TransactionRead(&Transaction, Address, Register + i, (uint8_t*)&Words[i], 2);
+        if(res != 0)
+            return res;
     }
+
+    int res = I2C_TransactionSubmit(I2C, &Transaction);
+    if(res != 0)
+        return res;
+
+    for(int i = 0; i < Count; i++)
+        Words[i] = I2C_FromBigEndian(Words[i]);
+
     return 0;
 }
 
 // ------------------------------------------------------------------------------
 int I2C_ConfigureAddress(I2C_Bus* I2C, int Address)
 {
-    if(ioctl(I2C->I2C_file, I2C_SLAVE, Address) < 0)
+    I2C_Context* Context = I2C->Context;
+
+    // The kernel keep the slave address per file descriptor, thus skip the ioctl if already selected.
+    Context->AddressRequests++;
+    if(Context->Address == Address)
+        return 0;
+    Context->AddressIoctls++;
+
+    int res = Context->Backend->SelectAddress(Address);
+    if(res < 0)
     {
-        std::cerr << "[ I2C ][ ConfigureAddress ] : Could not set address : " << strerror(errno)
+        std::cerr << "[ I2C ][ ConfigureAddress ] : Could not set address : " << strerror(-res)
                   << std::endl;
-        return -errno;
+        Context->Address = -1;
+        return res;
     }
+
+    Context->Address = Address;
     return 0;
 }
+
+// ------------------------------------------------------------------------------
+int I2C_SMBusWrite(I2C_Bus* I2C, int Command, int Size, int Value)
+{
+    union i2c_smbus_data data;
+    if(Size == I2C_SMBUS_WORD_DATA)
+        data.word = (__u16)Value;
+    else
+        data.byte = (__u8)Value;
+
+    return I2C_DispatchSMBus(I2C, I2C_SMBUS_WRITE, Command, Size, &data);
+}
+
+// ------------------------------------------------------------------------------
+int I2C_SMBusRead(I2C_Bus* I2C, int Command, int Size)
+{
+    union i2c_smbus_data data;
+
+    int res = I2C_DispatchSMBus(I2C, I2C_SMBUS_READ, Command, Size, &data);
+    if(res < 0)
+        return res;
+
+    if(Size == I2C_SMBUS_WORD_DATA)
+        return data.word;
+    return data.byte;
+}
+
+// ------------------------------------------------------------------------------
+I2C_Bus* I2C_CreateBus(I2C_Backend* Backend)
+{
+    I2C_Bus* I2C = new I2C_Bus;
+    I2C->Priority = I2C_PRIORITY::NORMAL;
+
+    // Shared state, the selected slave is unknown until the first selection.
+    I2C->Context = new I2C_Context;
+    I2C->Context->Address = -1;
+    I2C->Context->AddressRequests = 0;
+    I2C->Context->AddressIoctls = 0;
+    I2C->Context->Arbiter = nullptr;
+    I2C->Context->Backend = Backend;
+    I2C->Context->Trace = I2C_TraceCreate();
+
+    return I2C;
+}
+
+// ------------------------------------------------------------------------------
+int I2C_DispatchSMBus(
+    I2C_Bus* I2C, char ReadWrite, int Command, int Size, union i2c_smbus_data* Data)
+{
+#ifdef I2C_TRACE
+    uint64_t Start = I2C_TraceNow();
+#endif
+
+    int res = I2C->Context->Backend->SMBusAccess(ReadWrite, (uint8_t)Command, Size, Data);
+
+#ifdef I2C_TRACE
+    // Register byte, then the data.
+    int Bytes = 1 + ((Size == I2C_SMBUS_WORD_DATA) ? 2 : 1);
+    I2C_TraceTransaction(I2C->Context->Trace, I2C->Context->Address, Command, Bytes, res, Start);
+#endif
+
+    return res;
+}
+
+// ------------------------------------------------------------------------------
+int I2C_DispatchTransfer(I2C_Bus* I2C, struct i2c_msg* Messages, int Count)
+{
+#ifdef I2C_TRACE
+    uint64_t Start = I2C_TraceNow();
+#endif
+
+    int res = I2C->Context->Backend->Transfer(Messages, Count);
+
+#ifdef I2C_TRACE
+    // Accounted to the device and register of the first message.
+    int Bytes = 0;
+    for(int i = 0; i < Count; i++)
+        Bytes += Messages[i].len;
+    int Register = ((Messages[0].flags & I2C_M_RD) | (Messages[0].len == 0)) ? 0 : Messages[0].buf[0];
+    I2C_TraceTransaction(I2C->Context->Trace, Messages[0].addr, Register, Bytes, res, Start);
+#endif
+
+    return res;
+}
 // ------------------------------------------------------------------------------
 int I2C_CheckAddress(int Address)
 {
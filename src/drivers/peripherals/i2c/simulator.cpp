@@ -0,0 +1,324 @@
+/**
+ * @file simulator.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define an in-memory I2C bus, to run the drivers on the host (unit tests, benchmarks).
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+// Header
+#include "drivers/peripherals/core/I2C_Simulator.hpp"
+
+// STD
+#include <chrono>
+#include <cstdint>
+#include <errno.h>
+#include <linux/i2c.h>
+#include <string.h>
+#include <thread>
+
+// ==============================================================================
+// REGISTER FILE
+// ==============================================================================
+
+// =====================
+// CONSTRUCTORS
+// =====================
+
+I2C_RegisterFile::I2C_RegisterFile(const int Width, const bool AutoIncrement)
+{
+    this->Width = (Width == 2) ? 2 : 1;
+    this->AutoIncrement = AutoIncrement;
+    this->Registers.assign(256 * this->Width, 0x00);
+    this->Pointer = 0;
+    this->Offset = 0;
+    return;
+}
+
+// =====================
+// PRIVATES
+// =====================
+
+void I2C_RegisterFile::Advance()
+{
+    this->Offset += 1;
+    if(this->Offset < this->Width)
+        return;
+
+    this->Offset = 0;
+    if(this->AutoIncrement)
+        this->Pointer = (this->Pointer + 1) & 0xFF;
+}
+
+void I2C_RegisterFile::OnRegisterWrite(const int Register)
+{
+    (void)Register;
+    return;
+}
+
+// =====================
+// FUNCTIONS
+// =====================
+
+int I2C_RegisterFile::Peek(const int Register) const
+{
+    int Value = 0;
+    for(int i = 0; i < this->Width; i++)
+        Value = (Value << 8) | this->Registers[(Register & 0xFF) * this->Width + i];
+    return Value;
+}
+
+void I2C_RegisterFile::Poke(const int Register, const int Value)
+{
+    for(int i = 0; i < this->Width; i++)
+        this->Registers[(Register & 0xFF) * this->Width + i] =
+            (uint8_t)(Value >> (8 * (this->Width - 1 - i)));
+}
+
+int I2C_RegisterFile::Write(const uint8_t* const Data, const int Size)
+{
+    if(Size <= 0)
+        return 0;
+
+    // First byte is the register pointer.
+    this->Pointer = Data[0];
+    this->Offset = 0;
+
+    for(int i = 1; i < Size; i++)
+    {
+        int Register = this->Pointer;
+        this->Registers[Register * this->Width + this->Offset] = Data[i];
+
+        if(this->Offset == this->Width - 1)
+            this->OnRegisterWrite(Register);
+        this->Advance();
+    }
+    return 0;
+}
+
+int I2C_RegisterFile::Read(uint8_t* const Data, const int Size)
+{
+    for(int i = 0; i < Size; i++)
+    {
+        Data[i] = this->Registers[this->Pointer * this->Width + this->Offset];
+        this->Advance();
+    }
+    return 0;
+}
+
+// ==============================================================================
+// SIMULATED BUS
+// ==============================================================================
+
+// =====================
+// CONSTRUCTORS
+// =====================
+
+I2C_SimulatedBus::I2C_SimulatedBus()
+{
+    for(int i = 0; i < 128; i++)
+    {
+        this->Devices[i] = nullptr;
+        this->Nacks[i] = 0;
+    }
+    this->Address = -1;
+
+    this->ClockFrequency = 100'000;
+    this->TransferLatency = 0;
+    this->RealTime = false;
+
+    this->ResetStatistics();
+    return;
+}
+
+// =====================
+// PRIVATES
+// =====================
+
+void I2C_SimulatedBus::Elapse(const struct i2c_msg* const Messages, const int Count)
+{
+    // START + address + ACK, then 9 clocks per byte, and a single STOP at the end.
+    unsigned long long Bits = 1;
+    for(int i = 0; i < Count; i++)
+        Bits += 1 + 9 + 9 * (unsigned long long)Messages[i].len;
+
+    unsigned long long Duration =
+        Bits * 1'000'000'000ULL / this->ClockFrequency + this->TransferLatency * 1'000ULL;
+    this->Statistics.BusTime += Duration;
+
+    if(this->RealTime)
+        std::this_thread::sleep_for(std::chrono::nanoseconds(Duration));
+}
+
+// =====================
+// FUNCTIONS
+// =====================
+
+int I2C_SimulatedBus::Attach(const int Address, I2C_DeviceModel* const Device)
+{
+    if((Address < 0) | (Address > 0x7F))
+        return -1;
+
+    this->Devices[Address] = Device;
+    return 0;
+}
+
+int I2C_SimulatedBus::InjectNack(const int Address, const int Count)
+{
+    if((Address < 0) | (Address > 0x7F))
+        return -1;
+
+    this->Nacks[Address] = Count;
+    return 0;
+}
+
+int I2C_SimulatedBus::SetLatency(const long ClockFrequency,
+                                 const long TransferLatency,
+                                 const bool RealTime)
+{
+    if(ClockFrequency <= 0)
+        return -1;
+
+    this->ClockFrequency = ClockFrequency;
+    this->TransferLatency = TransferLatency;
+    this->RealTime = RealTime;
+    return 0;
+}
+
+I2C_SimulatorStatistics I2C_SimulatedBus::GetStatistics() const
+{
+    return this->Statistics;
+}
+
+void I2C_SimulatedBus::ResetStatistics()
+{
+    memset(&this->Statistics, 0x00, sizeof(this->Statistics));
+}
+
+int I2C_SimulatedBus::SelectAddress(const int Address)
+{
+    if((Address < 0) | (Address > 0x7F))
+        return -EINVAL;
+
+    this->Statistics.AddressSelects++;
+    this->Address = Address;
+    return 0;
+}
+
+int I2C_SimulatedBus::SMBusAccess(const char ReadWrite,
+                                  const uint8_t Command,
+                                  const int Size,
+                                  union i2c_smbus_data* const Data)
+{
+    if(this->Address < 0)
+        return -ENXIO;
+
+    uint8_t buf[I2C_SMBUS_BLOCK_MAX + 1];
+    struct i2c_msg msgs[2];
+    int Count = 1;
+    int Length = 0;
+
+    // Command byte, followed by the data on writes. Reads are done with a repeated START.
+    buf[0] = Command;
+    msgs[0].addr = (__u16)this->Address;
+    msgs[0].flags = 0;
+    msgs[0].len = 1;
+    msgs[0].buf = buf;
+
+    switch(Size)
+    {
+    case I2C_SMBUS_BYTE:
+        if(ReadWrite == I2C_SMBUS_READ)
+            msgs[0].flags = I2C_M_RD;
+        break;
+    case I2C_SMBUS_BYTE_DATA:
+        Length = 1;
+        buf[1] = Data->byte;
+        break;
+    case I2C_SMBUS_WORD_DATA:
+        Length = 2;
+        buf[1] = (uint8_t)(Data->word & 0xFF);
+        buf[2] = (uint8_t)(Data->word >> 8);
+        break;
+    case I2C_SMBUS_I2C_BLOCK_DATA:
+        Length = (Data->block[0] > I2C_SMBUS_BLOCK_MAX) ? I2C_SMBUS_BLOCK_MAX : Data->block[0];
+        memcpy(&buf[1], &Data->block[1], Length);
+        break;
+    default:
+        return -EOPNOTSUPP;
+    }
+
+    if((Size != I2C_SMBUS_BYTE) & (ReadWrite == I2C_SMBUS_WRITE))
+        msgs[0].len = (__u16)(Length + 1);
+    else if(Size != I2C_SMBUS_BYTE)
+    {
+        msgs[1].addr = (__u16)this->Address;
+        msgs[1].flags = I2C_M_RD;
+        msgs[1].len = (__u16)Length;
+        msgs[1].buf = &buf[1];
+        Count = 2;
+    }
+
+    int res = this->Transfer(msgs, Count);
+    if((res < 0) | (ReadWrite == I2C_SMBUS_WRITE))
+        return res;
+
+    // SMBus words are sent LSB first.
+    switch(Size)
+    {
+    case I2C_SMBUS_BYTE:
+        Data->byte = buf[0];
+        break;
+    case I2C_SMBUS_BYTE_DATA:
+        Data->byte = buf[1];
+        break;
+    case I2C_SMBUS_WORD_DATA:
+        Data->word = (__u16)(buf[1] | (buf[2] << 8));
+        break;
+    case I2C_SMBUS_I2C_BLOCK_DATA:
+        memcpy(&Data->block[1], &buf[1], Length);
+        break;
+    }
+    return 0;
+}
+
+int I2C_SimulatedBus::Transfer(struct i2c_msg* const Messages, const int Count)
+{
+    this->Statistics.Transfers++;
+
+    for(int i = 0; i < Count; i++)
+    {
+        int Address = Messages[i].addr & 0x7F;
+        I2C_DeviceModel* Device = this->Devices[Address];
+        this->Statistics.Messages++;
+
+        // Address NACK : the transfer is aborted here.
+        int res = -ENXIO;
+        if((Device != nullptr) && (this->Nacks[Address] == 0))
+        {
+            if(Messages[i].flags & I2C_M_RD)
+                res = Device->Read(Messages[i].buf, Messages[i].len);
+            else
+                res = Device->Write(Messages[i].buf, Messages[i].len);
+        }
+        else if(this->Nacks[Address] > 0)
+            this->Nacks[Address]--;
+
+        if(res < 0)
+        {
+            this->Statistics.Nacks++;
+            this->Elapse(Messages, i + 1);
+            return res;
+        }
+        this->Statistics.Bytes += Messages[i].len;
+    }
+
+    this->Elapse(Messages, Count);
+    return 0;
+}
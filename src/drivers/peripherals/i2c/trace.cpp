@@ -0,0 +1,353 @@
+/**
+ * @file trace.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define the instrumentation of the I2C engine.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @remark Transactions are serialized by the engine (arbiter worker, or a single user thread), thus counters are
+ *         updated with relaxed loads and stores rather than read-modify-write operations. Readers may run from any
+ *         thread.
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+// Header
+#include "drivers/peripherals/core/I2C_Trace.hpp"
+
+// STD
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef I2C_TRACE
+
+// ==============================================================================
+// DATA STRUCTURES
+// ==============================================================================
+
+/*! Counters of a device, or of a register*/
+struct I2C_TraceSlot
+{
+    std::atomic<uint64_t> Transactions;
+    std::atomic<uint64_t> Bytes;
+    std::atomic<uint64_t> Errors;
+    std::atomic<uint64_t> TotalLatency;
+    std::atomic<uint32_t> Histogram[I2C_TRACE_BUCKETS];
+};
+
+/*! Counters of a device. The per register table is only allocated on the first access*/
+struct I2C_TraceDevice
+{
+    I2C_TraceSlot Counters;
+    std::atomic<I2C_TraceSlot*> Registers;
+};
+
+/*! Instrumentation of a bus*/
+struct I2C_Trace
+{
+    I2C_TraceDevice Devices[128];
+    std::atomic<uint64_t> Head;
+    I2C_TraceRecord Records[I2C_TRACE_RECORDS];
+};
+
+// ==============================================================================
+// PRIVATE FUNCTIONS
+// ==============================================================================
+
+// ------------------------------------------------------------------------------
+static inline void I2C_TraceIncrement(std::atomic<uint64_t>& Counter, const uint64_t Value)
+{
+    Counter.store(Counter.load(std::memory_order_relaxed) + Value, std::memory_order_relaxed);
+}
+
+// ------------------------------------------------------------------------------
+static inline void I2C_TraceAccount(I2C_TraceSlot* const Slot,
+                                    const int Bytes,
+                                    const int Result,
+                                    const uint64_t Latency,
+                                    const int Bucket)
+{
+    I2C_TraceIncrement(Slot->Transactions, 1);
+    I2C_TraceIncrement(Slot->Bytes, Bytes);
+    I2C_TraceIncrement(Slot->TotalLatency, Latency);
+    if(Result < 0)
+        I2C_TraceIncrement(Slot->Errors, 1);
+
+    std::atomic<uint32_t>& Histogram = Slot->Histogram[Bucket];
+    Histogram.store(Histogram.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+// ------------------------------------------------------------------------------
+static void I2C_TraceRead(const I2C_TraceSlot* const Slot, I2C_TraceCounters* const Counters)
+{
+    Counters->Transactions = Slot->Transactions.load(std::memory_order_relaxed);
+    Counters->Bytes = Slot->Bytes.load(std::memory_order_relaxed);
+    Counters->Errors = Slot->Errors.load(std::memory_order_relaxed);
+    Counters->TotalLatency = Slot->TotalLatency.load(std::memory_order_relaxed);
+    for(int i = 0; i < I2C_TRACE_BUCKETS; i++)
+        Counters->Histogram[i] = Slot->Histogram[i].load(std::memory_order_relaxed);
+}
+
+// ------------------------------------------------------------------------------
+static void I2C_TraceClear(I2C_TraceSlot* const Slot)
+{
+    Slot->Transactions.store(0, std::memory_order_relaxed);
+    Slot->Bytes.store(0, std::memory_order_relaxed);
+    Slot->Errors.store(0, std::memory_order_relaxed);
+    Slot->TotalLatency.store(0, std::memory_order_relaxed);
+    for(int i = 0; i < I2C_TRACE_BUCKETS; i++)
+        Slot->Histogram[i].store(0, std::memory_order_relaxed);
+}
+
+// ==============================================================================
+// FUNCTIONS
+// ==============================================================================
+
+// ------------------------------------------------------------------------------
+I2C_Trace* I2C_TraceCreate()
+{
+    I2C_Trace* Trace = new I2C_Trace;
+
+    for(int i = 0; i < 128; i++)
+    {
+        I2C_TraceClear(&Trace->Devices[i].Counters);
+        Trace->Devices[i].Registers.store(nullptr);
+    }
+    Trace->Head.store(0);
+    memset(Trace->Records, 0x00, sizeof(Trace->Records));
+
+    return Trace;
+}
+
+// ------------------------------------------------------------------------------
+void I2C_TraceDestroy(I2C_Trace* Trace)
+{
+    if(Trace == nullptr)
+        return;
+
+    for(int i = 0; i < 128; i++)
+        delete[] Trace->Devices[i].Registers.load();
+    delete Trace;
+}
+
+// ------------------------------------------------------------------------------
+uint64_t I2C_TraceNow()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// ------------------------------------------------------------------------------
+void I2C_TraceTransaction(I2C_Trace* const Trace,
+                          const int Address,
+                          const int Register,
+                          const int Bytes,
+                          const int Result,
+                          const uint64_t Start)
+{
+    uint64_t Latency = I2C_TraceNow() - Start;
+
+    // log2 buckets, starting at 1 us.
+    int Bucket = (int)std::bit_width(Latency) - 11;
+    if(Bucket < 0)
+        Bucket = 0;
+    if(Bucket >= I2C_TRACE_BUCKETS)
+        Bucket = I2C_TRACE_BUCKETS - 1;
+
+    I2C_TraceDevice* Device = &Trace->Devices[Address & 0x7F];
+    I2C_TraceAccount(&Device->Counters, Bytes, Result, Latency, Bucket);
+
+    // Per register table, allocated once per device.
+    I2C_TraceSlot* Registers = Device->Registers.load(std::memory_order_acquire);
+    if(Registers == nullptr)
+    {
+        Registers = new I2C_TraceSlot[256];
+        for(int i = 0; i < 256; i++)
+            I2C_TraceClear(&Registers[i]);
+        Device->Registers.store(Registers, std::memory_order_release);
+    }
+    I2C_TraceAccount(&Registers[Register & 0xFF], Bytes, Result, Latency, Bucket);
+
+    // Ring buffer
+    uint64_t Head = Trace->Head.load(std::memory_order_relaxed);
+    I2C_TraceRecord* Record = &Trace->Records[Head & (I2C_TRACE_RECORDS - 1)];
+    Record->Timestamp = Start;
+    Record->Latency = (Latency > UINT32_MAX) ? UINT32_MAX : (uint32_t)Latency;
+    Record->Bytes = (uint16_t)Bytes;
+    Record->Address = (uint8_t)Address;
+    Record->Register = (uint8_t)Register;
+    Record->Result = Result;
+    Record->Reserved = 0;
+    Trace->Head.store(Head + 1, std::memory_order_release);
+}
+
+// ------------------------------------------------------------------------------
+int I2C_TraceGetDevice(I2C_Bus* I2C, const int Address, I2C_TraceCounters* const Counters)
+{
+    I2C_Trace* Trace = I2C->Context->Trace;
+    if(Trace == nullptr)
+        return -1;
+    if((Address < 0) | (Address > 0x7F))
+        return -2;
+
+    I2C_TraceRead(&Trace->Devices[Address].Counters, Counters);
+    return 0;
+}
+
+// ------------------------------------------------------------------------------
+int I2C_TraceGetRegister(I2C_Bus* I2C,
+                         const int Address,
+                         const int Register,
+                         I2C_TraceCounters* const Counters)
+{
+    I2C_Trace* Trace = I2C->Context->Trace;
+    if(Trace == nullptr)
+        return -1;
+    if((Address < 0) | (Address > 0x7F))
+        return -2;
+    if((Register < 0) | (Register > 0xFF))
+        return -3;
+
+    I2C_TraceSlot* Registers = Trace->Devices[Address].Registers.load(std::memory_order_acquire);
+    if(Registers == nullptr)
+    {
+        memset(Counters, 0x00, sizeof(I2C_TraceCounters));
+        return 0;
+    }
+
+    I2C_TraceRead(&Registers[Register], Counters);
+    return 0;
+}
+
+// ------------------------------------------------------------------------------
+int I2C_TraceDump(I2C_Bus* I2C, const char* const Filename)
+{
+    I2C_Trace* Trace = I2C->Context->Trace;
+    if(Trace == nullptr)
+        return -1;
+
+    uint64_t Head = Trace->Head.load(std::memory_order_acquire);
+    uint64_t Count = (Head < I2C_TRACE_RECORDS) ? Head : I2C_TRACE_RECORDS;
+
+    I2C_TraceHeader Header;
+    Header.Magic = I2C_TRACE_MAGIC;
+    Header.Version = 1;
+    Header.RecordSize = sizeof(I2C_TraceRecord);
+    Header.Count = (uint32_t)Count;
+    Header.Lost = (uint32_t)(Head - Count);
+
+    FILE* File = fopen(Filename, "wb");
+    if(File == nullptr)
+        return -2;
+
+    size_t res = fwrite(&Header, sizeof(Header), 1, File);
+
+    // Oldest first : the ring may be split in two parts.
+    uint64_t First = (Head - Count) & (I2C_TRACE_RECORDS - 1);
+    uint64_t Tail = (First + Count > I2C_TRACE_RECORDS) ? I2C_TRACE_RECORDS - First : Count;
+    res += fwrite(&Trace->Records[First], sizeof(I2C_TraceRecord), Tail, File);
+    res += fwrite(&Trace->Records[0], sizeof(I2C_TraceRecord), Count - Tail, File);
+
+    if((fclose(File) != 0) | (res != Count + 1))
+        return -2;
+    return 0;
+}
+
+// ------------------------------------------------------------------------------
+int I2C_TraceReset(I2C_Bus* I2C)
+{
+    I2C_Trace* Trace = I2C->Context->Trace;
+    if(Trace == nullptr)
+        return -1;
+
+    for(int i = 0; i < 128; i++)
+    {
+        I2C_TraceClear(&Trace->Devices[i].Counters);
+        I2C_TraceSlot* Registers = Trace->Devices[i].Registers.load(std::memory_order_acquire);
+        if(Registers != nullptr)
+            for(int j = 0; j < 256; j++)
+                I2C_TraceClear(&Registers[j]);
+    }
+    Trace->Head.store(0, std::memory_order_release);
+    return 0;
+}
+
+#else
+
+// ==============================================================================
+// FUNCTIONS (Tracing compiled out)
+// ==============================================================================
+
+I2C_Trace* I2C_TraceCreate()
+{
+    return nullptr;
+}
+
+void I2C_TraceDestroy(I2C_Trace* Trace)
+{
+    (void)Trace;
+}
+
+uint64_t I2C_TraceNow()
+{
+    return 0;
+}
+
+void I2C_TraceTransaction(I2C_Trace* const Trace,
+                          const int Address,
+                          const int Register,
+                          const int Bytes,
+                          const int Result,
+                          const uint64_t Start)
+{
+    (void)Trace;
+    (void)Address;
+    (void)Register;
+    (void)Bytes;
+    (void)Result;
+    (void)Start;
+}
+
+int I2C_TraceGetDevice(I2C_Bus* I2C, const int Address, I2C_TraceCounters* const Counters)
+{
+    (void)I2C;
+    (void)Address;
+    (void)Counters;
+    return -1;
+}
+
+int I2C_TraceGetRegister(I2C_Bus* I2C,
+                         const int Address,
+                         const int Register,
+                         I2C_TraceCounters* const Counters)
+{
+    (void)I2C;
+    (void)Address;
+    (void)Register;
+    (void)Counters;
+    return -1;
+}
+
+int I2C_TraceDump(I2C_Bus* I2C, const char* const Filename)
+{
+    (void)I2C;
+    (void)Filename;
+    return -1;
+}
+
+int I2C_TraceReset(I2C_Bus* I2C)
+{
+    (void)I2C;
+    return -1;
+}
+
+#endif
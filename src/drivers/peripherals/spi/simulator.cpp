@@ -0,0 +1,312 @@
+/**
+ * @file simulator.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Define in-memory SPI devices, to run the drivers on the host (unit tests, benchmarks).
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+// Header
+#include "drivers/peripherals/core/SPI_Simulator.hpp"
+
+// STD
+#include <algorithm>
+#include <cstdint>
+#include <errno.h>
+#include <string.h>
+
+// ==============================================================================
+// PRIVATE DEFINES
+// ==============================================================================
+constexpr uint8_t WREN = 0x06;
+constexpr uint8_t WRDI = 0x04;
+constexpr uint8_t RDSR = 0x05;
+constexpr uint8_t WRSR = 0x01;
+constexpr uint8_t READ = 0x03;
+constexpr uint8_t WRITE = 0x02;
+
+constexpr int COMMAND_SIZE = 3; // Opcode and 2 bytes address
+
+// ==============================================================================
+// EEPROM
+// ==============================================================================
+
+// =====================
+// CONSTRUCTORS
+// =====================
+
+SPI_EepromModel::SPI_EepromModel(const int Size, const int PageSize)
+{
+    this->Memory.assign(Size, 0xFF);
+    this->PageSize = PageSize;
+    this->Status = 0x00;
+    this->WriteEnabled = false;
+    this->Cycle = 0;
+    this->CycleEnd = std::chrono::steady_clock::now();
+    this->Failures = 0;
+    this->Skipped = 0;
+    this->Remaining = -1;
+    this->Torn = false;
+    this->Powered = true;
+    this->Held = false;
+    this->Waiting = 0;
+    return;
+}
+
+// =====================
+// PRIVATES
+// =====================
+
+bool SPI_EepromModel::Busy() const
+{
+    return std::chrono::steady_clock::now() < this->CycleEnd;
+}
+
+void SPI_EepromModel::Program(const int Address, const uint8_t* const Data, const int Len)
+{
+    int Count = Len;
+
+    // The power is lost during this write cycle.
+    if(this->Remaining == 0)
+    {
+        this->Powered = false;
+        this->Remaining = -1;
+        if(!this->Torn)
+            return;
+        Count = Len / 2;
+    }
+    else if(this->Remaining > 0)
+        this->Remaining--;
+
+    // The address counter wrap within the page.
+    const int Page = Address - (Address % this->PageSize);
+    for(int i = 0; i < Count; i++)
+        this->Memory[Page + ((Address + i) % this->PageSize)] = Data[i];
+    return;
+}
+
+// =====================
+// FUNCTIONS
+// =====================
+
+void SPI_EepromModel::SetCycle(const long Cycle)
+{
+    std::lock_guard<std::mutex> Guard(this->Lock);
+    this->Cycle = Cycle;
+    return;
+}
+
+void SPI_EepromModel::InjectFailure(const int Count, const int After)
+{
+    std::lock_guard<std::mutex> Guard(this->Lock);
+    this->Failures = Count;
+    this->Skipped = After;
+    return;
+}
+
+void SPI_EepromModel::CutPower(const int Pages, const bool Torn)
+{
+    std::lock_guard<std::mutex> Guard(this->Lock);
+    this->Remaining = Pages;
+    this->Torn = Torn;
+    return;
+}
+
+void SPI_EepromModel::Restore()
+{
+    std::lock_guard<std::mutex> Guard(this->Lock);
+    this->Powered = true;
+    this->Remaining = -1;
+    this->WriteEnabled = false;
+    this->CycleEnd = std::chrono::steady_clock::now();
+    return;
+}
+
+void SPI_EepromModel::Hold()
+{
+    std::lock_guard<std::mutex> Guard(this->Lock);
+    this->Held = true;
+    return;
+}
+
+void SPI_EepromModel::WaitHeld()
+{
+    std::unique_lock<std::mutex> Guard(this->Lock);
+    this->Resume.wait(Guard, [this] { return this->Waiting > 0; });
+    return;
+}
+
+void SPI_EepromModel::Release()
+{
+    std::lock_guard<std::mutex> Guard(this->Lock);
+    this->Held = false;
+    this->Resume.notify_all();
+    return;
+}
+
+bool SPI_EepromModel::IsPowered()
+{
+    std::lock_guard<std::mutex> Guard(this->Lock);
+    return this->Powered;
+}
+
+void SPI_EepromModel::Peek(const int Address, uint8_t* const Data, const int Len)
+{
+    std::lock_guard<std::mutex> Guard(this->Lock);
+    memcpy(Data, &this->Memory[Address], Len);
+    return;
+}
+
+void SPI_EepromModel::Poke(const int Address, const uint8_t* const Data, const int Len)
+{
+    std::lock_guard<std::mutex> Guard(this->Lock);
+    memcpy(&this->Memory[Address], Data, Len);
+    return;
+}
+
+std::vector<int> SPI_EepromModel::GetLog()
+{
+    std::lock_guard<std::mutex> Guard(this->Lock);
+    return this->Log;
+}
+
+void SPI_EepromModel::ClearLog()
+{
+    std::lock_guard<std::mutex> Guard(this->Lock);
+    this->Log.clear();
+    return;
+}
+
+void SPI_EepromModel::Select()
+{
+    std::lock_guard<std::mutex> Guard(this->Lock);
+    this->Frame.clear();
+    return;
+}
+
+int SPI_EepromModel::Exchange(const uint8_t* const TX, uint8_t* const RX, const int Len)
+{
+    std::unique_lock<std::mutex> Guard(this->Lock);
+    if(!this->Powered)
+        return -EIO;
+
+    for(int i = 0; i < Len; i++)
+    {
+        const int Index = (int)this->Frame.size();
+        this->Frame.push_back((TX != nullptr) ? TX[i] : 0x00);
+
+        if((Index == 0) & (this->Frame[0] == WRITE) & (this->Held))
+        {
+            this->Waiting++;
+            this->Resume.notify_all();
+            this->Resume.wait(Guard, [this] { return !this->Held; });
+            this->Waiting--;
+        }
+
+        // A failed write is detected by the master, and never reach the array.
+        if((Index == 0) & (this->Frame[0] == WRITE) & (this->Failures > 0) & (this->Skipped > 0))
+            this->Skipped--;
+        else if((Index == 0) & (this->Frame[0] == WRITE) & (this->Failures > 0))
+        {
+            this->Failures--;
+            this->Frame.clear();
+            return -EIO;
+        }
+
+        // Data is shifted out as soon as the command, and the address, are known.
+        uint8_t Out = 0xFF;
+        if((this->Frame[0] == RDSR) & (Index >= 1))
+            Out = this->Status | (this->WriteEnabled << 1) | (uint8_t)this->Busy();
+        else if((this->Frame[0] == READ) & (Index >= COMMAND_SIZE) & (!this->Busy()))
+        {
+            const int Address = (this->Frame[1] << 8) | this->Frame[2];
+            Out = this->Memory[(Address + Index - COMMAND_SIZE) % this->Memory.size()];
+        }
+
+        if(RX != nullptr)
+            RX[i] = Out;
+    }
+    return 0;
+}
+
+void SPI_EepromModel::Deselect()
+{
+    std::lock_guard<std::mutex> Guard(this->Lock);
+    if((this->Frame.empty()) | (!this->Powered))
+        return;
+
+    // Only RDSR is answered during a write cycle.
+    if(this->Busy())
+        return;
+
+    const int Size = (int)this->Frame.size();
+    switch(this->Frame[0])
+    {
+    case WREN:
+        this->WriteEnabled = true;
+        break;
+
+    case WRDI:
+        this->WriteEnabled = false;
+        break;
+
+    case WRSR:
+        if((!this->WriteEnabled) | (Size < 2))
+            break;
+        this->Status = this->Frame[1] & 0x8C;
+        this->WriteEnabled = false;
+        this->CycleEnd = std::chrono::steady_clock::now() + std::chrono::microseconds(this->Cycle);
+        break;
+
+    case WRITE: {
+        if((!this->WriteEnabled) | (Size <= COMMAND_SIZE))
+            break;
+        const int Address = ((this->Frame[1] << 8) | this->Frame[2]) % this->Memory.size();
+        this->Log.push_back(Address);
+        this->Program(Address, &this->Frame[COMMAND_SIZE], std::min(Size - COMMAND_SIZE, this->PageSize));
+        this->WriteEnabled = false;
+        this->CycleEnd = std::chrono::steady_clock::now() + std::chrono::microseconds(this->Cycle);
+        break;
+    }
+
+    default:
+        break;
+    }
+    return;
+}
+
+// ==============================================================================
+// FUNCTIONS
+// ==============================================================================
+
+int SPI_SimulateTransfer(SPI_DeviceModel* const Model,
+                         const struct spi_ioc_transfer* const Segments,
+                         const int Count)
+{
+    Model->Select();
+    for(int i = 0; i < Count; i++)
+    {
+        int res = Model->Exchange(
+            (const uint8_t*)Segments[i].tx_buf, (uint8_t*)Segments[i].rx_buf, (int)Segments[i].len);
+        if(res < 0)
+        {
+            Model->Deselect();
+            return res;
+        }
+
+        // As spidev, cs_change on the last segment would keep CS asserted : ignored here.
+        if((Segments[i].cs_change != 0) & (i < Count - 1))
+        {
+            Model->Deselect();
+            Model->Select();
+        }
+    }
+    Model->Deselect();
+    return 0;
+}
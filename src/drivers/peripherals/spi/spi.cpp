@@ -14,12 +14,14 @@
 // ==============================================================================
 // Header
 #include "drivers/peripherals/spi.hpp"
+#include "drivers/peripherals/core/SPI_Simulator.hpp"
 
 // STD
 #include <cstdint>
 #include <errno.h>
 #include <fcntl.h>
 #include <iostream>
+#include <span>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -27,46 +29,10 @@
 #include <unistd.h>
 
 // ==============================================================================
-// FUNCTIONS
+// PRIVATE FUNCTIONS
 // ==============================================================================
 
-SPI_Bus* SPI_GetInfos(SPI_SLAVES CS)
-{
-    SPI_Bus* SPI = new SPI_Bus;
-
-    // Set up variables
-    SPI->CS_number = (int)CS;
-    SPI->SPI_Bus = (int)SPI_SETTINGS::BUS_NUMBER;
-
-    snprintf(SPI->SPI_Filename,
-             sizeof(SPI->SPI_Filename),
-             "/dev/spidev%d.%d",
-             SPI->SPI_Bus,
-             SPI->CS_number);
-
-    SPI->SPI_Filename[sizeof(SPI->SPI_Filename) - 1] = '\0';
-
-    // Open the file
-    SPI->SPI_file = open(SPI->SPI_Filename, O_RDWR);
-
-    if(SPI->SPI_file < 0)
-    {
-        std::cerr << "[ SPI ][ GetInfos ] : Could not open the requested SPI bus : "
-                  << strerror(errno) << std::endl;
-        SPI->SPI_file = (int)NULL;
-    }
-
-    return SPI;
-}
-
-int SPI_Close(SPI_Bus* SPI)
-{
-    close(SPI->SPI_file);
-    delete SPI;
-    return 0;
-}
-
-int SPI_Configure(SPI_Bus* SPI, int Mode, int WordSize, int Speed)
+static int ConfigureDevice(SPI_Bus* SPI, int Mode, int WordSize, int Speed)
 {
     int res = 0;
 
@@ -118,6 +84,87 @@ int SPI_Configure(SPI_Bus* SPI, int Mode, int WordSize, int Speed)
         return -3;
     }
 
+    return 0;
+}
+
+// ==============================================================================
+// FUNCTIONS
+// ==============================================================================
+
+SPI_Bus* SPI_GetInfos(SPI_SLAVES CS)
+{
+    SPI_Bus* SPI = new SPI_Bus;
+
+    // Set up variables
+    SPI->CS_number = (int)CS;
+    SPI->SPI_Bus = (int)SPI_SETTINGS::BUS_NUMBER;
+    SPI->Model = nullptr;
+
+    snprintf(SPI->SPI_Filename,
+             sizeof(SPI->SPI_Filename),
+             "/dev/spidev%d.%d",
+             SPI->SPI_Bus,
+             SPI->CS_number);
+
+    SPI->SPI_Filename[sizeof(SPI->SPI_Filename) - 1] = '\0';
+
+    // Open the file
+    SPI->SPI_file = open(SPI->SPI_Filename, O_RDWR);
+
+    if(SPI->SPI_file < 0)
+    {
+        std::cerr << "[ SPI ][ GetInfos ] : Could not open the requested SPI bus : "
+                  << strerror(errno) << std::endl;
+        SPI->SPI_file = (int)NULL;
+    }
+
+    // The kernel buffer size may be raised with the spidev.bufsiz module parameter.
+    SPI->bufsiz = 0;
+    FILE* bufsiz = fopen("/sys/module/spidev/parameters/bufsiz", "r");
+    if(bufsiz != nullptr)
+    {
+        if(fscanf(bufsiz, "%u", &SPI->bufsiz) != 1)
+            SPI->bufsiz = 0;
+        fclose(bufsiz);
+    }
+
+    return SPI;
+}
+
+SPI_Bus* SPI_Open(SPI_DeviceModel* const Model)
+{
+    SPI_Bus* SPI = new SPI_Bus;
+
+    SPI->SPI_file = -1;
+    snprintf(SPI->SPI_Filename, sizeof(SPI->SPI_Filename), "simulator");
+    SPI->SPI_Bus = (int)SPI_SETTINGS::BUS_NUMBER;
+    SPI->CS_number = 0;
+    SPI->bufsiz = 0;
+    SPI->Model = Model;
+
+    SPI_Configure(
+        SPI, (int)SPI_SETTINGS::BUS_MODE, (int)SPI_SETTINGS::BUS_WORD_SIZE, (int)SPI_SETTINGS::BUS_SPEED);
+    return SPI;
+}
+
+int SPI_Close(SPI_Bus* SPI)
+{
+    if(SPI->Model == nullptr)
+        close(SPI->SPI_file);
+    delete SPI;
+    return 0;
+}
+
+int SPI_Configure(SPI_Bus* SPI, int Mode, int WordSize, int Speed)
+{
+    // A simulated slave accept any settings.
+    if(SPI->Model == nullptr)
+    {
+        int res = ConfigureDevice(SPI, Mode, WordSize, Speed);
+        if(res != 0)
+            return res;
+    }
+
     // Store configuration settings for future use.
     SPI->speed = (unsigned int)Speed;
     SPI->tx_nbits = (unsigned char)1;
@@ -128,3 +175,102 @@ int SPI_Configure(SPI_Bus* SPI, int Mode, int WordSize, int Speed)
 
     return 0;
 }
+
+int SPI_GetMaxTransfer(const SPI_Bus* SPI)
+{
+    if(SPI->bufsiz == 0)
+        return SPI_MAX_TRANSFER;
+    return (int)SPI->bufsiz;
+}
+
+int SPI_Transfer(SPI_Bus* SPI, const std::span<const uint8_t> TX, const std::span<uint8_t> RX)
+{
+    SPI_Transaction Transaction;
+    SPI_TransactionInit(&Transaction);
+
+    int res = SPI_TransactionAppend(&Transaction, TX, RX);
+    if(res == -1)
+    {
+        std::cerr << "[ SPI ][ Transfer ] : TX and RX buffers are of different sizes on bus "
+                  << SPI->SPI_Bus << std::endl;
+        return -1;
+    }
+
+    if(SPI_TransactionSubmit(SPI, &Transaction) != 0)
+        return -2;
+    return 0;
+}
+
+int SPI_TransactionInit(SPI_Transaction* const Transaction)
+{
+    Transaction->SegmentCount = 0;
+    Transaction->Length = 0;
+    return 0;
+}
+
+int SPI_TransactionAppend(SPI_Transaction* const Transaction,
+                          const std::span<const uint8_t> TX,
+                          const std::span<uint8_t> RX,
+                          const bool Release)
+{
+    if((!TX.empty()) & (!RX.empty()) & (TX.size() != RX.size()))
+        return -1;
+    if(Transaction->SegmentCount >= SPI_MAX_SEGMENTS)
+        return -2;
+
+    const size_t Len = TX.empty() ? RX.size() : TX.size();
+
+    // The kernel handle a null pointer as "no data" : zeros are sent, or nothing is stored.
+    // Bus settings are filled on submission.
+    struct spi_ioc_transfer* segment = &Transaction->Segments[Transaction->SegmentCount++];
+    memset(segment, 0x00, sizeof(struct spi_ioc_transfer));
+    segment->tx_buf = (unsigned long)TX.data();
+    segment->rx_buf = (unsigned long)RX.data();
+    segment->len = (unsigned int)Len;
+    segment->cs_change = (unsigned char)Release;
+    Transaction->Length += Len;
+
+    return 0;
+}
+
+int SPI_TransactionSubmit(SPI_Bus* SPI, SPI_Transaction* const Transaction)
+{
+    if(Transaction->SegmentCount == 0)
+        return 0;
+    if(Transaction->Length > SPI_GetMaxTransfer(SPI))
+    {
+        std::cerr << "[ SPI ][ Transfer ] : Transaction of " << Transaction->Length
+                  << " bytes is too long for bus " << SPI->SPI_Bus << std::endl;
+        return -3;
+    }
+
+    for(int i = 0; i < Transaction->SegmentCount; i++)
+    {
+        struct spi_ioc_transfer* segment = &Transaction->Segments[i];
+        segment->speed_hz = SPI->speed;
+        segment->delay_usecs = SPI->delay;
+        segment->bits_per_word = SPI->bits;
+        segment->tx_nbits = SPI->tx_nbits;
+        segment->rx_nbits = SPI->rx_nbits;
+        segment->word_delay_usecs = SPI->delay;
+    }
+
+    // Perform IOCTL, or hand the segments to the simulated slave.
+    int res = 0;
+    if(SPI->Model != nullptr)
+    {
+        res = SPI_SimulateTransfer(SPI->Model, Transaction->Segments, Transaction->SegmentCount);
+        if(res < 0)
+            errno = -res;
+    }
+    else
+        res = ioctl(SPI->SPI_file, SPI_IOC_MESSAGE(Transaction->SegmentCount), Transaction->Segments);
+    if(res < 0)
+    {
+        std::cerr << "[ SPI ][ Transfer ] : Could not perform transfer operation on bus "
+                  << SPI->SPI_Bus << " : " << strerror(errno) << std::endl;
+        return -4;
+    }
+
+    return 0;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file TEST_EQ.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Source for unittesting the parametric EQ compiler.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+
+// Including the unit test framework
+#include "CppUTest/TestHarness.h"
+
+// Include the tested header
+#include "modules/dsp/eq/eq.hpp"
+
+// STD
+#include <cmath>
+
+// ==============================================================================
+// HELPERS
+// ==============================================================================
+
+// Read back a formatted coefficient.
+static double Coefficient(const uint8_t* const Out, const int Index)
+{
+    const uint8_t* Bytes = &Out[Index * EQ_COEFFICIENT_WIDTH];
+    const int Word = (Bytes[0] << 16) | (Bytes[1] << 8) | Bytes[2];
+    return ((Word ^ 0x800000) - 0x800000) / 1048576.0;
+}
+
+// Gain at DC of the quantized biquad, in dB.
+static double DCGain(const uint8_t* const Out, const int Band)
+{
+    const int i = Band * EQ_BIQUAD_COEFFICIENTS;
+    const double Num = Coefficient(Out, i) + Coefficient(Out, i + 1) + Coefficient(Out, i + 2);
+    const double Den = 1.0 - Coefficient(Out, i + 3) - Coefficient(Out, i + 4);
+    return 20.0 * log10(fabs(Num / Den));
+}
+
+// ==============================================================================
+// TEST GROUPS
+// ==============================================================================
+
+TEST_GROUP(DSP_EQ){};
+
+// ==============================================================================
+// TESTS
+// ==============================================================================
+
+TEST(DSP_EQ, FlatBandIsAnIdentity)
+{
+    DSP_EQ Eq(48000.0f);
+    uint8_t Out[EQ_BIQUAD_COEFFICIENTS * EQ_COEFFICIENT_WIDTH];
+    EQ_REPORT Report;
+
+    LONGS_EQUAL(0, Eq.AddBand({EQ_FILTER::PEAKING, 1000.0f, 0.0f, 1.0f}));
+    LONGS_EQUAL(5, Eq.GetCoefficients());
+    LONGS_EQUAL(0, Eq.Compile(Out, &Report));
+
+    // b0 = 1.0, and the numerator match the denominator.
+    BYTES_EQUAL(0x10, Out[0]);
+    BYTES_EQUAL(0x00, Out[1]);
+    BYTES_EQUAL(0x00, Out[2]);
+    DOUBLES_EQUAL(Coefficient(Out, 1), -Coefficient(Out, 3), 1e-9);
+    DOUBLES_EQUAL(Coefficient(Out, 2), -Coefficient(Out, 4), 1e-9);
+    CHECK_TRUE(Report.Stable);
+    CHECK(Report.ResponseError < 0.001f);
+}
+
+TEST(DSP_EQ, BassBoostIsDesignedAtTheSampleRate)
+{
+    DSP_EQ Eq(48000.0f);
+    uint8_t Out[EQ_BIQUAD_COEFFICIENTS * EQ_COEFFICIENT_WIDTH];
+    EQ_REPORT Report;
+
+    LONGS_EQUAL(0, Eq.AddBand({EQ_FILTER::LOW_SHELF, 80.0f, 6.0f, 0.707f}));
+    LONGS_EQUAL(0, Eq.Compile(Out, &Report));
+
+    DOUBLES_EQUAL(6.0, DCGain(Out, 0), 0.05);
+    CHECK_TRUE(Report.Stable);
+    CHECK(Report.MaxError <= 0.5f / 1048576.0f);
+    CHECK(Report.ResponseError < 0.05f);
+
+    // The same band, at another rate, give other coefficients.
+    uint8_t Other[EQ_BIQUAD_COEFFICIENTS * EQ_COEFFICIENT_WIDTH];
+    LONGS_EQUAL(0, Eq.SetSampleRate(44100.0f));
+    LONGS_EQUAL(0, Eq.Compile(Other));
+    DOUBLES_EQUAL(6.0, DCGain(Other, 0), 0.1);
+    CHECK(Coefficient(Out, 3) != Coefficient(Other, 3));
+}
+
+TEST(DSP_EQ, CoarseQuantizationIsReported)
+{
+    DSP_EQ Eq(192000.0f);
+    uint8_t Out[EQ_BIQUAD_COEFFICIENTS * EQ_COEFFICIENT_WIDTH];
+    EQ_REPORT Report;
+
+    // Poles this close to z = 1 are only a few LSBits away from each other.
+    LONGS_EQUAL(0, Eq.AddBand({EQ_FILTER::HIGH_PASS, 20.0f, 0.0f, 0.707f}));
+    LONGS_EQUAL(0, Eq.Compile(Out, &Report));
+
+    CHECK_TRUE(Report.Stable);
+    CHECK(Report.MaxError <= 0.5f / 1048576.0f);
+    CHECK(Report.ResponseError > 1.0f);
+    CHECK(Report.Frequency < 100.0f);
+}
+
+TEST(DSP_EQ, InvalidBandsAreRejected)
+{
+    DSP_EQ Eq(48000.0f);
+    uint8_t Out[EQ_BIQUAD_COEFFICIENTS * EQ_COEFFICIENT_WIDTH];
+
+    LONGS_EQUAL(-1, Eq.AddBand({EQ_FILTER::PEAKING, 0.0f, 3.0f, 1.0f}));
+    LONGS_EQUAL(-1, Eq.AddBand({EQ_FILTER::PEAKING, 1000.0f, 3.0f, 0.0f}));
+    LONGS_EQUAL(-1, Eq.AddBand({EQ_FILTER::PEAKING, 1000.0f, 30.0f, 1.0f}));
+    LONGS_EQUAL(-1, Eq.SetSampleRate(0.0f));
+
+    // Above the Nyquist frequency.
+    LONGS_EQUAL(0, Eq.AddBand({EQ_FILTER::LOW_PASS, 30000.0f, 0.0f, 0.707f}));
+    LONGS_EQUAL(-1, Eq.Compile(Out));
+
+    // A shelf of +24 dB need a b0 above the 4.20 range.
+    Eq.Clear();
+    LONGS_EQUAL(0, Eq.AddBand({EQ_FILTER::HIGH_SHELF, 1000.0f, 24.0f, 0.707f}));
+    LONGS_EQUAL(-2, Eq.Compile(Out));
+
+    Eq.Clear();
+    for(int i = 0; i < EQ_MAX_BANDS; i++)
+        LONGS_EQUAL(0, Eq.AddBand({EQ_FILTER::PEAKING, 1000.0f, 1.0f, 1.0f}));
+    LONGS_EQUAL(-2, Eq.AddBand({EQ_FILTER::PEAKING, 1000.0f, 1.0f, 1.0f}));
+}
+
+TEST(DSP_EQ, ProfileBuffersAreBothWrote)
+{
+    char Name[MAX_PROFILE_CHAR] = "EQ";
+    DSP_PROFILE Profile(Name, DSP_PROFILE_SIZE::SMALL);
+    uint8_t Out[EQ_BIQUAD_COEFFICIENTS * EQ_COEFFICIENT_WIDTH];
+    uint8_t A[MAX_COEFF / 4 * 3];
+    uint8_t B[MAX_COEFF / 4 * 3];
+
+    DSP_EQ Eq(44100.0f, 2);
+    LONGS_EQUAL(0, Eq.AddBand({EQ_FILTER::PEAKING, 2500.0f, -4.0f, 2.0f}));
+    LONGS_EQUAL(0, Eq.Compile(Out));
+    LONGS_EQUAL(0, Eq.Compile(&Profile));
+
+    Profile.ReturnBufferAValues(A);
+    Profile.ReturnBufferBValues(B);
+    MEMCMP_EQUAL(Out, &A[2 * 3], sizeof(Out));
+    MEMCMP_EQUAL(Out, &B[2 * 3], sizeof(Out));
+    BYTES_EQUAL(0x00, A[0]);
+    BYTES_EQUAL(0x00, B[7 * 3]);
+
+    // The small profiles have 64 coefficients.
+    DSP_EQ Late(44100.0f, 60);
+    LONGS_EQUAL(0, Late.AddBand({EQ_FILTER::PEAKING, 2500.0f, -4.0f, 2.0f}));
+    LONGS_EQUAL(-3, Late.Compile(&Profile));
+}
@@ -0,0 +1,248 @@
+/**
+ * @file eq.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Source for the parametric EQ compiler.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+#include "modules/dsp/eq/eq.hpp"
+
+// Modules
+#include "modules/eeprom/dsp_profile/dsp_fixed.hpp"
+
+// STD
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstring>
+
+// ==============================================================================
+// CONSTANTS
+// ==============================================================================
+constexpr double ResponseFloor = 1e-12; // Smallest magnitude, to keep the zeros of the pass filters finite.
+
+// ==============================================================================
+// CONSTRUCTORS
+// ==============================================================================
+
+DSP_EQ::DSP_EQ(const float SampleRate, const int First)
+{
+    this->SampleRate = SampleRate;
+    this->First = First;
+    this->Count = 0;
+    memset(this->Bands, 0x00, sizeof(this->Bands));
+    return;
+}
+
+// ==============================================================================
+// PRIVATE
+// ==============================================================================
+
+void DSP_EQ::Design(const EQ_BAND& Band, const double Rate, double* const Coefficients)
+{
+    const double A = pow(10.0, Band.Gain / 40.0);
+    const double Omega = 2.0 * M_PI * Band.Frequency / Rate;
+    const double Cos = cos(Omega);
+    const double Alpha = sin(Omega) / (2.0 * Band.Q);
+    const double Shelf = 2.0 * sqrt(A) * Alpha;
+
+    double b0 = 1.0, b1 = 0.0, b2 = 0.0, a0 = 1.0, a1 = 0.0, a2 = 0.0;
+    switch(Band.Type)
+    {
+    case EQ_FILTER::PEAKING:
+        b0 = 1.0 + Alpha * A;
+        b1 = -2.0 * Cos;
+        b2 = 1.0 - Alpha * A;
+        a0 = 1.0 + Alpha / A;
+        a1 = -2.0 * Cos;
+        a2 = 1.0 - Alpha / A;
+        break;
+
+    case EQ_FILTER::LOW_SHELF:
+        b0 = A * ((A + 1.0) - (A - 1.0) * Cos + Shelf);
+        b1 = 2.0 * A * ((A - 1.0) - (A + 1.0) * Cos);
+        b2 = A * ((A + 1.0) - (A - 1.0) * Cos - Shelf);
+        a0 = (A + 1.0) + (A - 1.0) * Cos + Shelf;
+        a1 = -2.0 * ((A - 1.0) + (A + 1.0) * Cos);
+        a2 = (A + 1.0) + (A - 1.0) * Cos - Shelf;
+        break;
+
+    case EQ_FILTER::HIGH_SHELF:
+        b0 = A * ((A + 1.0) + (A - 1.0) * Cos + Shelf);
+        b1 = -2.0 * A * ((A - 1.0) + (A + 1.0) * Cos);
+        b2 = A * ((A + 1.0) + (A - 1.0) * Cos - Shelf);
+        a0 = (A + 1.0) - (A - 1.0) * Cos + Shelf;
+        a1 = 2.0 * ((A - 1.0) - (A + 1.0) * Cos);
+        a2 = (A + 1.0) - (A - 1.0) * Cos - Shelf;
+        break;
+
+    case EQ_FILTER::LOW_PASS:
+        b0 = (1.0 - Cos) / 2.0;
+        b1 = 1.0 - Cos;
+        b2 = (1.0 - Cos) / 2.0;
+        a0 = 1.0 + Alpha;
+        a1 = -2.0 * Cos;
+        a2 = 1.0 - Alpha;
+        break;
+
+    case EQ_FILTER::HIGH_PASS:
+        b0 = (1.0 + Cos) / 2.0;
+        b1 = -(1.0 + Cos);
+        b2 = (1.0 + Cos) / 2.0;
+        a0 = 1.0 + Alpha;
+        a1 = -2.0 * Cos;
+        a2 = 1.0 - Alpha;
+        break;
+    }
+
+    // Normalized, with the feedback terms as accumulated by the program.
+    Coefficients[0] = b0 / a0;
+    Coefficients[1] = b1 / a0;
+    Coefficients[2] = b2 / a0;
+    Coefficients[3] = -a1 / a0;
+    Coefficients[4] = -a2 / a0;
+    return;
+}
+
+double DSP_EQ::Response(const double* const Coefficients, const double Omega)
+{
+    const std::complex<double> z1 = std::polar(1.0, -Omega);
+    const std::complex<double> z2 = z1 * z1;
+
+    const std::complex<double> Num = Coefficients[0] + Coefficients[1] * z1 + Coefficients[2] * z2;
+    const std::complex<double> Den = 1.0 - Coefficients[3] * z1 - Coefficients[4] * z2;
+    return 20.0 * log10(std::max(std::abs(Num / Den), ResponseFloor));
+}
+
+// ==============================================================================
+// PUBLIC
+// ==============================================================================
+
+int DSP_EQ::SetSampleRate(const float SampleRate)
+{
+    if(!(SampleRate > 0.0f))
+        return -1;
+
+    this->SampleRate = SampleRate;
+    return 0;
+}
+
+int DSP_EQ::AddBand(const EQ_BAND& Band)
+{
+    if(!(Band.Frequency > 0.0f) | !(Band.Q > 0.0f) | !(std::fabs(Band.Gain) <= EQ_MAX_GAIN))
+        return -1;
+    if(this->Count == EQ_MAX_BANDS)
+        return -2;
+
+    this->Bands[this->Count++] = Band;
+    return 0;
+}
+
+void DSP_EQ::Clear()
+{
+    this->Count = 0;
+    return;
+}
+
+int DSP_EQ::GetCoefficients() const
+{
+    return this->Count * EQ_BIQUAD_COEFFICIENTS;
+}
+
+int DSP_EQ::Compile(uint8_t* const Out, EQ_REPORT* const Report)
+{
+    const double Rate = this->SampleRate;
+    const int Coefficients = this->GetCoefficients();
+    double Ideal[EQ_MAX_BANDS][EQ_BIQUAD_COEFFICIENTS];
+    double Quantized[EQ_MAX_BANDS][EQ_BIQUAD_COEFFICIENTS];
+    float Values[EQ_MAX_BANDS * EQ_BIQUAD_COEFFICIENTS];
+
+    for(int Band = 0; Band < this->Count; Band++)
+    {
+        if(this->Bands[Band].Frequency >= Rate / 2.0)
+            return -1;
+
+        Design(this->Bands[Band], Rate, Ideal[Band]);
+        for(int i = 0; i < EQ_BIQUAD_COEFFICIENTS; i++)
+            Values[Band * EQ_BIQUAD_COEFFICIENTS + i] = (float)Ideal[Band][i];
+    }
+
+    // Quantize every coefficient at once, then read back the values seen by the DSP.
+    if(DSP_PackFixedPoint4dot20(Values, Coefficients, Out) != 0)
+        return -2;
+    DSP_UnpackFixedPoint4dot20(Out, Coefficients, Values);
+
+    EQ_REPORT Result = {0.0f, 0, 0.0f, 0.0f, true};
+    double MaxError = 0.0;
+
+    for(int Band = 0; Band < this->Count; Band++)
+    {
+        for(int i = 0; i < EQ_BIQUAD_COEFFICIENTS; i++)
+        {
+            Quantized[Band][i] = Values[Band * EQ_BIQUAD_COEFFICIENTS + i];
+            const double Error = std::fabs(Quantized[Band][i] - Ideal[Band][i]);
+            if(Error > MaxError)
+            {
+                MaxError = Error;
+                Result.Worst = Band * EQ_BIQUAD_COEFFICIENTS + i;
+            }
+        }
+
+        // Stability triangle of 1 + a1 z^-1 + a2 z^-2, the feedback terms being stored negated.
+        const double a1 = -Quantized[Band][3];
+        const double a2 = -Quantized[Band][4];
+        if(!((std::fabs(a2) < 1.0) & (std::fabs(a1) < 1.0 + a2)))
+            Result.Stable = false;
+    }
+
+    if(Report == nullptr)
+        return 0;
+
+    // Response of the whole EQ, on a logarithmic grid up to 0.9 times the Nyquist frequency.
+    const double High = 0.45 * Rate;
+    const double Low = std::min((double)EQ_REPORT_LOW, High);
+    for(int Point = 0; Point < EQ_REPORT_POINTS; Point++)
+    {
+        const double Frequency = Low * pow(High / Low, (double)Point / (EQ_REPORT_POINTS - 1));
+        const double Omega = 2.0 * M_PI * Frequency / Rate;
+
+        double Difference = 0.0;
+        for(int Band = 0; Band < this->Count; Band++)
+            Difference += Response(Quantized[Band], Omega) - Response(Ideal[Band], Omega);
+
+        if(std::fabs(Difference) > Result.ResponseError)
+        {
+            Result.ResponseError = (float)std::fabs(Difference);
+            Result.Frequency = (float)Frequency;
+        }
+    }
+
+    Result.MaxError = (float)MaxError;
+    *Report = Result;
+    return 0;
+}
+
+int DSP_EQ::Compile(DSP_PROFILE* const Profile, EQ_REPORT* const Report)
+{
+    const int Len = this->GetCoefficients() * EQ_COEFFICIENT_WIDTH;
+    const int Offset = this->First * EQ_COEFFICIENT_WIDTH;
+    if((this->First < 0) | (Offset + Len > Profile->sizebufferA) | (Offset + Len > Profile->sizebufferB))
+        return -3;
+
+    uint8_t Coefficients[EQ_MAX_BANDS * EQ_BIQUAD_COEFFICIENTS * EQ_COEFFICIENT_WIDTH];
+    int ret = this->Compile(Coefficients, Report);
+    if(ret != 0)
+        return ret;
+
+    // Both of the buffers, so that the adaptive mode start from the same coefficients.
+    memcpy(&Profile->bufferA[Offset], Coefficients, Len);
+    memcpy(&Profile->bufferB[Offset], Coefficients, Len);
+    return 0;
+}
@@ -0,0 +1,169 @@
+/**
+ * @file TEST_LIVE.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Source for unittesting the live coefficient update service, over a simulated bus.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+
+// Including the unit test framework
+#include "CppUTest/TestHarness.h"
+
+// Include the tested header
+#include "drivers/peripherals/core/I2C_Simulator.hpp"
+#include "drivers/peripherals/i2c.hpp"
+#include "modules/dsp/live/live.hpp"
+
+// ==============================================================================
+// MODELS
+// ==============================================================================
+
+// A DAC in adaptive mode : a switch request on P44 R1 swap the active CRAM, unless the audio clock is stopped.
+class PCM5252_AdaptiveModel : public I2C_DeviceModel
+{
+public:
+    uint8_t Pages[256][128] = {};
+    int Page = 0;
+    int Pointer = 0;
+    bool Increment = false;
+    bool Clock = true;
+
+    int Write(const uint8_t* const Data, const int Size) override
+    {
+        if(Size <= 0)
+            return 0;
+
+        this->Pointer = Data[0] & 0x7F;
+        this->Increment = (Data[0] & 0x80) != 0;
+        for(int i = 1; i < Size; i++)
+        {
+            if(this->Pointer == 0)
+                this->Page = Data[i];
+            else if((this->Page == 0x2C) & (this->Pointer == 0x01))
+                this->Adaptative(Data[i]);
+            else
+                this->Pages[this->Page][this->Pointer] = Data[i];
+            if(this->Increment)
+                this->Pointer = (this->Pointer + 1) & 0x7F;
+        }
+        return 0;
+    }
+
+    int Read(uint8_t* const Data, const int Size) override
+    {
+        for(int i = 0; i < Size; i++)
+        {
+            Data[i] = (this->Pointer == 0) ? this->Page : this->Pages[this->Page][this->Pointer];
+            if(this->Increment)
+                this->Pointer = (this->Pointer + 1) & 0x7F;
+        }
+        return 0;
+    }
+
+private:
+    void Adaptative(const uint8_t Value)
+    {
+        // ACRM (bit 1) is read only, ACRS (bit 0) clear itself once switched.
+        uint8_t& Register = this->Pages[0x2C][0x01];
+        Register = (uint8_t)((Value & ~0x02) | (Register & 0x02));
+        if(((Register & 0x01) != 0) & this->Clock)
+            Register = (uint8_t)((Register ^ 0x02) & ~0x01);
+    }
+};
+
+// ==============================================================================
+// TEST GROUPS
+// ==============================================================================
+
+TEST_GROUP(DSP_Live)
+{
+    I2C_SimulatedBus* Simulator;
+    PCM5252_AdaptiveModel* Model;
+    I2C_Bus* Bus;
+    PCM5252* Dac;
+
+    void setup()
+    {
+        Simulator = new I2C_SimulatedBus();
+        Model = new PCM5252_AdaptiveModel();
+        Simulator->Attach((int)DAC::DAC_0, Model);
+        Bus = I2C_Open(Simulator);
+        Dac = new PCM5252(Bus, DAC::DAC_0);
+    }
+    void teardown()
+    {
+        delete Dac;
+        I2C_Close(Bus);
+        delete Model;
+    }
+};
+
+// ==============================================================================
+// TESTS
+// ==============================================================================
+
+TEST(DSP_Live, UpdatesAreWroteOnTheInactiveBuffer)
+{
+    uint8_t Initial[10 * 3] = {0};
+    uint8_t Band[2 * 3] = {0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC};
+    uint8_t Gain[3] = {0x40, 0x00, 0x00};
+
+    DSP_LIVE Live(Dac, Initial, 10);
+
+    // Buffer A is active : the update goes on B, which become active.
+    LONGS_EQUAL(0, Live.Set(4, Band, 2));
+    LONGS_EQUAL(0, Live.Sync());
+    MEMCMP_EQUAL(&Band[0], &Model->Pages[0x3E][8 + 4 * 4], 3);
+    MEMCMP_EQUAL(&Band[3], &Model->Pages[0x3E][8 + 5 * 4], 3);
+    LONGS_EQUAL(0x00, Model->Pages[0x2C][8 + 4 * 4]);
+    LONGS_EQUAL(0x02, Model->Pages[0x2C][0x01]);
+
+    // Then on A, which also get the first update.
+    LONGS_EQUAL(0, Live.Set(40, Gain, 1));
+    LONGS_EQUAL(0, Live.Sync());
+    MEMCMP_EQUAL(&Band[0], &Model->Pages[0x2C][8 + 4 * 4], 3);
+    MEMCMP_EQUAL(&Gain[0], &Model->Pages[0x2D][8 + 10 * 4], 3);
+    LONGS_EQUAL(0x00, Model->Pages[0x2C][0x01]);
+
+    LIVE_STATISTICS Statistics = Live.GetStatistics();
+    UNSIGNED_LONGS_EQUAL(2, Statistics.Requests);
+    UNSIGNED_LONGS_EQUAL(2, Statistics.Swaps);
+    UNSIGNED_LONGS_EQUAL(0, Statistics.Errors);
+}
+
+TEST(DSP_Live, UnconfirmedSwitchIsReported)
+{
+    uint8_t Initial[3] = {0};
+    uint8_t Gain[3] = {0x40, 0x00, 0x00};
+
+    DSP_LIVE Live(Dac, Initial, 1);
+    Model->Clock = false;
+
+    LONGS_EQUAL(0, Live.Set(0, Gain, 1));
+    LONGS_EQUAL(-2, Live.Sync());
+    UNSIGNED_LONGS_EQUAL(1, Live.GetStatistics().Errors);
+
+    // Switched with the next update.
+    Model->Clock = true;
+    LONGS_EQUAL(0, Live.Set(1, Gain, 1));
+    LONGS_EQUAL(0, Live.Sync());
+    MEMCMP_EQUAL(&Gain[0], &Model->Pages[0x3E][8], 3);
+    MEMCMP_EQUAL(&Gain[0], &Model->Pages[0x3E][8 + 4], 3);
+    LONGS_EQUAL(0x02, Model->Pages[0x2C][0x01]);
+}
+
+TEST(DSP_Live, OutOfRangeUpdatesAreRejected)
+{
+    uint8_t Initial[3] = {0};
+    DSP_LIVE Live(Dac, Initial, 1);
+
+    LONGS_EQUAL(-1, Live.Set(LIVE_COEFFICIENTS, Initial, 1));
+    LONGS_EQUAL(-1, Live.Set(0, Initial, 0));
+}
@@ -0,0 +1,190 @@
+/**
+ * @file live.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Source for the live coefficient update service.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+#include "modules/dsp/live/live.hpp"
+
+// STD
+#include <algorithm>
+#include <cstring>
+
+// ==============================================================================
+// CONSTRUCTORS
+// ==============================================================================
+
+DSP_LIVE::DSP_LIVE(PCM5252* const Dac, const uint8_t* const Coefficients, const int Count)
+{
+    this->Dac = Dac;
+
+    memset(this->Image, 0x00, sizeof(this->Image));
+    memcpy(this->Image, Coefficients, std::clamp(Count, 0, LIVE_COEFFICIENTS) * LIVE_COEFFICIENT_WIDTH);
+    for(int Bank = 0; Bank < 2; Bank++)
+    {
+        this->Stale[Bank][0] = LIVE_COEFFICIENTS;
+        this->Stale[Bank][1] = 0;
+    }
+
+    this->Pending = false;
+    this->Busy = false;
+    this->Running = true;
+    this->Result = 0;
+    this->Statistics = LIVE_STATISTICS{};
+    this->Worker = std::thread(&DSP_LIVE::Work, this);
+    return;
+}
+
+// ==============================================================================
+// DESTRUCTORS
+// ==============================================================================
+
+DSP_LIVE::~DSP_LIVE()
+{
+    {
+        std::lock_guard<std::mutex> Guard(this->Lock);
+        this->Running = false;
+    }
+    this->Wake.notify_all();
+    this->Worker.join();
+    return;
+}
+
+// ==============================================================================
+// PRIVATE
+// ==============================================================================
+
+void DSP_LIVE::Work()
+{
+    std::unique_lock<std::mutex> Guard(this->Lock);
+    while(true)
+    {
+        this->Wake.wait(Guard, [this] { return this->Pending | (!this->Running); });
+
+        // Stopped, and everything has been switched.
+        if(!this->Pending)
+            break;
+
+        this->Pending = false;
+        this->Busy = true;
+        const auto Since = this->Oldest;
+
+        Guard.unlock();
+        int ret = this->Swap();
+        Guard.lock();
+
+        if(ret == 0)
+        {
+            const unsigned long long Latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                   std::chrono::steady_clock::now() - Since)
+                                                   .count();
+            this->Statistics.Swaps++;
+            this->Statistics.Latency = Latency;
+            this->Statistics.MaxLatency = std::max(this->Statistics.MaxLatency, Latency);
+        }
+        else
+            this->Statistics.Errors++;
+
+        this->Result = ret;
+        this->Busy = false;
+        if(!this->Pending)
+            this->Idle.notify_all();
+    }
+    return;
+}
+
+int DSP_LIVE::Swap()
+{
+    DAC_BUFFER Active;
+    if(this->Dac->ReadActiveCRAM(&Active) != 0)
+        return -1;
+
+    const DAC_BUFFER Target = (Active == DAC_BUFFER::A) ? DAC_BUFFER::B : DAC_BUFFER::A;
+    const int Bank = (Target == DAC_BUFFER::A) ? 0 : 1;
+
+    // Take the coefficients missed by the inactive buffer. Updates received from now on are for the next switch.
+    uint8_t Words[LIVE_COEFFICIENTS * LIVE_COEFFICIENT_WIDTH];
+    int First = 0;
+    int Last = 0;
+    {
+        std::lock_guard<std::mutex> Guard(this->Lock);
+        First = this->Stale[Bank][0];
+        Last = this->Stale[Bank][1];
+        if(Last > First)
+            memcpy(Words,
+                   &this->Image[First * LIVE_COEFFICIENT_WIDTH],
+                   (Last - First) * LIVE_COEFFICIENT_WIDTH);
+        this->Stale[Bank][0] = LIVE_COEFFICIENTS;
+        this->Stale[Bank][1] = 0;
+    }
+
+    int ret = 0;
+    if(Last > First)
+        ret = (this->Dac->WriteDSPCoefficients(Target, First, Words, Last - First) == 0) ? 0 : -1;
+    if(ret == 0)
+    {
+        ret = this->Dac->DSPSwapCRAM(LIVE_SWAP_TIMEOUT);
+        ret = (ret == -2) ? -2 : ((ret != 0) ? -1 : 0);
+    }
+
+    // On failure, the buffer is still missing the coefficients.
+    if((ret != 0) & (Last > First))
+    {
+        std::lock_guard<std::mutex> Guard(this->Lock);
+        this->Stale[Bank][0] = std::min(this->Stale[Bank][0], First);
+        this->Stale[Bank][1] = std::max(this->Stale[Bank][1], Last);
+    }
+    return ret;
+}
+
+// ==============================================================================
+// PUBLIC
+// ==============================================================================
+
+int DSP_LIVE::Set(const int First, const uint8_t* const Values, const int Count)
+{
+    if((First < 0) | (Count <= 0) | (First + Count > LIVE_COEFFICIENTS))
+        return -1;
+
+    {
+        std::lock_guard<std::mutex> Guard(this->Lock);
+        memcpy(&this->Image[First * LIVE_COEFFICIENT_WIDTH], Values, Count * LIVE_COEFFICIENT_WIDTH);
+
+        // Both buffers miss the update : the inactive one get it now, the other one on the next switch.
+        for(int Bank = 0; Bank < 2; Bank++)
+        {
+            this->Stale[Bank][0] = std::min(this->Stale[Bank][0], First);
+            this->Stale[Bank][1] = std::max(this->Stale[Bank][1], First + Count);
+        }
+
+        this->Statistics.Requests++;
+        if(this->Pending)
+            this->Statistics.Coalesced++;
+        else
+            this->Oldest = std::chrono::steady_clock::now();
+        this->Pending = true;
+    }
+    this->Wake.notify_one();
+    return 0;
+}
+
+int DSP_LIVE::Sync()
+{
+    std::unique_lock<std::mutex> Guard(this->Lock);
+    this->Idle.wait(Guard, [this] { return (!this->Pending) & (!this->Busy); });
+    return this->Result;
+}
+
+LIVE_STATISTICS DSP_LIVE::GetStatistics()
+{
+    std::lock_guard<std::mutex> Guard(this->Lock);
+    return this->Statistics;
+}
@@ -0,0 +1,255 @@
+/**
+ * @file TEST_ALLOCATOR.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Source for unittesting the DSP profiles allocator, on a simulated M95256.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+
+// Including the unit test framework
+#include "CppUTest/TestHarness.h"
+
+// Include the tested header
+#include "drivers/peripherals/core/SPI_EepromTest.hpp"
+#include "modules/eeprom/allocator/allocator.hpp"
+
+// STD
+#include <cstring>
+
+// ==============================================================================
+// DEFINES
+// ==============================================================================
+#define REGION_ADDRESS 0x2000
+#define REGION_SIZE (16 * PAGE_SIZE)
+#define DIRECTORY_ADDRESS 0x1000
+#define DIRECTORY_SIZE (32 * PAGE_SIZE)
+
+// ==============================================================================
+// TEST GROUPS
+// ==============================================================================
+
+// An empty region of 16 pages, on an erased EEPROM.
+TEST_GROUP_BASE(EEPROM_Allocator, SPI_EepromTest)
+{
+    EEPROM_ALLOCATOR* Allocator;
+
+    void Open() override
+    {
+        Allocator =
+            new EEPROM_ALLOCATOR(Queue, REGION_ADDRESS, REGION_SIZE, DIRECTORY_ADDRESS, DIRECTORY_SIZE);
+    }
+    void Close() override
+    {
+        delete Allocator;
+    }
+
+    void setup() override
+    {
+        SPI_EepromTest::setup();
+
+        PROFILE_DIRECTORY Directory;
+        memset(&Directory, 0x00, sizeof(Directory));
+        std::shared_future<int> Done;
+        Allocator->Format(&Directory, &Done);
+        Done.get();
+    }
+
+    // Store a profile of Len bytes filled with Seed, and check it's entry has been programmed.
+    int Store(const int Len, const uint8_t Seed)
+    {
+        uint8_t Data[REGION_SIZE];
+        for(int i = 0; i < Len; i++)
+            Data[i] = (uint8_t)(Seed + i);
+
+        int ID = -1;
+        std::shared_future<int> Done;
+        LONGS_EQUAL(0, Allocator->Store(Data, Len, &ID, &Done));
+        LONGS_EQUAL(0, Done.get());
+        return ID;
+    }
+
+    // Check the content of a profile stored by Store().
+    void Verify(const int ID, const int Len, const uint8_t Seed)
+    {
+        uint8_t Data[REGION_SIZE];
+        LONGS_EQUAL(0, Allocator->Read(ID, 0, Data, Len));
+        for(int i = 0; i < Len; i++)
+            BYTES_EQUAL((uint8_t)(Seed + i), Data[i]);
+    }
+};
+
+// ==============================================================================
+// TESTS
+// ==============================================================================
+
+TEST(EEPROM_Allocator, StoredProfilesAreReadBackAfterReboot)
+{
+    const int A = Store(100, 0x10);
+    const int B = Store(300, 0x20);
+    CHECK_TRUE(A != B);
+
+    Reboot();
+    LONGS_EQUAL(0, Allocator->Mount());
+    Verify(A, 100, 0x10);
+    Verify(B, 300, 0x20);
+    LONGS_EQUAL(REGION_SIZE - 2 * PAGE_SIZE - 5 * PAGE_SIZE, Allocator->GetFreeSpace());
+}
+
+TEST(EEPROM_Allocator, SmallestHoleIsUsed)
+{
+    const int A = Store(3 * PAGE_SIZE, 0x10);
+    Store(PAGE_SIZE, 0x20);
+    const int C = Store(PAGE_SIZE, 0x30);
+    Store(PAGE_SIZE, 0x40);
+
+    DSP_PROFILE_INFO Hole;
+    std::shared_future<int> Done[2];
+    LONGS_EQUAL(0, Allocator->Find(C, &Hole));
+    LONGS_EQUAL(0, Allocator->Remove(A, &Done[0]));
+    LONGS_EQUAL(0, Allocator->Remove(C, &Done[1]));
+    LONGS_EQUAL(-1, Allocator->Remove(C));
+    LONGS_EQUAL(0, Done[0].get());
+    LONGS_EQUAL(0, Done[1].get());
+
+    DSP_PROFILE_INFO Info;
+    const int E = Store(PAGE_SIZE / 2, 0x50);
+    LONGS_EQUAL(0, Allocator->Find(E, &Info));
+    LONGS_EQUAL(Hole.Address, Info.Address);
+}
+
+TEST(EEPROM_Allocator, CompactionMergeTheHoles)
+{
+    // Four profiles of 4 pages fill the region. Two holes of 4 pages are left.
+    int ID[4];
+    for(int i = 0; i < 4; i++)
+        ID[i] = Store(4 * PAGE_SIZE, (uint8_t)(0x10 * (i + 1)));
+    LONGS_EQUAL(0, Allocator->Remove(ID[0]));
+    LONGS_EQUAL(0, Allocator->Remove(ID[2]));
+
+    // A profile of 8 pages only fit once compacted.
+    const int Large = Store(8 * PAGE_SIZE, 0x77);
+    CHECK_TRUE(Allocator->GetStatistics().Moves > 0);
+    LONGS_EQUAL(0, Allocator->GetFreeSpace());
+
+    Verify(ID[1], 4 * PAGE_SIZE, 0x20);
+    Verify(ID[3], 4 * PAGE_SIZE, 0x40);
+    Verify(Large, 8 * PAGE_SIZE, 0x77);
+
+    Reboot();
+    LONGS_EQUAL(0, Allocator->Mount());
+    Verify(ID[1], 4 * PAGE_SIZE, 0x20);
+    Verify(ID[3], 4 * PAGE_SIZE, 0x40);
+    Verify(Large, 8 * PAGE_SIZE, 0x77);
+}
+
+TEST(EEPROM_Allocator, FullRegionIsReported)
+{
+    int ID = 0;
+    Store(12 * PAGE_SIZE, 0x10);
+
+    LONGS_EQUAL(-2, Allocator->Check(5 * PAGE_SIZE, &ID));
+    LONGS_EQUAL(0, Allocator->Check(4 * PAGE_SIZE, &ID));
+    LONGS_EQUAL(0, Allocator->Step());
+}
+
+TEST(EEPROM_Allocator, RemovedExtentIsOnlyReusedOnceProgrammed)
+{
+    const int A = Store(4 * PAGE_SIZE, 0x10);
+    uint8_t Data[4 * PAGE_SIZE];
+    for(int i = 0; i < 4 * PAGE_SIZE; i++)
+        Data[i] = (uint8_t)(0x20 + i);
+
+    // A page outside of the region hold the queue, while the removal and the next profile are queued. The power is
+    // lost once the data of the profile is programmed, before the removal.
+    Model->CutPower(5);
+    Model->Hold();
+    Queue->Write(0x6000, Data, 1);
+    Model->WaitHeld();
+
+    int B = -1;
+    LONGS_EQUAL(0, Allocator->Remove(A));
+    LONGS_EQUAL(0, Allocator->Store(Data, sizeof(Data), &B));
+    Model->Release();
+    LONGS_EQUAL(0, Queue->Flush());
+    CHECK_FALSE(Model->IsPowered());
+
+    // The removal is lost : the profile is still on the directory, and shall not have been overwritten.
+    Model->Restore();
+    Reboot();
+    LONGS_EQUAL(0, Allocator->Mount());
+    Verify(A, 4 * PAGE_SIZE, 0x10);
+
+    // Once programmed, the removal free the extent.
+    std::shared_future<int> Done;
+    LONGS_EQUAL(0, Allocator->Remove(A, &Done));
+    LONGS_EQUAL(0, Done.get());
+
+    DSP_PROFILE_INFO Info;
+    B = Store(4 * PAGE_SIZE, 0x20);
+    LONGS_EQUAL(0, Allocator->Find(B, &Info));
+    LONGS_EQUAL(REGION_ADDRESS, Info.Address);
+}
+
+TEST(EEPROM_Allocator, ExtentOfAFailedRemovalIsNotReused)
+{
+    const int A = Store(4 * PAGE_SIZE, 0x10);
+
+    std::shared_future<int> Done;
+    Model->InjectFailure(1);
+    LONGS_EQUAL(0, Allocator->Remove(A, &Done));
+    CHECK_TRUE(Done.get() != 0);
+    LONGS_EQUAL(REGION_SIZE - 4 * PAGE_SIZE, Allocator->GetFreeSpace());
+
+    DSP_PROFILE_INFO Info;
+    const int B = Store(12 * PAGE_SIZE, 0x20);
+    LONGS_EQUAL(0, Allocator->Find(B, &Info));
+    LONGS_EQUAL(REGION_ADDRESS + 4 * PAGE_SIZE, Info.Address);
+    LONGS_EQUAL(0, Allocator->Step());
+
+    // The removal is carried by the next change of the directory.
+    Reboot();
+    LONGS_EQUAL(0, Allocator->Mount());
+    Verify(B, 12 * PAGE_SIZE, 0x20);
+    LONGS_EQUAL(0, Allocator->Find(B, &Info));
+    LONGS_EQUAL(REGION_ADDRESS + 4 * PAGE_SIZE, Info.Address);
+    if(A != B)
+        LONGS_EQUAL(-1, Allocator->Find(A, &Info));
+}
+
+TEST(EEPROM_Allocator, FailedProgressIsCopiedAgain)
+{
+    // A hole of 2 pages before a profile of 6 pages : the move is made of 3 chunks of 2 pages.
+    const int A = Store(2 * PAGE_SIZE, 0x10);
+    const int B = Store(6 * PAGE_SIZE, 0x20);
+    std::shared_future<int> Done;
+    LONGS_EQUAL(0, Allocator->Remove(A, &Done));
+    LONGS_EQUAL(0, Done.get());
+    LONGS_EQUAL(1, Allocator->Step());
+
+    // The data of the second chunk is programmed, but not the progress : the chunk is copied again, then the last
+    // one, then the entry is switched.
+    Model->InjectFailure(1, 2);
+    LONGS_EQUAL(-1, Allocator->Step());
+
+    int Steps = 0;
+    while(Allocator->Step() == 1)
+        Steps++;
+    LONGS_EQUAL(3, Steps);
+    LONGS_EQUAL(6 * PAGE_SIZE, Allocator->GetStatistics().Copied);
+
+    Reboot();
+    LONGS_EQUAL(0, Allocator->Mount());
+    LONGS_EQUAL(0, Allocator->Step());
+
+    DSP_PROFILE_INFO Info;
+    LONGS_EQUAL(0, Allocator->Find(B, &Info));
+    LONGS_EQUAL(REGION_ADDRESS, Info.Address);
+    Verify(B, 6 * PAGE_SIZE, 0x20);
+}
@@ -0,0 +1,402 @@
+/**
+ * @file allocator.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Source for the DSP profiles allocator.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+#include "modules/eeprom/allocator/allocator.hpp"
+
+// Libraries
+#include "modules/libcrc/checksum.h"
+
+// STD
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <tuple>
+#include <vector>
+
+// ==============================================================================
+// CONSTRUCTORS
+// ==============================================================================
+
+EEPROM_ALLOCATOR::EEPROM_ALLOCATOR(EEPROM_QUEUE* const Queue,
+                                   const int Address,
+                                   const int Size,
+                                   const int DirectoryAddress,
+                                   const int DirectorySize)
+{
+    this->Queue = Queue;
+    this->Address = Address;
+    this->Size = Size;
+
+    // The entries are programmed after the profiles they describe.
+    this->Journal = new EEPROM_JOURNAL(
+        Queue, DirectoryAddress, DirectorySize, sizeof(PROFILE_DIRECTORY), true);
+
+    memset(&this->Directory, 0x00, sizeof(PROFILE_DIRECTORY));
+    this->Mounted = false;
+    this->Statistics = ALLOCATOR_STATISTICS{};
+    return;
+}
+
+// ==============================================================================
+// DESTRUCTORS
+// ==============================================================================
+
+EEPROM_ALLOCATOR::~EEPROM_ALLOCATOR()
+{
+    delete this->Journal;
+    return;
+}
+
+// ==============================================================================
+// PRIVATE
+// ==============================================================================
+
+int EEPROM_ALLOCATOR::Extent(const int Len)
+{
+    return ((Len + PAGE_SIZE - 1) / PAGE_SIZE) * PAGE_SIZE;
+}
+
+void EEPROM_ALLOCATOR::Release(const bool Wait)
+{
+    // A failed removal may still be on the directory of the EEPROM : it's extents remain reserved.
+    auto Released = std::remove_if(
+        this->Quarantine.begin(), this->Quarantine.end(), [Wait](const PROFILE_RELEASE& Extent) {
+            if((!Wait) && (Extent.Done.wait_for(std::chrono::seconds(0)) != std::future_status::ready))
+                return false;
+            return Extent.Done.get() == 0;
+        });
+    this->Quarantine.erase(Released, this->Quarantine.end());
+    return;
+}
+
+void EEPROM_ALLOCATOR::Index()
+{
+    this->Release(false);
+
+    // Used extents, by address. A moved profile hold both of it's extents, and the removed ones are reserved.
+    std::vector<std::pair<int, int>> Used;
+    for(const PROFILE_RELEASE& Extent : this->Quarantine)
+        Used.push_back({Extent.Address, Extent.Len});
+    for(int i = 0; i < PROFILE_MAX; i++)
+    {
+        const DSP_PROFILE_INFO& Entry = this->Directory.Profile[i];
+        if(Entry.Len == 0)
+            continue;
+
+        Used.push_back({Entry.Address, Extent(Entry.Len)});
+        if((this->Directory.Move.Active) & (this->Directory.Move.Profile == i))
+            Used.push_back({this->Directory.Move.To, Extent(Entry.Len)});
+    }
+    std::sort(Used.begin(), Used.end());
+
+    // Free extents are the holes between them.
+    this->Free.clear();
+    int Cursor = this->Address;
+    for(const auto& [Start, Len] : Used)
+    {
+        if(Start > Cursor)
+            this->Free[Cursor] = Start - Cursor;
+        Cursor = std::max(Cursor, Start + Len);
+    }
+    if(Cursor < this->Address + this->Size)
+        this->Free[Cursor] = this->Address + this->Size - Cursor;
+    return;
+}
+
+int EEPROM_ALLOCATOR::Fit(const int Len) const
+{
+    // Smallest hole that fit, to keep the large ones for the large profiles.
+    int Best = -1;
+    int BestSize = 0;
+    for(const auto& [Start, Size] : this->Free)
+    {
+        if((Size >= Len) & ((Best < 0) | (Size < BestSize)))
+        {
+            Best = Start;
+            BestSize = Size;
+        }
+    }
+    return Best;
+}
+
+int EEPROM_ALLOCATOR::Used() const
+{
+    int Total = 0;
+    for(int i = 0; i < PROFILE_MAX; i++)
+        Total += Extent(this->Directory.Profile[i].Len);
+
+    // The pending removals will complete, the failed ones are lost until the next mount.
+    for(const PROFILE_RELEASE& Extent : this->Quarantine)
+        if((Extent.Done.wait_for(std::chrono::seconds(0)) == std::future_status::ready) &&
+           (Extent.Done.get() != 0))
+            Total += Extent.Len;
+    return Total;
+}
+
+int EEPROM_ALLOCATOR::Commit(std::shared_future<int>* const Done)
+{
+    return this->Journal->Set((const uint8_t*)&this->Directory, Done);
+}
+
+// ==============================================================================
+// PUBLIC
+// ==============================================================================
+
+int EEPROM_ALLOCATOR::Mount()
+{
+    int ret = this->Journal->Mount();
+    if(ret != 0)
+        return ret;
+
+    this->Journal->Get((uint8_t*)&this->Directory);
+    this->Quarantine.clear();
+    this->Index();
+    this->Mounted = true;
+    return 0;
+}
+
+int EEPROM_ALLOCATOR::Format(const PROFILE_DIRECTORY* const Directory,
+                             std::shared_future<int>* const Done)
+{
+    memcpy(&this->Directory, Directory, sizeof(PROFILE_DIRECTORY));
+    this->Journal->Format((const uint8_t*)&this->Directory, Done);
+    this->Quarantine.clear();
+    this->Index();
+    this->Mounted = true;
+    return 0;
+}
+
+int EEPROM_ALLOCATOR::Check(const int Len, int* const ID) const
+{
+    if(!this->Mounted)
+        return -3;
+
+    int Entry = -1;
+    for(int i = 0; (i < PROFILE_MAX) & (Entry < 0); i++)
+        if(this->Directory.Profile[i].Len == 0)
+            Entry = i;
+    if(Entry < 0)
+        return -1;
+
+    if(this->GetFreeSpace() < Extent(Len))
+        return -2;
+
+    *ID = Entry;
+    return 0;
+}
+
+int EEPROM_ALLOCATOR::Store(const uint8_t* const Data,
+                            const int Len,
+                            int* const ID,
+                            std::shared_future<int>* const Done)
+{
+    int Entry = 0;
+    int ret = this->Check(Len, &Entry);
+    if(ret != 0)
+        return ret;
+
+    // Without a fitting hole, compact until the free space is merged enough. The extents of the completed removals
+    // are free again.
+    this->Index();
+    int Start = this->Fit(Extent(Len));
+    while(Start < 0)
+    {
+        ret = this->Step();
+        if(ret < 0)
+            return -4;
+        if(ret == 0)
+            return -2;
+        Start = this->Fit(Extent(Len));
+    }
+
+    this->Queue->Write(Start, Data, Len);
+
+    DSP_PROFILE_INFO& Info = this->Directory.Profile[Entry];
+    Info.Address = (uint16_t)Start;
+    Info.Len = (uint16_t)Len;
+    Info.CRC = crc_32(Data, Len);
+    this->Commit(Done);
+
+    this->Index();
+    this->Statistics.Allocations++;
+    *ID = Entry;
+    return 0;
+}
+
+int EEPROM_ALLOCATOR::Remove(const int ID, std::shared_future<int>* const Done)
+{
+    if((ID < 0) | (ID >= PROFILE_MAX))
+        return -1;
+    if(this->Directory.Profile[ID].Len == 0)
+        return -1;
+
+    // A move of the profile is abandoned, the copied bytes are just free space.
+    const int Len = Extent(this->Directory.Profile[ID].Len);
+    std::vector<int> Freed = {this->Directory.Profile[ID].Address};
+    if((this->Directory.Move.Active) & (this->Directory.Move.Profile == ID))
+    {
+        Freed.push_back(this->Directory.Move.To);
+        memset(&this->Directory.Move, 0x00, sizeof(PROFILE_MOVE));
+    }
+
+    // The extents are reserved until the entry is on the EEPROM : the data of the next profiles is programmed first.
+    std::shared_future<int> Future;
+    memset(&this->Directory.Profile[ID], 0x00, sizeof(DSP_PROFILE_INFO));
+    this->Commit(&Future);
+    for(const int Address : Freed)
+        this->Quarantine.push_back({Future, Address, Len});
+    if(Done != nullptr)
+        *Done = Future;
+
+    this->Index();
+    return 0;
+}
+
+int EEPROM_ALLOCATOR::Find(const int ID, DSP_PROFILE_INFO* const Info) const
+{
+    if((ID < 0) | (ID >= PROFILE_MAX))
+        return -1;
+    if(this->Directory.Profile[ID].Len == 0)
+        return -1;
+
+    *Info = this->Directory.Profile[ID];
+    return 0;
+}
+
+int EEPROM_ALLOCATOR::Read(const int ID, const int Offset, uint8_t* const Data, const int Len)
+{
+    DSP_PROFILE_INFO Info;
+    if(this->Find(ID, &Info) != 0)
+        return -1;
+    if((Offset < 0) | (Len < 0) | (Offset + Len > Info.Len))
+        return -1;
+
+    // While moved, the copied bytes are only valid on the destination.
+    int Moved = 0;
+    if((this->Directory.Move.Active) & (this->Directory.Move.Profile == ID))
+    {
+        Moved = std::clamp((int)this->Directory.Move.Done - Offset, 0, Len);
+        if(this->Queue->Read(this->Directory.Move.To + Offset, Data, Moved) != 0)
+            return -2;
+    }
+
+    if(this->Queue->Read(Info.Address + Offset + Moved, &Data[Moved], Len - Moved) != 0)
+        return -2;
+    return 0;
+}
+
+int EEPROM_ALLOCATOR::Step()
+{
+    if(!this->Mounted)
+        return -3;
+
+    PROFILE_MOVE& Move = this->Directory.Move;
+    std::shared_future<int> Future;
+
+    // Start a move : the first profile above a hole is slid down to it. The pending removals are awaited first, and
+    // the reserved extents are never moved.
+    if(!Move.Active)
+    {
+        this->Release(true);
+
+        std::vector<std::tuple<int, int, int>> Used;
+        for(int i = 0; i < PROFILE_MAX; i++)
+            if(this->Directory.Profile[i].Len != 0)
+                Used.push_back({this->Directory.Profile[i].Address, Extent(this->Directory.Profile[i].Len), i});
+        for(const PROFILE_RELEASE& Extent : this->Quarantine)
+            Used.push_back({Extent.Address, Extent.Len, -1});
+        std::sort(Used.begin(), Used.end());
+
+        int Cursor = this->Address;
+        for(const auto& [Start, Len, ID] : Used)
+        {
+            if((Start > Cursor) & (ID >= 0))
+            {
+                Move.Active = 1;
+                Move.Profile = (uint8_t)ID;
+                Move.From = (uint16_t)Start;
+                Move.To = (uint16_t)Cursor;
+                Move.Done = 0;
+                break;
+            }
+            Cursor = std::max(Cursor, Start + Len);
+        }
+
+        if(!Move.Active)
+            return 0;
+        this->Index();
+    }
+
+    DSP_PROFILE_INFO& Info = this->Directory.Profile[Move.Profile];
+    const int Len = Extent(Info.Len);
+
+    // Copy the next chunk. It never overwrite source bytes that are not yet copied.
+    if(Move.Done < Len)
+    {
+        const int Chunk =
+            std::min({Move.From - Move.To, Len - Move.Done, PROFILE_MOVE_CHUNK * PAGE_SIZE});
+
+        uint8_t* buf = (uint8_t*)malloc(Chunk);
+        if(buf == nullptr)
+            return -1;
+
+        int ret = this->Queue->Read(Move.From + Move.Done, buf, Chunk);
+        if(ret == 0)
+            ret = this->Queue->Write(Move.To + Move.Done, buf, Chunk).get();
+        free(buf);
+        if(ret != 0)
+            return -1;
+
+        // The next chunk may overwrite this one's source : the progress must be on the EEPROM first. Otherwise, the
+        // chunk is copied again by the next step.
+        Move.Done += Chunk;
+        this->Commit(&Future);
+        if(Future.get() != 0)
+        {
+            Move.Done -= Chunk;
+            return -1;
+        }
+
+        this->Statistics.Copied += Chunk;
+        return 1;
+    }
+
+    // Everything has been copied : switch the entry, then end the move. The source is kept until it's on the
+    // EEPROM.
+    const PROFILE_MOVE Copied = Move;
+    Info.Address = Move.To;
+    memset(&Move, 0x00, sizeof(PROFILE_MOVE));
+    this->Commit(&Future);
+    if(Future.get() != 0)
+    {
+        Info.Address = Copied.From;
+        Move = Copied;
+        return -1;
+    }
+    this->Index();
+
+    this->Statistics.Moves++;
+    return 1;
+}
+
+int EEPROM_ALLOCATOR::GetFreeSpace() const
+{
+    return this->Size - this->Used();
+}
+
+ALLOCATOR_STATISTICS EEPROM_ALLOCATOR::GetStatistics() const
+{
+    return this->Statistics;
+}
@@ -0,0 +1,240 @@
+/**
+ * @file TEST_DSP_PROFILE.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Source for unittesting the conversions of the DSP profile coefficients, and the coding of the images.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+
+// Including the unit test framework
+#include "CppUTest/TestHarness.h"
+
+// Include the tested header
+#include "modules/eeprom/dsp_profile/dsp_codec.hpp"
+#include "modules/eeprom/dsp_profile/dsp_fixed.hpp"
+#include "modules/eeprom/dsp_profile/dsp_profile.hpp"
+
+// STD
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// ==============================================================================
+// CONSTANTS
+// ==============================================================================
+constexpr float Step = 1.0f / 1048576.0f;
+
+// ==============================================================================
+// TEST GROUPS
+// ==============================================================================
+
+TEST_GROUP(DSP_Fixed){};
+
+// ==============================================================================
+// TESTS
+// ==============================================================================
+
+TEST(DSP_Fixed, WordsAreRoundedAndPackedMSBFirst)
+{
+    const float In[6] = {-8.0f, 8.0f - Step, 1.0f, -Step, 0.5f * Step, 1.5f * Step};
+    const uint8_t Expected[6 * DSP_FIXED_WIDTH] = {
+        0x80, 0x00, 0x00, 0x7F, 0xFF, 0xFF, 0x10, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02};
+    uint8_t Out[6 * DSP_FIXED_WIDTH];
+
+    LONGS_EQUAL(0, DSP_PackFixedPoint4dot20(In, 6, Out));
+    MEMCMP_EQUAL(Expected, Out, sizeof(Out));
+}
+
+TEST(DSP_Fixed, OutOfRangeValuesAreSaturated)
+{
+    const float In[4] = {9.0f, -9.0f, NAN, 1e30f};
+    const uint8_t Expected[4 * DSP_FIXED_WIDTH] = {
+        0x7F, 0xFF, 0xFF, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xFF, 0xFF};
+    uint8_t Out[4 * DSP_FIXED_WIDTH];
+
+    LONGS_EQUAL(4, DSP_PackFixedPoint4dot20(In, 4, Out));
+    MEMCMP_EQUAL(Expected, Out, sizeof(Out));
+}
+
+TEST(DSP_Fixed, BlocksAndTailAreUnpackedExactly)
+{
+    // Two blocks of 16 values, and a tail.
+    float In[37];
+    float Back[37];
+    uint8_t Packed[37 * DSP_FIXED_WIDTH];
+    for(int i = 0; i < 37; i++)
+        In[i] = (i - 18) * 0.4375f + (i * 977) * Step;
+
+    LONGS_EQUAL(0, DSP_PackFixedPoint4dot20(In, 37, Packed));
+    DSP_UnpackFixedPoint4dot20(Packed, 37, Back);
+    for(int i = 0; i < 37; i++)
+        DOUBLES_EQUAL(In[i], Back[i], 0.0);
+}
+
+TEST(DSP_Fixed, ProfileBuffersAreReadBack)
+{
+    char Name[MAX_PROFILE_CHAR] = "FIXED";
+    DSP_PROFILE Profile(Name, DSP_PROFILE_SIZE::SMALL);
+    float In[MAX_COEFF / 4];
+    float Back[MAX_COEFF / 4];
+    for(int i = 0; i < MAX_COEFF / 4; i++)
+        In[i] = 0.125f * i - 3.0f;
+
+    LONGS_EQUAL(0, Profile.WriteBufferB(In, MAX_COEFF / 4));
+    LONGS_EQUAL(0, Profile.ReadBufferB(Back, MAX_COEFF / 4));
+    for(int i = 0; i < MAX_COEFF / 4; i++)
+        DOUBLES_EQUAL(In[i], Back[i], 0.0);
+
+    LONGS_EQUAL(-1, Profile.WriteBufferA(In, MAX_COEFF / 4 + 1));
+    LONGS_EQUAL(-1, Profile.ReadBufferA(Back, MAX_COEFF / 4 + 1));
+
+    In[3] = 12.0f;
+    LONGS_EQUAL(-2, Profile.WriteBufferA(In, 4));
+}
+
+// ==============================================================================
+// CODEC
+// ==============================================================================
+
+// Collect the sections forwarded by a decoder.
+class SectionSink : public DSP_PROFILE_SINK
+{
+public:
+    uint8_t Sections[DSP_IMAGE_SECTIONS][MAX_INSTR * 4];
+    int Received[DSP_IMAGE_SECTIONS] = {0, 0, 0};
+    char Name[MAX_PROFILE_CHAR];
+
+    int Open(const DSP_PROFILE_IMAGE* const Image, const char* const Name) override
+    {
+        (void)Image;
+        memcpy(this->Name, Name, MAX_PROFILE_CHAR);
+        return 0;
+    }
+
+    int Write(const int Section, const int First, const uint8_t* const Elements, const int Count) override
+    {
+        const int Width = (Section == 2) ? 4 : 3;
+
+        // Blocks are forwarded in order, aligned from the start of the section.
+        if((First * Width != this->Received[Section]) | (First % DSP_STREAM_ELEMENTS != 0))
+            return -1;
+
+        memcpy(&this->Sections[Section][First * Width], Elements, Count * Width);
+        this->Received[Section] += Count * Width;
+        return 0;
+    }
+};
+
+TEST_GROUP(DSP_Codec)
+{
+    uint8_t Raw[DSP_IMAGE_SECTIONS][MAX_INSTR * 4];
+    int Count[DSP_IMAGE_SECTIONS] = {MAX_COEFF, 200, 700};
+    uint8_t Image[DSP_IMAGE_MAX(MAX_COEFF * 6 + MAX_INSTR * 4 + MAX_PROFILE_CHAR)];
+    int ImageLen;
+
+    void setup()
+    {
+        // Literals, null runs longer than a token, and repeated elements.
+        memset(Raw, 0x00, sizeof(Raw));
+        for(int Section = 0; Section < DSP_IMAGE_SECTIONS; Section++)
+        {
+            const int Width = (Section == 2) ? 4 : 3;
+            for(int i = 0; i < Count[Section]; i++)
+            {
+                uint8_t* Element = &Raw[Section][i * Width];
+                if((i % 97) < 40)
+                    for(int k = 0; k < Width; k++)
+                        Element[k] = (uint8_t)(i * 31 + k * 7 + Section);
+                else if((i % 97) < 80)
+                    memcpy(Element, &Raw[Section][(i - 1) * Width], Width);
+            }
+        }
+
+        DSP_PROFILE_IMAGE Header;
+        memcpy(Header.Magic, DSP_IMAGE_MAGIC, sizeof(DSP_IMAGE_MAGIC));
+        Header.Version = DSP_IMAGE_VERSION;
+        for(int Section = 0; Section < DSP_IMAGE_SECTIONS; Section++)
+            Header.Count[Section] = (uint16_t)Count[Section];
+
+        char Name[MAX_PROFILE_CHAR] = "CODEC";
+        ImageLen = 0;
+        memcpy(&Image[ImageLen], &Header, sizeof(Header));
+        ImageLen += sizeof(Header);
+        memcpy(&Image[ImageLen], Name, MAX_PROFILE_CHAR);
+        ImageLen += MAX_PROFILE_CHAR;
+        for(int Section = 0; Section < DSP_IMAGE_SECTIONS; Section++)
+            ImageLen += DSP_EncodeSection(Raw[Section], Count[Section], (Section == 2) ? 4 : 3, &Image[ImageLen]);
+    }
+
+    // Feed the image by chunks of Chunk bytes, and compare the decoded sections.
+    void RoundTrip(const int Chunk)
+    {
+        SectionSink Sink;
+        DSP_PROFILE_DECODER Decoder(&Sink);
+
+        for(int Position = 0; Position < ImageLen; Position += Chunk)
+            LONGS_EQUAL(0, Decoder.Feed(&Image[Position], std::min(Chunk, ImageLen - Position)));
+        CHECK_TRUE(Decoder.Finished());
+
+        STRCMP_EQUAL("CODEC", Sink.Name);
+        for(int Section = 0; Section < DSP_IMAGE_SECTIONS; Section++)
+        {
+            const int Len = Count[Section] * ((Section == 2) ? 4 : 3);
+            LONGS_EQUAL(Len, Sink.Received[Section]);
+            MEMCMP_EQUAL(Raw[Section], Sink.Sections[Section], Len);
+        }
+    }
+};
+
+TEST(DSP_Codec, ImageIsSmallerThanTheRawProfile)
+{
+    CHECK_TRUE(ImageLen < (Count[0] + Count[1]) * 3 + Count[2] * 4);
+}
+
+TEST(DSP_Codec, RoundTripInASingleFeed)
+{
+    RoundTrip(ImageLen);
+}
+
+TEST(DSP_Codec, RoundTripByteByByte)
+{
+    RoundTrip(1);
+}
+
+TEST(DSP_Codec, RoundTripByOddChunks)
+{
+    RoundTrip(61);
+}
+
+TEST(DSP_Codec, ProfileIsDecodedInPlace)
+{
+    char Name[MAX_PROFILE_CHAR] = "PLACE";
+    DSP_PROFILE Profile(Name, DSP_PROFILE_SIZE::LARGE);
+    DSP_PROFILE_DECODER Decoder(&Profile);
+
+    LONGS_EQUAL(0, Decoder.Feed(Image, ImageLen));
+    CHECK_TRUE(Decoder.Finished());
+
+    float Expected[MAX_COEFF];
+    float Back[MAX_COEFF];
+    DSP_UnpackFixedPoint4dot20(Raw[0], MAX_COEFF, Expected);
+    LONGS_EQUAL(0, Profile.ReadBufferA(Back, MAX_COEFF));
+    for(int i = 0; i < MAX_COEFF; i++)
+        DOUBLES_EQUAL(Expected[i], Back[i], 0.0);
+}
+
+TEST(DSP_Codec, InvalidImageIsRejected)
+{
+    SectionSink Sink;
+    DSP_PROFILE_DECODER Decoder(&Sink);
+
+    Image[0] ^= 0xFF;
+    LONGS_EQUAL(-1, Decoder.Feed(Image, ImageLen));
+}
@@ -0,0 +1,228 @@
+/**
+ * @file TEST_DSP_READER.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Source for unittesting the reader of the compressed DSP profiles, on a simulated M95256.
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+
+// Including the unit test framework
+#include "CppUTest/TestHarness.h"
+
+// Include the tested header
+#include "drivers/peripherals/core/SPI_EepromTest.hpp"
+#include "modules/eeprom/dsp_profile/dsp_fixed.hpp"
+#include "modules/eeprom/dsp_profile/dsp_reader.hpp"
+
+// STD
+#include <cstring>
+
+// ==============================================================================
+// DEFINES
+// ==============================================================================
+#define REGION_ADDRESS 0x0200
+#define REGION_SIZE (256 * PAGE_SIZE)
+#define DIRECTORY_ADDRESS 0x6800
+#define DIRECTORY_SIZE (32 * PAGE_SIZE)
+
+// ==============================================================================
+// TEST GROUPS
+// ==============================================================================
+
+// Collect the sections forwarded by the reader, and fail after a number of blocks if asked.
+class StreamSink : public DSP_PROFILE_SINK
+{
+public:
+    uint8_t Sections[DSP_IMAGE_SECTIONS][MAX_INSTR * 4];
+    int Received[DSP_IMAGE_SECTIONS] = {0, 0, 0};
+    char Name[MAX_PROFILE_CHAR];
+    int Blocks = -1;
+
+    int Open(const DSP_PROFILE_IMAGE* const Image, const char* const Name) override
+    {
+        (void)Image;
+        memcpy(this->Name, Name, MAX_PROFILE_CHAR);
+        return 0;
+    }
+
+    int Write(const int Section, const int First, const uint8_t* const Elements, const int Count) override
+    {
+        if(this->Blocks-- == 0)
+            return -1;
+
+        const int Width = (Section == 2) ? 4 : 3;
+        memcpy(&this->Sections[Section][First * Width], Elements, Count * Width);
+        this->Received[Section] += Count * Width;
+        return 0;
+    }
+};
+
+// A compressed image of a large profile, stored on an empty region.
+TEST_GROUP_BASE(DSP_Reader, SPI_EepromTest)
+{
+    EEPROM_ALLOCATOR* Allocator;
+    DSP_PROFILE_READER* Reader;
+
+    uint8_t Raw[DSP_IMAGE_SECTIONS][MAX_INSTR * 4];
+    int Count[DSP_IMAGE_SECTIONS] = {MAX_COEFF, MAX_COEFF, MAX_INSTR};
+    uint8_t Image[DSP_IMAGE_MAX(MAX_COEFF * 6 + MAX_INSTR * 4 + MAX_PROFILE_CHAR)];
+    int ImageLen;
+    int ID;
+
+    void Open() override
+    {
+        Allocator = new EEPROM_ALLOCATOR(Queue, REGION_ADDRESS, REGION_SIZE, DIRECTORY_ADDRESS, DIRECTORY_SIZE);
+        Reader = new DSP_PROFILE_READER(Allocator);
+    }
+    void Close() override
+    {
+        delete Reader;
+        delete Allocator;
+    }
+
+    void setup() override
+    {
+        SPI_EepromTest::setup();
+
+        PROFILE_DIRECTORY Directory;
+        memset(&Directory, 0x00, sizeof(Directory));
+        Allocator->Format(&Directory);
+
+        // Coefficients within the 4.20 range, with literals, null runs and repeated elements.
+        memset(Raw, 0x00, sizeof(Raw));
+        for(int Section = 0; Section < DSP_IMAGE_SECTIONS; Section++)
+        {
+            const int Width = (Section == 2) ? 4 : 3;
+            for(int i = 0; i < Count[Section]; i++)
+            {
+                uint8_t* Element = &Raw[Section][i * Width];
+                if((i % 13) < 9)
+                    for(int k = 0; k < Width; k++)
+                        Element[k] = (uint8_t)((i * 29 + k * 11 + Section) & ((k == 0) ? 0x3F : 0xFF));
+                else if((i % 13) < 11)
+                    memcpy(Element, &Raw[Section][(i - 1) * Width], Width);
+            }
+        }
+
+        DSP_PROFILE_IMAGE Header;
+        memcpy(Header.Magic, DSP_IMAGE_MAGIC, sizeof(DSP_IMAGE_MAGIC));
+        Header.Version = DSP_IMAGE_VERSION;
+        for(int Section = 0; Section < DSP_IMAGE_SECTIONS; Section++)
+            Header.Count[Section] = (uint16_t)Count[Section];
+
+        char Name[MAX_PROFILE_CHAR] = "READER";
+        ImageLen = 0;
+        memcpy(&Image[ImageLen], &Header, sizeof(Header));
+        ImageLen += sizeof(Header);
+        memcpy(&Image[ImageLen], Name, MAX_PROFILE_CHAR);
+        ImageLen += MAX_PROFILE_CHAR;
+        for(int Section = 0; Section < DSP_IMAGE_SECTIONS; Section++)
+            ImageLen += DSP_EncodeSection(Raw[Section], Count[Section], (Section == 2) ? 4 : 3, &Image[ImageLen]);
+
+        std::shared_future<int> Done;
+        ID = -1;
+        LONGS_EQUAL(0, Allocator->Store(Image, ImageLen, &ID, &Done));
+        LONGS_EQUAL(0, Done.get());
+    }
+
+    // Drop every RAM state, as after a reboot, and mount the directory again.
+    void Remount()
+    {
+        Reboot();
+        LONGS_EQUAL(0, Allocator->Mount());
+    }
+};
+
+// ==============================================================================
+// TESTS
+// ==============================================================================
+
+TEST(DSP_Reader, StreamedProfileMatchesTheDecodedOne)
+{
+    // The image span several chunks : the double buffering is used.
+    CHECK_TRUE(ImageLen > 2 * DSP_STREAM_CHUNK);
+    Remount();
+
+    StreamSink Sink;
+    LONGS_EQUAL(0, Reader->Stream(ID, &Sink));
+    STRCMP_EQUAL("READER", Sink.Name);
+
+    char Name[MAX_PROFILE_CHAR] = "";
+    DSP_PROFILE Profile(Name, DSP_PROFILE_SIZE::LARGE);
+    LONGS_EQUAL(0, Reader->Decode(ID, &Profile));
+
+    float Streamed[MAX_COEFF];
+    float Decoded[MAX_COEFF];
+    DSP_UnpackFixedPoint4dot20(Sink.Sections[0], MAX_COEFF, Streamed);
+    LONGS_EQUAL(0, Profile.ReadBufferA(Decoded, MAX_COEFF));
+    for(int i = 0; i < MAX_COEFF; i++)
+        DOUBLES_EQUAL(Streamed[i], Decoded[i], 0.0);
+
+    DSP_UnpackFixedPoint4dot20(Sink.Sections[1], MAX_COEFF, Streamed);
+    LONGS_EQUAL(0, Profile.ReadBufferB(Decoded, MAX_COEFF));
+    for(int i = 0; i < MAX_COEFF; i++)
+        DOUBLES_EQUAL(Streamed[i], Decoded[i], 0.0);
+
+    for(int Section = 0; Section < DSP_IMAGE_SECTIONS; Section++)
+    {
+        const int Len = Count[Section] * ((Section == 2) ? 4 : 3);
+        LONGS_EQUAL(Len, Sink.Received[Section]);
+        MEMCMP_EQUAL(Raw[Section], Sink.Sections[Section], Len);
+    }
+}
+
+TEST(DSP_Reader, CorruptedImageIsRejected)
+{
+    DSP_PROFILE_INFO Info;
+    LONGS_EQUAL(0, Allocator->Find(ID, &Info));
+
+    // A byte of the last chunk is flipped, once the previous ones have been forwarded.
+    uint8_t Byte = 0;
+    const int Address = Info.Address + ImageLen - 8;
+    Model->Peek(Address, &Byte, 1);
+    Byte ^= 0x01;
+    Model->Poke(Address, &Byte, 1);
+    Remount();
+
+    StreamSink Sink;
+    LONGS_EQUAL(-4, Reader->Stream(ID, &Sink));
+
+    char Name[MAX_PROFILE_CHAR] = "";
+    DSP_PROFILE Profile(Name, DSP_PROFILE_SIZE::LARGE);
+    LONGS_EQUAL(-4, Reader->Decode(ID, &Profile));
+}
+
+TEST(DSP_Reader, FailedSinkStopsTheStream)
+{
+    StreamSink Sink;
+    Sink.Blocks = 3;
+    LONGS_EQUAL(-5, Reader->Stream(ID, &Sink));
+}
+
+TEST(DSP_Reader, LegacyProfilesAreLeftToTheCaller)
+{
+    uint8_t Legacy[4 * PAGE_SIZE];
+    memset(Legacy, 0x00, sizeof(Legacy));
+    memcpy(Legacy, "LEGACY", 6);
+
+    int Raw = -1;
+    std::shared_future<int> Done;
+    LONGS_EQUAL(0, Allocator->Store(Legacy, sizeof(Legacy), &Raw, &Done));
+    LONGS_EQUAL(0, Done.get());
+
+    DSP_PROFILE_IMAGE Header;
+    StreamSink Sink;
+    char Name[MAX_PROFILE_CHAR] = "";
+    DSP_PROFILE Profile(Name, DSP_PROFILE_SIZE::LARGE);
+    CHECK_FALSE(Reader->ReadImage(Raw, &Header));
+    LONGS_EQUAL(-2, Reader->Stream(Raw, &Sink));
+    LONGS_EQUAL(-2, Reader->Decode(Raw, &Profile));
+    LONGS_EQUAL(-1, Reader->Stream(PROFILE_MAX, &Sink));
+}
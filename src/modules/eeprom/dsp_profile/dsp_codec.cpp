@@ -0,0 +1,360 @@
+/**
+ * @file dsp_codec.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Source for the DSP profile images coding.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+#include "modules/eeprom/dsp_profile/dsp_codec.hpp"
+
+// STD
+#include <algorithm>
+#include <cstring>
+
+// ==============================================================================
+// CONSTANTS
+// ==============================================================================
+constexpr int TOKEN_LITERAL_MAX = 128;
+constexpr int TOKEN_NULL_MAX = 16384;
+constexpr int TOKEN_REPEAT_MAX = 64;
+
+constexpr int MODE_TOKEN = 0;
+constexpr int MODE_NULL = 1;
+constexpr int MODE_LITERAL = 2;
+
+// ==============================================================================
+// PRIVATE UTILITIES FUNCTIONS
+// ==============================================================================
+
+bool IsNullElement(const uint8_t* const Element, const int Width)
+{
+    for(int i = 0; i < Width; i++)
+        if(Element[i] != 0x00)
+            return false;
+    return true;
+}
+
+// ==============================================================================
+// FUNCTIONS
+// ==============================================================================
+
+int DSP_EncodeSection(const uint8_t* const In, const int Count, const int Width, uint8_t* const Out)
+{
+    int Len = 0;
+    int i = 0;
+
+    while(i < Count)
+    {
+        const uint8_t* Element = &In[i * Width];
+
+        // Null run
+        if(IsNullElement(Element, Width))
+        {
+            int n = 1;
+            while((i + n < Count) && (n < TOKEN_NULL_MAX) && IsNullElement(&In[(i + n) * Width], Width))
+                n++;
+
+            Out[Len++] = 0x80 | (uint8_t)((n - 1) >> 8);
+            Out[Len++] = (uint8_t)((n - 1) & 0xFF);
+            i += n;
+            continue;
+        }
+
+        // Copies of the previous element
+        if((i > 0) && (memcmp(Element, Element - Width, Width) == 0))
+        {
+            int n = 1;
+            while((i + n < Count) && (n < TOKEN_REPEAT_MAX) &&
+                  (memcmp(&In[(i + n) * Width], Element, Width) == 0))
+                n++;
+
+            Out[Len++] = 0xC0 | (uint8_t)(n - 1);
+            i += n;
+            continue;
+        }
+
+        // Literals, up to the next run
+        int n = 1;
+        while((i + n < Count) && (n < TOKEN_LITERAL_MAX) && !IsNullElement(&In[(i + n) * Width], Width) &&
+              (memcmp(&In[(i + n) * Width], &In[(i + n - 1) * Width], Width) != 0))
+            n++;
+
+        Out[Len++] = (uint8_t)(n - 1);
+        memcpy(&Out[Len], Element, n * Width);
+        Len += n * Width;
+        i += n;
+    }
+
+    return Len;
+}
+
+// ==============================================================================
+// CONSTRUCTORS
+// ==============================================================================
+
+DSP_PROFILE_DECODER::DSP_PROFILE_DECODER(DSP_PROFILE* const Profile)
+{
+    this->Profile = Profile;
+    this->Sink = nullptr;
+    this->Out[0] = Profile->bufferA;
+    this->Out[1] = Profile->bufferB;
+    this->Out[2] = Profile->instr;
+    this->Init();
+    return;
+}
+
+DSP_PROFILE_DECODER::DSP_PROFILE_DECODER(DSP_PROFILE_SINK* const Sink)
+{
+    this->Profile = nullptr;
+    this->Sink = Sink;
+    memset(this->Out, 0x00, sizeof(this->Out));
+    this->Init();
+    return;
+}
+
+// ==============================================================================
+// PRIVATE
+// ==============================================================================
+
+void DSP_PROFILE_DECODER::Init()
+{
+    this->HeadLen = 0;
+    this->Section = 0;
+    this->Offset = 0;
+    this->Forwarded = 0;
+    this->Mode = MODE_TOKEN;
+    this->Count = 0;
+    this->Literal = 0;
+
+    this->Width[0] = 3;
+    this->Width[1] = 3;
+    this->Width[2] = 4;
+    memset(this->Size, 0x00, sizeof(this->Size));
+    memset(this->Last, 0x00, sizeof(this->Last));
+    return;
+}
+
+int DSP_PROFILE_DECODER::Start()
+{
+    DSP_PROFILE_IMAGE Image;
+    memcpy(&Image, this->Head, sizeof(DSP_PROFILE_IMAGE));
+
+    if((Image.Magic[0] != DSP_IMAGE_MAGIC[0]) | (Image.Magic[1] != DSP_IMAGE_MAGIC[1]))
+        return -1;
+    if(Image.Version != DSP_IMAGE_VERSION)
+        return -1;
+
+    for(int i = 0; i < DSP_IMAGE_SECTIONS; i++)
+        this->Size[i] = Image.Count[i] * this->Width[i];
+
+    // The sink check the sizes by itself.
+    const char* Name = (const char*)&this->Head[sizeof(DSP_PROFILE_IMAGE)];
+    if(this->Sink != nullptr)
+    {
+        if(this->Sink->Open(&Image, Name) != 0)
+            return -2;
+        this->Next();
+        return 0;
+    }
+
+    const int Capacity[DSP_IMAGE_SECTIONS] = {
+        this->Profile->sizebufferA, this->Profile->sizebufferB, this->Profile->sizeinstr};
+    for(int i = 0; i < DSP_IMAGE_SECTIONS; i++)
+    {
+        if(this->Size[i] > Capacity[i])
+            return -2;
+
+        // Elements that are not on the image are null.
+        memset(this->Out[i], 0x00, Capacity[i]);
+    }
+
+    memcpy(this->Profile->Name, Name, MAX_PROFILE_CHAR);
+    this->Next();
+    return 0;
+}
+
+void DSP_PROFILE_DECODER::Next()
+{
+    // Skip the completed, and empty, sections.
+    while((this->Section < DSP_IMAGE_SECTIONS) && (this->Offset == this->Size[this->Section]))
+    {
+        this->Section++;
+        this->Offset = 0;
+        this->Forwarded = 0;
+    }
+    return;
+}
+
+uint8_t* DSP_PROFILE_DECODER::Cursor()
+{
+    if(this->Sink != nullptr)
+        return &this->Stage[this->Offset - this->Forwarded];
+    return &this->Out[this->Section][this->Offset];
+}
+
+const uint8_t* DSP_PROFILE_DECODER::Previous() const
+{
+    const int W = this->Width[this->Section];
+    if(this->Sink == nullptr)
+        return &this->Out[this->Section][this->Offset - W];
+
+    // The previous element may already have been forwarded.
+    if(this->Offset > this->Forwarded)
+        return &this->Stage[this->Offset - this->Forwarded - W];
+    return this->Last;
+}
+
+int DSP_PROFILE_DECODER::Room() const
+{
+    const int Remaining = this->Size[this->Section] - this->Offset;
+    if(this->Sink == nullptr)
+        return Remaining;
+
+    const int Staged = this->Offset - this->Forwarded;
+    return std::min(Remaining, DSP_STREAM_ELEMENTS * this->Width[this->Section] - Staged);
+}
+
+int DSP_PROFILE_DECODER::Advance(const int Len)
+{
+    this->Offset += Len;
+    if(this->Sink == nullptr)
+        return 0;
+
+    // Forward the staged elements once a block, or the section, is complete.
+    const int W = this->Width[this->Section];
+    const int Staged = this->Offset - this->Forwarded;
+    if((Staged < DSP_STREAM_ELEMENTS * W) & (this->Offset < this->Size[this->Section]))
+        return 0;
+
+    if(this->Sink->Write(this->Section, this->Forwarded / W, this->Stage, Staged / W) != 0)
+        return -3;
+
+    memcpy(this->Last, &this->Stage[Staged - W], W);
+    this->Forwarded = this->Offset;
+    return 0;
+}
+
+int DSP_PROFILE_DECODER::Run(const bool Null, const int Elements)
+{
+    const int W = this->Width[this->Section];
+
+    if(this->Offset + Elements * W > this->Size[this->Section])
+        return -1;
+    if((!Null) & (this->Offset == 0))
+        return -1;
+
+    int Remaining = Elements * W;
+    while(Remaining > 0)
+    {
+        const int n = std::min(Remaining, this->Room());
+        if(Null)
+            memset(this->Cursor(), 0x00, n);
+        else
+            for(int i = 0; i < n; i += W)
+                memcpy(this->Cursor() + i, (i == 0) ? this->Previous() : this->Cursor() + i - W, W);
+
+        int ret = this->Advance(n);
+        if(ret != 0)
+            return ret;
+        Remaining -= n;
+    }
+
+    this->Next();
+    return 0;
+}
+
+int DSP_PROFILE_DECODER::Token(const uint8_t Byte)
+{
+    if((Byte & 0x80) == 0)
+    {
+        this->Literal = ((Byte & 0x7F) + 1) * this->Width[this->Section];
+        if(this->Offset + this->Literal > this->Size[this->Section])
+            return -1;
+        this->Mode = MODE_LITERAL;
+        return 0;
+    }
+
+    if((Byte & 0xC0) == 0x80)
+    {
+        this->Count = (Byte & 0x3F) << 8;
+        this->Mode = MODE_NULL;
+        return 0;
+    }
+
+    return this->Run(false, (Byte & 0x3F) + 1);
+}
+
+// ==============================================================================
+// PUBLIC
+// ==============================================================================
+
+int DSP_PROFILE_DECODER::Feed(const uint8_t* const Data, const int Len)
+{
+    int i = 0;
+    int ret = 0;
+
+    // Header and name
+    while((this->HeadLen < (int)sizeof(this->Head)) & (i < Len))
+    {
+        this->Head[this->HeadLen++] = Data[i++];
+        if(this->HeadLen == (int)sizeof(this->Head))
+        {
+            ret = this->Start();
+            if(ret != 0)
+                return ret;
+        }
+    }
+
+    while(i < Len)
+    {
+        // Bytes after the last section.
+        if(this->Section == DSP_IMAGE_SECTIONS)
+            return -1;
+
+        switch(this->Mode)
+        {
+        case MODE_LITERAL: {
+            // Literals are copied as they come, directly on the buffer or the stage.
+            const int n = std::min({this->Literal, Len - i, this->Room()});
+            memcpy(this->Cursor(), &Data[i], n);
+            this->Literal -= n;
+            i += n;
+
+            ret = this->Advance(n);
+            if(this->Literal == 0)
+            {
+                this->Mode = MODE_TOKEN;
+                this->Next();
+            }
+            break;
+        }
+
+        case MODE_NULL:
+            this->Mode = MODE_TOKEN;
+            ret = this->Run(true, (this->Count | Data[i++]) + 1);
+            break;
+
+        default:
+            ret = this->Token(Data[i++]);
+            break;
+        }
+
+        if(ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+
+bool DSP_PROFILE_DECODER::Finished() const
+{
+    return (this->HeadLen == (int)sizeof(this->Head)) & (this->Section == DSP_IMAGE_SECTIONS) &
+           (this->Mode == MODE_TOKEN);
+}
@@ -0,0 +1,162 @@
+/**
+ * @file dsp_fixed.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Source for the batch conversions of the DSP coefficients.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+#include "modules/eeprom/dsp_profile/dsp_fixed.hpp"
+
+// STD
+#include <cmath>
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define DSP_FIXED_NEON
+#endif
+
+// ==============================================================================
+// CONSTANTS
+// ==============================================================================
+constexpr float FixedPointScale = 1'048'576.0f; // 2^(20), shift the fractionnal bits to the integer part.
+constexpr int FixedPointMax = 0x7FFFFF; // Largest 4.20 word, 8 - 2^(-20)
+constexpr int FixedPointMin = -0x800000; // Smallest 4.20 word, -8
+
+#ifdef DSP_FIXED_NEON
+constexpr int BlockValues = 16; // Values converted by a NEON block, 3 vectors of packed words
+
+// Byte of the 4 vectors of words (little endian lanes) that go to each byte of the 3 vectors of packed words.
+alignas(16) static const uint8_t PackIndex[3][16] = {
+    {2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, 18, 17, 16, 22},
+    {21, 20, 26, 25, 24, 30, 29, 28, 34, 33, 32, 38, 37, 36, 42, 41},
+    {40, 46, 45, 44, 50, 49, 48, 54, 53, 52, 58, 57, 56, 62, 61, 60},
+};
+
+// Byte of the 3 vectors of packed words that go to each byte of the 4 vectors of words, shifted by 8 bits.
+// Out of range indexes give 0.
+alignas(16) static const uint8_t UnpackIndex[4][16] = {
+    {0xFF, 2, 1, 0, 0xFF, 5, 4, 3, 0xFF, 8, 7, 6, 0xFF, 11, 10, 9},
+    {0xFF, 14, 13, 12, 0xFF, 17, 16, 15, 0xFF, 20, 19, 18, 0xFF, 23, 22, 21},
+    {0xFF, 26, 25, 24, 0xFF, 29, 28, 27, 0xFF, 32, 31, 30, 0xFF, 35, 34, 33},
+    {0xFF, 38, 37, 36, 0xFF, 41, 40, 39, 0xFF, 44, 43, 42, 0xFF, 47, 46, 45},
+};
+#endif
+
+// ==============================================================================
+// PRIVATE UTILITIES FUNCTIONS
+// ==============================================================================
+
+static int PackValue(const float In, uint8_t* const Out)
+{
+    // The range is checked on the scaled value, which is exact.
+    const float Value = In * FixedPointScale;
+    int Word = 0;
+    int Saturated = 1;
+
+    if(std::isnan(Value))
+        Word = 0;
+    else if(Value > FixedPointMax)
+        Word = FixedPointMax;
+    else if(Value < FixedPointMin)
+        Word = FixedPointMin;
+    else
+    {
+        Word = (int)lrintf(Value);
+        Saturated = 0;
+    }
+
+    Out[0] = (Word & 0x00FF0000) >> 16;
+    Out[1] = (Word & 0x0000FF00) >> 8;
+    Out[2] = Word & 0x000000FF;
+    return Saturated;
+}
+
+static float UnpackValue(const uint8_t* const In)
+{
+    const int Word = (In[0] << 16) | (In[1] << 8) | In[2];
+    return ((Word ^ 0x800000) - 0x800000) / FixedPointScale;
+}
+
+#ifdef DSP_FIXED_NEON
+static uint32x4_t PackBlock(const float* const In, uint8_t* const Out, uint32x4_t Saturated)
+{
+    const int32x4_t Max = vdupq_n_s32(FixedPointMax);
+    const int32x4_t Min = vdupq_n_s32(FixedPointMin);
+    uint8x16x4_t Words;
+
+    for(int k = 0; k < 4; k++)
+    {
+        // Round to nearest, ties to even. NaN give 0, and the overflows the extreme integers.
+        const float32x4_t Value = vld1q_f32(&In[k * 4]);
+        const int32x4_t Rounded = vcvtnq_s32_f32(vmulq_n_f32(Value, FixedPointScale));
+        const int32x4_t Word = vmaxq_s32(vminq_s32(Rounded, Max), Min);
+
+        // Lanes are all ones when saturated or NaN : substracting them count them.
+        const uint32x4_t Exact = vandq_u32(vceqq_s32(Rounded, Word), vceqq_f32(Value, Value));
+        Saturated = vsubq_u32(Saturated, vmvnq_u32(Exact));
+        Words.val[k] = vreinterpretq_u8_s32(Word);
+    }
+
+    for(int k = 0; k < 3; k++)
+        vst1q_u8(&Out[k * 16], vqtbl4q_u8(Words, vld1q_u8(PackIndex[k])));
+    return Saturated;
+}
+
+static void UnpackBlock(const uint8_t* const In, float* const Out)
+{
+    uint8x16x3_t Packed;
+    for(int k = 0; k < 3; k++)
+        Packed.val[k] = vld1q_u8(&In[k * 16]);
+
+    for(int k = 0; k < 4; k++)
+    {
+        // The word is placed on the 24 MSBits, the arithmetic shift extend it's sign.
+        const int32x4_t Word =
+            vshrq_n_s32(vreinterpretq_s32_u8(vqtbl3q_u8(Packed, vld1q_u8(UnpackIndex[k]))), 8);
+        vst1q_f32(&Out[k * 4], vcvtq_n_f32_s32(Word, 20));
+    }
+    return;
+}
+#endif
+
+// ==============================================================================
+// FUNCTIONS
+// ==============================================================================
+
+int DSP_PackFixedPoint4dot20(const float* const In, const int Count, uint8_t* const Out)
+{
+    int Saturated = 0;
+    int i = 0;
+
+#ifdef DSP_FIXED_NEON
+    uint32x4_t Lanes = vdupq_n_u32(0);
+    for(; i + BlockValues <= Count; i += BlockValues)
+        Lanes = PackBlock(&In[i], &Out[i * DSP_FIXED_WIDTH], Lanes);
+    Saturated = (int)vaddvq_u32(Lanes);
+#endif
+
+    for(; i < Count; i++)
+        Saturated += PackValue(In[i], &Out[i * DSP_FIXED_WIDTH]);
+    return Saturated;
+}
+
+void DSP_UnpackFixedPoint4dot20(const uint8_t* const In, const int Count, float* const Out)
+{
+    int i = 0;
+
+#ifdef DSP_FIXED_NEON
+    for(; i + BlockValues <= Count; i += BlockValues)
+        UnpackBlock(&In[i * DSP_FIXED_WIDTH], &Out[i]);
+#endif
+
+    for(; i < Count; i++)
+        Out[i] = UnpackValue(&In[i * DSP_FIXED_WIDTH]);
+    return;
+}
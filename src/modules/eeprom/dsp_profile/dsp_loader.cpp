@@ -0,0 +1,80 @@
+/**
+ * @file dsp_loader.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Source for the DSP profiles loader.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+#include "modules/eeprom/dsp_profile/dsp_loader.hpp"
+
+// STD
+#include <cstring>
+
+// ==============================================================================
+// CONSTRUCTORS
+// ==============================================================================
+
+DSP_PROFILE_LOADER::DSP_PROFILE_LOADER(PCM5252* const Dac)
+{
+    this->Dac = Dac;
+    memset(this->Name, 0x00, sizeof(this->Name));
+    this->Written = 0;
+    return;
+}
+
+// ==============================================================================
+// PUBLIC
+// ==============================================================================
+
+int DSP_PROFILE_LOADER::Open(const DSP_PROFILE_IMAGE* const Image, const char* const Name)
+{
+    if((Image->Count[0] > MAX_COEFF) | (Image->Count[1] > MAX_COEFF) | (Image->Count[2] > MAX_INSTR))
+        return -1;
+
+    memcpy(this->Name, Name, MAX_PROFILE_CHAR);
+    this->Written = 0;
+    return 0;
+}
+
+int DSP_PROFILE_LOADER::Write(const int Section,
+                              const int First,
+                              const uint8_t* const Elements,
+                              const int Count)
+{
+    int ret = 0;
+    switch(Section)
+    {
+    case 0:
+        ret = this->Dac->WriteDSPCoefficients(DAC_BUFFER::A, First, Elements, Count);
+        break;
+    case 1:
+        ret = this->Dac->WriteDSPCoefficients(DAC_BUFFER::B, First, Elements, Count);
+        break;
+    default:
+        ret = this->Dac->WriteDSPInstructions(First, Elements, Count);
+        break;
+    }
+
+    if(ret != 0)
+        return -1;
+    this->Written += Count;
+    return 0;
+}
+
+void DSP_PROFILE_LOADER::GetName(char Name[MAX_PROFILE_CHAR]) const
+{
+    memcpy(Name, this->Name, MAX_PROFILE_CHAR);
+    return;
+}
+
+int DSP_PROFILE_LOADER::GetWritten() const
+{
+    return this->Written;
+}
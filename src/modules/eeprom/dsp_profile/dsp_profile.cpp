@@ -13,6 +13,8 @@
 // INCLUDES
 // ==============================================================================
 #include "modules/eeprom/dsp_profile/dsp_profile.hpp"
+#include "modules/eeprom/dsp_profile/dsp_codec.hpp"
+#include "modules/eeprom/dsp_profile/dsp_fixed.hpp"
 
 #include <cstring>
 #include <iostream>
@@ -20,12 +22,6 @@
 #include <stdexcept>
 #include <stdlib.h>
 
-// ==============================================================================
-// CONSTANTS
-// ==============================================================================
-constexpr int FixedPointFloatToIntPart =
-    1'048'576; // Constant equal 2^(20) to shift the farthest decimal to a integer.
-
 // ==============================================================================
 // CONSTRUCTORS
 // ==============================================================================
@@ -165,45 +161,17 @@ DSP_PROFILE::~DSP_PROFILE()
 }
 
 // ==============================================================================
-// PRIVATE UTILITIES FUNCTIONS
+// UTILITIES FUNCTIONS
 // ==============================================================================
 
 int ConvertFloatToFixedPoint4dot20(const float In, int* const Out)
 {
-    // The number in the the function will be expressed as :
-    // SA.B where
-    // S is the sign
-    // A is the integer part
-    // B is the floating part
-    int S = 0;
-    int A = 0;
-    int B = 0;
-
-    // Check for capability on the DSP buffer
-    if(In < 0)
-    {
-        A = round(In);
-        S = 1;
-
-        if(A > 7)
-            return -1;
-    }
-    else
-    {
-        A = round(In);
-        S = 0;
-        if(A < -7)
-            return -1;
-    }
-
-    // Compute the float part
-    B = (int)((In - A) * FixedPointFloatToIntPart);
+    // Same rounding as the batch conversions.
+    uint8_t Word[DSP_FIXED_WIDTH];
+    if(DSP_PackFixedPoint4dot20(&In, 1, Word) != 0)
+        return -1;
 
-    // Create the output buffer;
-    *Out = S << 3;
-    *Out |= A << 20;
-    *Out |= B;
-    *Out &= 0x00FFFFFF; // Make sure that there are 0 on the 8 MSBit
+    *Out = (Word[0] << 16) | (Word[1] << 8) | Word[2];
     return 0;
 }
 
@@ -230,6 +198,34 @@ int DSP_PROFILE::ReadBuffers(uint8_t* const buf, int* const Len)
     return 0;
 }
 
+int DSP_PROFILE::Encode(uint8_t* const buf, int* const Len)
+{
+    // Safety checks
+    if(*Len < DSP_IMAGE_MAX(this->size))
+        return -1;
+
+    DSP_PROFILE_IMAGE Image;
+    memcpy(Image.Magic, DSP_IMAGE_MAGIC, sizeof(DSP_IMAGE_MAGIC));
+    Image.Version = DSP_IMAGE_VERSION;
+    Image.Count[0] = this->sizebufferA / 3;
+    Image.Count[1] = this->sizebufferB / 3;
+    Image.Count[2] = this->sizeinstr / 4;
+
+    // Header and name are not coded.
+    int Position = 0;
+    memcpy(&buf[Position], &Image, sizeof(DSP_PROFILE_IMAGE));
+    Position += sizeof(DSP_PROFILE_IMAGE);
+    memcpy(&buf[Position], this->Name, MAX_PROFILE_CHAR);
+    Position += MAX_PROFILE_CHAR;
+
+    Position += DSP_EncodeSection(this->bufferA, Image.Count[0], 3, &buf[Position]);
+    Position += DSP_EncodeSection(this->bufferB, Image.Count[1], 3, &buf[Position]);
+    Position += DSP_EncodeSection(this->instr, Image.Count[2], 4, &buf[Position]);
+
+    *Len = Position;
+    return 0;
+}
+
 int DSP_PROFILE::WriteBuffers(uint8_t* const buf, int* const Len)
 {
     // Safety checks
@@ -282,43 +278,39 @@ int DSP_PROFILE::WriteInstructions(int* const Instructions, const int bufLen)
 
 int DSP_PROFILE::WriteBufferB(float* const buf, const int bufLen)
 {
-    if(bufLen > this->sizeinstr)
+    if(bufLen > this->sizebufferB / DSP_FIXED_WIDTH)
         return -1;
 
-    int bufaddr = 0;
-    int t = 0;
+    if(DSP_PackFixedPoint4dot20(buf, bufLen, this->bufferB) != 0)
+        return -2;
+    return 0;
+}
 
-    for(int i = 0; i < bufLen; i++)
-    {
-        if(ConvertFloatToFixedPoint4dot20(buf[i], &t) != 0)
-            return -2;
+int DSP_PROFILE::WriteBufferA(float* const buf, const int bufLen)
+{
+    if(bufLen > this->sizebufferA / DSP_FIXED_WIDTH)
+        return -1;
 
-        bufaddr = i * 3;
-        this->bufferB[bufaddr] = (t & 0x00FF0000) >> 16;
-        this->bufferB[bufaddr + 1] = (t & 0x0000FF00) >> 8;
-        this->bufferB[bufaddr + 2] = t & 0x000000FF;
-    }
+    if(DSP_PackFixedPoint4dot20(buf, bufLen, this->bufferA) != 0)
+        return -2;
     return 0;
 }
 
-int DSP_PROFILE::WriteBufferA(float* const buf, const int bufLen)
+int DSP_PROFILE::ReadBufferA(float* const buf, const int bufLen)
 {
-    if(bufLen > this->sizeinstr)
+    if(bufLen > this->sizebufferA / DSP_FIXED_WIDTH)
         return -1;
 
-    int bufaddr = 0;
-    int t = 0;
+    DSP_UnpackFixedPoint4dot20(this->bufferA, bufLen, buf);
+    return 0;
+}
 
-    for(int i = 0; i < bufLen; i++)
-    {
-        if(ConvertFloatToFixedPoint4dot20(buf[i], &t) != 0)
-            return -2;
+int DSP_PROFILE::ReadBufferB(float* const buf, const int bufLen)
+{
+    if(bufLen > this->sizebufferB / DSP_FIXED_WIDTH)
+        return -1;
 
-        bufaddr = i * 3;
-        this->bufferA[bufaddr] = (t & 0x00FF0000) >> 16;
-        this->bufferA[bufaddr + 1] = (t & 0x0000FF00) >> 8;
-        this->bufferA[bufaddr + 2] = t & 0x000000FF;
-    }
+    DSP_UnpackFixedPoint4dot20(this->bufferB, bufLen, buf);
     return 0;
 }
 
@@ -0,0 +1,179 @@
+/**
+ * @file dsp_reader.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Source for the reader of the compressed DSP profiles.
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+#include "modules/eeprom/dsp_profile/dsp_reader.hpp"
+
+// Libraries
+#include "modules/libcrc/checksum.h"
+
+// STD
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+// ==============================================================================
+// CONSTRUCTORS
+// ==============================================================================
+
+DSP_PROFILE_READER::DSP_PROFILE_READER(EEPROM_ALLOCATOR* const Profiles)
+{
+    this->Profiles = Profiles;
+    return;
+}
+
+// ==============================================================================
+// PUBLIC
+// ==============================================================================
+
+bool DSP_PROFILE_READER::ReadImage(const int ID, DSP_PROFILE_IMAGE* const Image)
+{
+    // Legacy profiles are raw, and start with their name.
+    DSP_PROFILE_INFO Info;
+    if(this->Profiles->Find(ID, &Info) != 0)
+        return false;
+    if(Info.Len < (int)sizeof(DSP_PROFILE_IMAGE) + MAX_PROFILE_CHAR)
+        return false;
+    if(this->Profiles->Read(ID, 0, (uint8_t*)Image, sizeof(DSP_PROFILE_IMAGE)) != 0)
+        return false;
+    return memcmp(Image->Magic, DSP_IMAGE_MAGIC, sizeof(DSP_IMAGE_MAGIC)) == 0;
+}
+
+int DSP_PROFILE_READER::Decode(const int ID, DSP_PROFILE* const Profile)
+{
+    DSP_PROFILE_INFO Info;
+    if(this->Profiles->Find(ID, &Info) != 0)
+        return -1;
+    const int Len = Info.Len;
+
+    DSP_PROFILE_IMAGE Image;
+    if(!this->ReadImage(ID, &Image))
+        return -2;
+
+    // Decoded as it is read, directly on the profile buffers.
+    DSP_PROFILE_DECODER Decoder(Profile);
+    uint8_t Chunk[DSP_READ_CHUNK];
+    uint32_t CRC = CRC_START_32;
+
+    for(int Offset = 0; Offset < Len; Offset += DSP_READ_CHUNK)
+    {
+        const int n = std::min(DSP_READ_CHUNK, Len - Offset);
+        if(this->Profiles->Read(ID, Offset, Chunk, n) != 0)
+            return -3;
+
+        for(int i = 0; i < n; i++)
+            CRC = update_crc_32(CRC, Chunk[i]);
+        if(Decoder.Feed(Chunk, n) != 0)
+            return -4;
+    }
+
+    if((!Decoder.Finished()) | ((CRC ^ 0xFFFFFFFF) != Info.CRC))
+        return -4;
+    return 0;
+}
+
+int DSP_PROFILE_READER::Stream(const int ID, DSP_PROFILE_SINK* const Sink)
+{
+    DSP_PROFILE_INFO Info;
+    if(this->Profiles->Find(ID, &Info) != 0)
+        return -1;
+    const int Len = Info.Len;
+
+    DSP_PROFILE_IMAGE Image;
+    if(!this->ReadImage(ID, &Image))
+        return -2;
+
+    DSP_PROFILE_DECODER Decoder(Sink);
+    uint8_t Chunk[2][DSP_STREAM_CHUNK];
+    int Status[2] = {0, 0};
+    const int Chunks = (Len + DSP_STREAM_CHUNK - 1) / DSP_STREAM_CHUNK;
+    uint32_t CRC = CRC_START_32;
+    int ret = 0;
+
+    // Double buffering : a single reader fill the next chunk while the current one is forwarded. A chunk is only
+    // read once the one that used it's buffer before has been forwarded.
+    std::mutex Lock;
+    std::condition_variable Changed;
+    int Read = 0;
+    int Forwarded = 0;
+    bool Stop = false;
+
+    std::thread Reader([&]() {
+        for(int Index = 0; Index < Chunks; Index++)
+        {
+            {
+                std::unique_lock<std::mutex> Guard(Lock);
+                Changed.wait(Guard, [&]() { return Stop || (Index - Forwarded < 2); });
+                if(Stop)
+                    return;
+            }
+
+            const int Offset = Index * DSP_STREAM_CHUNK;
+            const int res =
+                this->Profiles->Read(ID, Offset, Chunk[Index & 1], std::min(DSP_STREAM_CHUNK, Len - Offset));
+            {
+                std::lock_guard<std::mutex> Guard(Lock);
+                Status[Index & 1] = res;
+                Read = Index + 1;
+            }
+            Changed.notify_all();
+            if(res != 0)
+                return;
+        }
+        return;
+    });
+
+    for(int Index = 0; (Index < Chunks) & (ret == 0); Index++)
+    {
+        {
+            std::unique_lock<std::mutex> Guard(Lock);
+            Changed.wait(Guard, [&]() { return Read > Index; });
+        }
+        if(Status[Index & 1] != 0)
+        {
+            ret = -3;
+            break;
+        }
+
+        const int n = std::min(DSP_STREAM_CHUNK, Len - Index * DSP_STREAM_CHUNK);
+        const uint8_t* Current = Chunk[Index & 1];
+        for(int i = 0; i < n; i++)
+            CRC = update_crc_32(CRC, Current[i]);
+
+        ret = Decoder.Feed(Current, n);
+        if(ret != 0)
+            ret = (ret == -3) ? -5 : -4;
+
+        {
+            std::lock_guard<std::mutex> Guard(Lock);
+            Forwarded = Index + 1;
+        }
+        Changed.notify_all();
+    }
+
+    // The reader shall end before the buffers goes out of scope.
+    {
+        std::lock_guard<std::mutex> Guard(Lock);
+        Stop = true;
+    }
+    Changed.notify_all();
+    Reader.join();
+    if(ret != 0)
+        return ret;
+
+    if((!Decoder.Finished()) | ((CRC ^ 0xFFFFFFFF) != Info.CRC))
+        return -4;
+    return 0;
+}
@@ -19,6 +19,7 @@
 #include "modules/libcrc/checksum.h"
 
 // STD
+#include <algorithm>
 #include <iostream>
 #include <math.h>
 #include <stdexcept>
@@ -98,15 +99,24 @@ EEPROM::EEPROM(bool ForceWrite)
         throw std::runtime_error(
             "[ M95256 ][ CONSTRUCTOR ] : Failed to allocate memory for the SPI obect");
 
-    // Open a new slave
+    // Open a new slave. Every access is done through the queue from now.
     this->Slave = M95256(this->SPI);
+    this->Queue = new EEPROM_QUEUE(&this->Slave);
+    this->Config = new EEPROM_JOURNAL(this->Queue, JOURNAL_ADDRESS, JOURNAL_SIZE, CONFIG_SIZE);
+    this->Profiles = new EEPROM_ALLOCATOR(this->Queue,
+                                          PROFILE_ADDRESS,
+                                          PROFILE_DIRECTORY_ADDRESS - PROFILE_ADDRESS,
+                                          PROFILE_DIRECTORY_ADDRESS,
+                                          PROFILE_DIRECTORY_SIZE);
+    this->Reader = new DSP_PROFILE_READER(this->Profiles);
 
     this->Header = new EEPROM_HEADER_V1;
     if(this->Header == nullptr)
         throw std::runtime_error(
             "[ EEPROM ][ CONSTRUCTOR ] : Failed to allocate memory for the HEADER obect");
+    this->Slots = new EEPROM_HEADER_SLOTS(this->Queue, HEADER_ADDRESS);
 
-    int ret = this->ReadHeaderV1();
+    int ret = this->Slots->Read(this->Header);
     if(ret != 0)
     {
         if(ForceWrite == true)
@@ -116,7 +126,7 @@ EEPROM::EEPROM(bool ForceWrite)
                     "[ EEPROM ][ CONSTRUCTOR ] : Provided default file has an incorrect size");
 
             memcpy(this->Header, _binary_build_bin_header_bin_start, HEADER_SIZE);
-            this->WriteHeaderV1();
+            this->Slots->Write(this->Header);
             std::clog << "[ EEPROM ][ CONSTRUCTOR ] : Failed to read the header. Default one was "
                          "wrote. Error code was : "
                       << ret << std::endl;
@@ -126,6 +136,22 @@ EEPROM::EEPROM(bool ForceWrite)
                 "[ EEPROM ][ CONSTRUCTOR ] : Failed to read header from the EEPROM");
     }
 
+    // Rebuild the config. On the first boot with the journal, import the config from it's legacy location.
+    // The second header slot is wrote over it : the import must be on the EEPROM before any header write.
+    if((this->Config->Mount() == -1) & (this->Header->Sequence == 0))
+    {
+        CONFIG_V1 Legacy;
+        if(this->ReadLegacyConfigV1(&Legacy) == 0)
+        {
+            this->Config->Format((uint8_t*)&Legacy);
+            this->Queue->Flush();
+        }
+    }
+
+    // Rebuild the profiles directory. On the first boot with it, import the profiles of the header.
+    if(this->Profiles->Mount() == -1)
+        this->ImportLegacyProfiles();
+
     return;
 }
 
@@ -135,6 +161,11 @@ EEPROM::EEPROM(bool ForceWrite)
 
 EEPROM::~EEPROM() // OK
 {
+    delete this->Reader;
+    delete this->Profiles;
+    delete this->Config;
+    delete this->Slots;
+    delete this->Queue; // Program the pending writes.
     delete this->Header;
     this->Slave.~M95256(); // Call the destructor.
     SPI_Close(this->SPI);
@@ -147,7 +178,7 @@ EEPROM::~EEPROM() // OK
 
 int CheckProfileValue(int Profile) // OK
 {
-    if((0 > Profile) | (Profile > 8))
+    if((0 > Profile) | (Profile >= PROFILE_MAX))
         return -1;
     return 0;
 }
@@ -156,68 +187,6 @@ int CheckProfileValue(int Profile) // OK
 // PRIVATE
 // ==============================================================================
 
-int EEPROM::ReadHeaderV1() // OK
-{
-    // Alocate the data
-    uint8_t* buf = (uint8_t*)malloc(HEADER_SIZE);
-    if(buf == nullptr)
-        return -1;
-
-    // Copy the data
-    memset(buf, 0x00, HEADER_SIZE);
-
-    // Read the data and put it on the structure
-    int res = this->Slave.Read(HEADER_ADDRESS, buf, HEADER_SIZE);
-    if(res < 0)
-        return -2;
-    memcpy(this->Header, buf, HEADER_SIZE);
-
-    // CRC Check
-    uint16_t read_CRC = Header->HeaderCRC16;
-    this->Header->HeaderCRC16 =
-        0xAAAA; // Set the dummy value to ensure integrity of the computation.
-
-    memcpy(buf, this->Header, HEADER_SIZE);
-    uint16_t calc_CRC = crc_16(buf, HEADER_SIZE);
-
-    // Free memory
-    free(buf);
-
-    if(read_CRC != calc_CRC)
-        return -3;
-    return 0;
-}
-
-int EEPROM::WriteHeaderV1() // OK
-{
-    // Creating a buffer value
-    uint8_t* buf = (uint8_t*)malloc(HEADER_SIZE);
-    if(buf == nullptr)
-        return -1;
-    memset(buf, 0x00, HEADER_SIZE);
-
-    // Set a dummy value on the CRC16 field and copy the data to an array of uint8_t.
-    this->Header->HeaderCRC16 = 0xAAAA;
-    memcpy(buf, Header, HEADER_SIZE);
-
-    // Compute the CRC
-    uint16_t calc_CRC = crc_16(buf, HEADER_SIZE);
-    this->Header->HeaderCRC16 = calc_CRC;
-
-    // Copying the data
-    memcpy(buf, this->Header, HEADER_SIZE);
-
-    // Write the data (one write per 64 bytes, per page !)
-    int ret = 0;
-    ret += this->Slave.Write(HEADER_ADDRESS, &buf[0], PAGE_SIZE);
-    ret += this->Slave.Write((HEADER_ADDRESS + PAGE_SIZE), &buf[PAGE_SIZE], PAGE_SIZE);
-    free(buf);
-
-    // Returns
-    if(ret < 0)
-        return -2;
-    return 0;
-}
 int EEPROM::SetConfigCRC(const uint16_t CRC) // OK
 {
     this->Header->ConfigCRC16 = CRC;
@@ -241,83 +210,90 @@ int EEPROM::GetHeaderV1(EEPROM_HEADER_V1* const Header) // OK
     return 0;
 }
 
-int EEPROM::WriteConfigV1(CONFIG_V1* const Data) // OK
+int EEPROM::Flush()
 {
-    // Creating a buffer value and cop
-    uint8_t* buf = (uint8_t*)malloc(CONFIG_SIZE);
-    if(buf == nullptr)
+    return this->Queue->Flush();
+}
+
+int EEPROM::Preload()
+{
+    if(this->Queue->Preload() != 0)
         return -1;
-    memcpy(buf, Data, CONFIG_SIZE);
+    return 0;
+}
 
-    // Compute the CRC and write it on the header / EEPROM
-    uint16_t calc_CRC = crc_16(buf, CONFIG_SIZE);
-    this->SetConfigCRC(calc_CRC);
-    this->WriteHeaderV1();
+int EEPROM::WriteConfigV1(CONFIG_V1* const Data, std::shared_future<int>* const Done) // OK
+{
+    int ret = this->Config->Set((uint8_t*)Data, Done);
 
-    // Write the data (one write per 64 bytes, per page !) and free the buffer.
-    int ret = 0;
-    for(int i = 0; i < CONFIG_SIZE; i += PAGE_SIZE)
-        ret += this->Slave.Write((CONFIG_ADDRESS + i), &buf[i], PAGE_SIZE);
-    free(buf);
+    // Nothing valid on the EEPROM yet : start the journal with this config.
+    if(ret == -1)
+        ret = this->Config->Format((uint8_t*)Data, Done);
 
-    // Returns
-    if(ret < 0)
+    if(ret != 0)
         return -2;
     return 0;
 }
 
 int EEPROM::ReadConfigV1(CONFIG_V1* const Data) // OK
 {
-    // Alocate the data
-    uint8_t* buf = (uint8_t*)malloc(CONFIG_SIZE);
-    if(buf == nullptr)
-        return -1;
-    // Copy the data
-    memset(buf, 0x00, CONFIG_SIZE);
+    if(this->Config->Get((uint8_t*)Data) != 0)
+        return -3;
+    return 0;
+}
 
-    // Read the data and put it on the structure
-    int res = this->Slave.Read(CONFIG_ADDRESS, buf, CONFIG_SIZE);
+int EEPROM::ReadLegacyConfigV1(CONFIG_V1* const Data)
+{
+    // Read the data directly on the structure, from the mirror.
+    int res = this->Queue->Read(CONFIG_ADDRESS, (uint8_t*)Data, CONFIG_SIZE);
     if(res < 0)
         return -2;
-    memcpy(Data, buf, CONFIG_SIZE);
 
     // CRC Check
-    uint16_t calc_CRC = crc_16(buf, CONFIG_SIZE);
+    uint16_t calc_CRC = crc_16((uint8_t*)Data, CONFIG_SIZE);
     uint16_t read_CRC = 0;
     this->GetConfigCRC(&read_CRC);
 
-    // Free memory
-    free(buf);
-
     if(read_CRC != calc_CRC)
         return -3;
     return 0;
 }
 
-int EEPROM::LoadDefaultConfigV1() // OK
+int EEPROM::ImportLegacyProfiles()
 {
-    if(_binary_build_bin_config_bin_end - _binary_build_bin_config_bin_start != 32)
-        return -1;
+    PROFILE_DIRECTORY Directory;
+    memset(&Directory, 0x00, sizeof(PROFILE_DIRECTORY));
 
-    // Creating a buffer value and cop
-    uint8_t* buf = (uint8_t*)malloc(CONFIG_SIZE);
-    if(buf == nullptr)
-        return -1;
-    memcpy(buf, _binary_build_bin_config_bin_start, CONFIG_SIZE);
+    // Only the page aligned profiles of the region are kept : the allocator works on pages.
+    int Imported = 0;
+    for(int i = 0; i < 8; i++)
+    {
+        const DSP_PROFILE_INFO& Legacy = this->Header->Profile[i];
+        if((this->Header->DSP_PROFILE_NUMBER & PROFILES[i]) == 0)
+            continue;
 
-    // Compute the CRC and write it on the header / EEPROM
-    uint16_t calc_CRC = crc_16(buf, CONFIG_SIZE);
-    this->SetConfigCRC(calc_CRC);
-    this->WriteHeaderV1();
+        if((Legacy.Len == 0) | (Legacy.Address % PAGE_SIZE != 0) | (Legacy.Address < PROFILE_ADDRESS) |
+           (Legacy.Address + Legacy.Len > PROFILE_DIRECTORY_ADDRESS))
+        {
+            std::clog << "[ EEPROM ][ ImportLegacyProfiles ] : Profile " << i
+                      << " is outside of the profiles region and has been dropped." << std::endl;
+            continue;
+        }
 
-    // Write the data (one write per 64 bytes, per page !) and free the buffer.
-    int ret = 0;
-    for(int i = 0; i < CONFIG_SIZE; i += PAGE_SIZE)
-        ret += this->Slave.Write((CONFIG_ADDRESS + i), &buf[i], PAGE_SIZE);
-    free(buf);
+        Directory.Profile[Imported] = Legacy;
+        Imported++;
+    }
 
-    // Returns
-    if(ret < 0)
+    return this->Profiles->Format(&Directory);
+}
+
+int EEPROM::LoadDefaultConfigV1(std::shared_future<int>* const Done) // OK
+{
+    if(_binary_build_bin_config_bin_end - _binary_build_bin_config_bin_start != 32)
+        return -1;
+
+    // Start a new journal bank with the default config.
+    if(this->Config->Format((uint8_t*)_binary_build_bin_config_bin_start, Done) != 0)
         return -2;
     return 0;
 }
@@ -328,115 +304,70 @@ int EEPROM::LoadDefaultConfigV1() // OK
 
 int EEPROM::CheckForDSPProfileSpace(DSP_PROFILE* const Profile, int* const PossibleProfileID) // OK
 {
-    // Check if at least a profile is available.
-    if(this->Header->DSP_PROFILE_NUMBER == 0xFF) // All profiles are used.
+    // The compressed size is only known once encoded : check for the worst case.
+    if(this->Profiles->Check(DSP_IMAGE_MAX(Profile->size), PossibleProfileID) != 0)
         return -1;
-
-    // Variables for after.
-    int ProfileSize = 0xFFFF;
-    int ActualAddress = 0;
-    int FutureAddress = 0;
-    int PredictedAddress = 0;
-
-    // Identify the size of the profile
-    ProfileSize = Profile->size;
-
-    // Iterate over the profiles
-    for(int i = 0; i < 8; i++)
-    {
-        // If possible, we compute the available size. In case of match, the first will be choosen.
-        if((this->Header->DSP_PROFILE_NUMBER & PROFILES[i]) == 0)
-        {
-            // Fetch some parameters
-            ActualAddress = this->Header->Profile[i].Address;
-            FutureAddress = this->Header->Profile[i + 1].Address;
-
-            // If 0x0000 (default value), then use the max value
-            if(FutureAddress == 0x0000)
-            {
-                FutureAddress = EEPROM_MAX_ADDRESS;
-            }
-
-            // Compute the predicted address
-            PredictedAddress = ActualAddress + ProfileSize;
-
-            // If size can be stored here, use it.
-            if(PredictedAddress < FutureAddress)
-            {
-                *PossibleProfileID = i;
-                return 0;
-            }
-        }
-    }
-    return -1;
+    return 0;
 }
 
-int EEPROM::AddDSPProfile(DSP_PROFILE* const Profile, int* const ProfileNumber)
+int EEPROM::AddDSPProfile(DSP_PROFILE* const Profile,
+                          int* const ProfileNumber,
+                          std::shared_future<int>* const Done)
 {
     std::cout << "[ EEPROM ][ AddDSPProfile ] : This function has not be fully tested yet... "
                  "Waiting for real data."
               << std::endl;
 
-    int ret = 0;
-
-    // Get Profile parameters
-    if(this->CheckForDSPProfileSpace(Profile, ProfileNumber) != 0)
-        return -1;
-    int Address = this->Header->Profile[*ProfileNumber].Address;
-
-    // Get the number of pages
-    int Pages = ceil(Profile->size / 64) + 1;
-
     // Malloc
-    uint8_t* buf = (uint8_t*)malloc(Pages * 64);
+    int size = DSP_IMAGE_MAX(Profile->size);
+    uint8_t* buf = (uint8_t*)malloc(size);
     if(buf == nullptr)
         return -2;
-    memset(buf, 0x00, (Pages * 64));
-
-    // Prepare data
-    int size = Profile->size;
 
+    // Prepare data : only the compressed image is stored. Nothing is allocated for an image that can't be encoded.
     std::cout << Profile->Name << std::endl;
-    Profile->ReadBuffers(buf, &size);
-
-    // Write data per 64 bytes pages
-    for(int i = 0; i < Pages; i++)
+    if(Profile->Encode(buf, &size) != 0)
     {
-        ret += this->Slave.Write((Address + (i * PAGE_SIZE)), &buf[i * PAGE_SIZE], PAGE_SIZE);
+        free(buf);
+        return -4;
     }
 
-    if(ret != 0)
-        return -3;
-
-    // Update the header
-    this->Header->DSP_PROFILE_NUMBER |= PROFILES[*ProfileNumber];
-    this->Header->Profile[*ProfileNumber].Len = (Pages * 64);
-    this->Header->Profile[*ProfileNumber].CRC = crc_32(buf, (Pages * 64));
-    this->Header->Profile[*ProfileNumber + 1].Address = (Address + (Pages * 64));
-
-    this->WriteHeaderV1();
+    // Queue the data, the directory entry is programmed after it.
+    int ret = this->Profiles->Store(buf, size, ProfileNumber, Done);
 
     free(buf);
 
+    if(ret == -4)
+        return -3;
+    if(ret != 0)
+        return -1;
     return 0;
 }
 
-int EEPROM::RemoveDSPProfile(const int ProfileNumber) // OK
+int EEPROM::RemoveDSPProfile(const int ProfileNumber, std::shared_future<int>* const Done) // OK
 {
     if(CheckProfileValue(ProfileNumber) != 0)
         return -1;
 
-    this->Header->DSP_PROFILE_NUMBER &=
-        ~PROFILES[ProfileNumber - 1]; // Clear the corresponding bit.
-    this->Header->Profile[ProfileNumber].CRC =
-        0x0000; // Reset the CRC to invalidate any read to it.
+    // Free the extent. The data remains until the space is reused.
+    if(this->Profiles->Remove(ProfileNumber, Done) != 0)
+        return -1;
+    return 0;
+}
 
-    // Update the header.
-    int ret = this->WriteHeaderV1();
+int EEPROM::CompactDSPProfiles(const int Steps)
+{
+    int ret = 0;
+    for(int i = 0; i < Steps; i++)
+    {
+        ret = this->Profiles->Step();
+        if(ret <= 0)
+            break;
+    }
 
-    if(ret != 0)
-        return -2;
-    return 0;
+    if(ret < 0)
+        return -1;
+    return ret;
 }
 
 int EEPROM::GetDSPProfileName(const int ProfileNumber, char ProfileName[MAX_PROFILE_CHAR])
@@ -449,29 +380,26 @@ int EEPROM::GetDSPProfileName(const int ProfileNumber, char ProfileName[MAX_PROF
         return -1;
 
     // First, get the address
-    int Address = this->Header->Profile[ProfileNumber].Address;
-    std::cout << "Profile address " << (int)Address << std::endl;
-
-    // Then, read
-    uint8_t* buf = (uint8_t*)malloc(MAX_PROFILE_CHAR);
-    if(buf == nullptr)
+    DSP_PROFILE_INFO Info;
+    if(this->Profiles->Find(ProfileNumber, &Info) != 0)
         return -1;
+    std::cout << "Profile address " << (int)Info.Address << std::endl;
 
-    int ret = this->Slave.Read(Address, buf, MAX_PROFILE_CHAR);
+    // Then, read. The name follow the header of the compressed images, or start the legacy ones.
+    DSP_PROFILE_IMAGE Image;
+    int Offset = 0;
+    if(this->Reader->ReadImage(ProfileNumber, &Image))
+        Offset = sizeof(DSP_PROFILE_IMAGE);
+
+    int ret = this->Profiles->Read(ProfileNumber, Offset, (uint8_t*)ProfileName, MAX_PROFILE_CHAR);
     if(ret != 0)
-    {
-        free(buf);
         return -2;
-    }
 
     std::cout << "Speaker name : ";
     for(int i = 0; i < MAX_PROFILE_CHAR; i++)
-        std::cout << buf[i];
+        std::cout << ProfileName[i];
     std::cout << std::endl;
 
-    // Copy the data
-    memcpy(ProfileName, buf, MAX_PROFILE_CHAR);
-    free(buf);
     return 0;
 }
 
@@ -485,9 +413,17 @@ int EEPROM::GetDSPProfile(const int ProfileNumber, DSP_PROFILE* const Profile)
         return -1;
 
     // Get Profile parameters
-    int Address = this->Header->Profile[ProfileNumber].Address;
-    int Len = this->Header->Profile[ProfileNumber].Len;
+    DSP_PROFILE_INFO Info;
+    if(this->Profiles->Find(ProfileNumber, &Info) != 0)
+        return -1;
+    int Len = Info.Len;
 
+    // Compressed image : decoded as it is read, directly on the profile buffers.
+    int ret = this->Reader->Decode(ProfileNumber, Profile);
+    if(ret != -2)
+        return ret;
+
+    // Legacy raw image
     int Pages = ceil(Profile->size / 64) + 1;
 
     // Malloc
@@ -497,7 +433,11 @@ int EEPROM::GetDSPProfile(const int ProfileNumber, DSP_PROFILE* const Profile)
     memset(buf, 0x00, (Pages * 64));
 
     // Read data
-    this->Slave.Read(Address, buf, Len);
+    if(this->Profiles->Read(ProfileNumber, 0, buf, std::min(Len, Pages * 64)) != 0)
+    {
+        free(buf);
+        return -3;
+    }
     int size = Profile->size;
     Profile->WriteBuffers(buf, &size);
     free(buf);
@@ -505,12 +445,37 @@ int EEPROM::GetDSPProfile(const int ProfileNumber, DSP_PROFILE* const Profile)
     return 0;
 }
 
+int EEPROM::LoadDSPProfile(const int ProfileNumber, DSP_PROFILE_SINK* const Sink)
+{
+    if(CheckProfileValue(ProfileNumber) != 0)
+        return -1;
+
+    return this->Reader->Stream(ProfileNumber, Sink);
+}
+
 int EEPROM::GetDSPProfileSize(const int ProfileNumber, DSP_PROFILE_SIZE* const Profile) // OK
 {
     if(CheckProfileValue(ProfileNumber) != 0)
         return -1;
 
-    switch(this->Header->Profile[ProfileNumber].Len)
+    DSP_PROFILE_INFO Info;
+    if(this->Profiles->Find(ProfileNumber, &Info) != 0)
+        return -1;
+
+    // Compressed image : the size is given by the number of coefficients.
+    DSP_PROFILE_IMAGE Image;
+    if(this->Reader->ReadImage(ProfileNumber, &Image))
+    {
+        if(Image.Count[0] == MAX_COEFF)
+            *Profile = DSP_PROFILE_SIZE::LARGE;
+        else if(Image.Count[0] == MAX_COEFF / 2)
+            *Profile = DSP_PROFILE_SIZE::MEDIUM;
+        else
+            *Profile = DSP_PROFILE_SIZE::SMALL;
+        return 0;
+    }
+
+    switch(Info.Len)
     {
     case(int)DSP_PROFILE_SIZE::LARGE:
         *Profile = DSP_PROFILE_SIZE::LARGE;
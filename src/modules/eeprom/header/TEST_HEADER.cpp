@@ -0,0 +1,182 @@
+/**
+ * @file TEST_HEADER.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Source for unittesting the header slots, on a simulated M95256.
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+
+// Including the unit test framework
+#include "CppUTest/TestHarness.h"
+
+// Include the tested header
+#include "drivers/peripherals/core/SPI_EepromTest.hpp"
+#include "modules/eeprom/header/slots.hpp"
+
+// STD
+#include <cstring>
+
+// ==============================================================================
+// DEFINES
+// ==============================================================================
+#define SLOTS_ADDRESS 0x0000
+
+// ==============================================================================
+// TEST GROUPS
+// ==============================================================================
+
+// Two erased header slots.
+TEST_GROUP_BASE(EEPROM_Header, SPI_EepromTest)
+{
+    EEPROM_HEADER_SLOTS* Slots;
+    EEPROM_HEADER_V1 Header;
+
+    void Open() override
+    {
+        Slots = new EEPROM_HEADER_SLOTS(Queue, SLOTS_ADDRESS);
+    }
+    void Close() override
+    {
+        delete Slots;
+    }
+
+    void setup() override
+    {
+        SPI_EepromTest::setup();
+        Header = EEPROM_HEADER_V1{};
+    }
+
+    // Change both pages of the header.
+    void Mark(const uint8_t Serial)
+    {
+        Header.SERIAL_NB.Decimals[0] = Serial;
+        Header.Profile[7].CRC = Serial;
+    }
+
+    // Write the header with a serial number, and wait for it.
+    void Write(const uint8_t Serial)
+    {
+        std::shared_future<int> Done;
+        Mark(Serial);
+        LONGS_EQUAL(0, Slots->Write(&Header, &Done));
+        LONGS_EQUAL(0, Done.get());
+    }
+};
+
+// ==============================================================================
+// TESTS
+// ==============================================================================
+
+TEST(EEPROM_Header, ErasedSlotsAreNotValid)
+{
+    LONGS_EQUAL(-3, Slots->Read(&Header));
+}
+
+TEST(EEPROM_Header, SlotsAreWrittenAlternately)
+{
+    Write(1);
+    LONGS_EQUAL(0, Slots->GetSlot());
+    Write(2);
+    LONGS_EQUAL(1, Slots->GetSlot());
+
+    Reboot();
+    LONGS_EQUAL(0, Slots->Read(&Header));
+    LONGS_EQUAL(1, Slots->GetSlot());
+    LONGS_EQUAL(2, Header.SERIAL_NB.Decimals[0]);
+    LONGS_EQUAL(2, Header.Sequence);
+}
+
+TEST(EEPROM_Header, NewestSlotIsFoundAcrossTheSequenceWrap)
+{
+    // 0xFFFF on the first slot, then 1 on the second one : 0 is skipped.
+    Header.Sequence = 0xFFFE;
+    Write(1);
+    Write(2);
+    LONGS_EQUAL(1, Header.Sequence);
+
+    Reboot();
+    LONGS_EQUAL(0, Slots->Read(&Header));
+    LONGS_EQUAL(1, Slots->GetSlot());
+    LONGS_EQUAL(2, Header.SERIAL_NB.Decimals[0]);
+
+    // The next write go to the first slot again, and is the newest one.
+    Write(3);
+    LONGS_EQUAL(0, Slots->GetSlot());
+    Reboot();
+    LONGS_EQUAL(0, Slots->Read(&Header));
+    LONGS_EQUAL(0, Slots->GetSlot());
+    LONGS_EQUAL(3, Header.SERIAL_NB.Decimals[0]);
+}
+
+TEST(EEPROM_Header, TornWriteKeepThePreviousHeader)
+{
+    Write(1);
+    Write(2);
+
+    // The first page of the first slot is programmed, the second one is torn.
+    Model->CutPower(1, true);
+    Mark(3);
+    LONGS_EQUAL(0, Slots->Write(&Header));
+    LONGS_EQUAL(0, Queue->Flush());
+    CHECK_FALSE(Model->IsPowered());
+
+    Model->Restore();
+    Reboot();
+    LONGS_EQUAL(0, Slots->Read(&Header));
+    LONGS_EQUAL(1, Slots->GetSlot());
+    LONGS_EQUAL(2, Header.SERIAL_NB.Decimals[0]);
+
+    // The torn slot is the next one written.
+    Write(4);
+    LONGS_EQUAL(0, Slots->GetSlot());
+    Reboot();
+    LONGS_EQUAL(0, Slots->Read(&Header));
+    LONGS_EQUAL(4, Header.SERIAL_NB.Decimals[0]);
+}
+
+TEST(EEPROM_Header, FailedWriteIsWrittenAgainOnTheSameSlot)
+{
+    Write(1);
+
+    std::shared_future<int> Done;
+    Model->InjectFailure(1);
+    Mark(2);
+    LONGS_EQUAL(0, Slots->Write(&Header, &Done));
+    CHECK_TRUE(Done.get() != 0);
+    LONGS_EQUAL(1, Slots->GetSlot());
+
+    // The first slot still hold the last programmed header.
+    Write(3);
+    LONGS_EQUAL(1, Slots->GetSlot());
+    Reboot();
+    LONGS_EQUAL(0, Slots->Read(&Header));
+    LONGS_EQUAL(3, Header.SERIAL_NB.Decimals[0]);
+}
+
+TEST(EEPROM_Header, PendingWriteIsNotAlternated)
+{
+    Write(1);
+
+    // The worker is held on the second slot, while the next header is written.
+    Model->Hold();
+    Mark(2);
+    LONGS_EQUAL(0, Slots->Write(&Header));
+    Model->WaitHeld();
+    Mark(3);
+    LONGS_EQUAL(0, Slots->Write(&Header));
+    LONGS_EQUAL(1, Slots->GetSlot());
+    Model->Release();
+    LONGS_EQUAL(0, Queue->Flush());
+
+    Reboot();
+    LONGS_EQUAL(0, Slots->Read(&Header));
+    LONGS_EQUAL(1, Slots->GetSlot());
+    LONGS_EQUAL(3, Header.SERIAL_NB.Decimals[0]);
+}
@@ -0,0 +1,130 @@
+/**
+ * @file slots.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Source for the storage of the header on two slots.
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+#include "modules/eeprom/header/slots.hpp"
+
+// Libraries
+#include "modules/libcrc/checksum.h"
+
+// STD
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+// ==============================================================================
+// CONSTRUCTORS
+// ==============================================================================
+
+EEPROM_HEADER_SLOTS::EEPROM_HEADER_SLOTS(EEPROM_QUEUE* const Queue, const int Address)
+{
+    this->Queue = Queue;
+    this->Address = Address;
+    this->Slot = HEADER_SLOTS - 1; // Without a valid header, the first slot is wrote first.
+    return;
+}
+
+// ==============================================================================
+// PUBLIC
+// ==============================================================================
+
+int EEPROM_HEADER_SLOTS::Read(EEPROM_HEADER_V1* const Header)
+{
+    // Both slots are contiguous : read them at once.
+    uint8_t* buf = (uint8_t*)malloc(HEADER_SLOTS * HEADER_SIZE);
+    if(buf == nullptr)
+        return -1;
+
+    int res = this->Queue->Read(this->Address, buf, HEADER_SLOTS * HEADER_SIZE);
+    if(res < 0)
+    {
+        free(buf);
+        return -2;
+    }
+
+    // CRC Check of each slot
+    EEPROM_HEADER_V1 Slots[HEADER_SLOTS];
+    int Valid[HEADER_SLOTS] = {0, 0};
+    for(int i = 0; i < HEADER_SLOTS; i++)
+    {
+        memcpy(&Slots[i], &buf[i * HEADER_SIZE], HEADER_SIZE);
+
+        uint16_t read_CRC = Slots[i].HeaderCRC16;
+        Slots[i].HeaderCRC16 = 0xAAAA; // Set the dummy value to ensure integrity of the computation.
+        memcpy(&buf[i * HEADER_SIZE], &Slots[i], HEADER_SIZE);
+        uint16_t calc_CRC = crc_16(&buf[i * HEADER_SIZE], HEADER_SIZE);
+
+        Slots[i].HeaderCRC16 = read_CRC;
+        Valid[i] = (read_CRC == calc_CRC);
+    }
+
+    // Free memory
+    free(buf);
+
+    if((!Valid[0]) & (!Valid[1]))
+        return -3;
+
+    // Newest slot, with wrapping sequences. The other one may have been torn by a power loss.
+    if(Valid[0] & Valid[1])
+        this->Slot = ((int16_t)(Slots[1].Sequence - Slots[0].Sequence) > 0) ? 1 : 0;
+    else
+        this->Slot = Valid[1] ? 1 : 0;
+
+    memcpy(Header, &Slots[this->Slot], HEADER_SIZE);
+    return 0;
+}
+
+int EEPROM_HEADER_SLOTS::Write(EEPROM_HEADER_V1* const Header, std::shared_future<int>* const Done)
+{
+    // Program the other slot : the current one hold a valid header until the new one is complete.
+    // If the last write is still pending or failed, it's slot is programmed again : the other one hold the last
+    // programmed header, and a single slot is ever in flight.
+    bool Programmed = (!this->Done.valid()) ||
+                      ((this->Done.wait_for(std::chrono::seconds(0)) == std::future_status::ready) &&
+                       (this->Done.get() == 0));
+    if(Programmed)
+        this->Slot = (this->Slot + 1) % HEADER_SLOTS;
+
+    if(++Header->Sequence == 0)
+        Header->Sequence = 1;
+
+    // Creating a buffer value
+    uint8_t* buf = (uint8_t*)malloc(HEADER_SIZE);
+    if(buf == nullptr)
+        return -1;
+    memset(buf, 0x00, HEADER_SIZE);
+
+    // Set a dummy value on the CRC16 field and copy the data to an array of uint8_t.
+    Header->HeaderCRC16 = 0xAAAA;
+    memcpy(buf, Header, HEADER_SIZE);
+
+    // Compute the CRC
+    uint16_t calc_CRC = crc_16(buf, HEADER_SIZE);
+    Header->HeaderCRC16 = calc_CRC;
+
+    // Copying the data
+    memcpy(buf, Header, HEADER_SIZE);
+
+    // Queue the data, after any data write.
+    this->Done = this->Queue->Write(this->Address + this->Slot * HEADER_SIZE, buf, HEADER_SIZE, true);
+    free(buf);
+
+    if(Done != nullptr)
+        *Done = this->Done;
+    return 0;
+}
+
+int EEPROM_HEADER_SLOTS::GetSlot() const
+{
+    return this->Slot;
+}
@@ -0,0 +1,315 @@
+/**
+ * @file TEST_JOURNAL.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Source for unittesting the wear-leveled journal, on a simulated M95256.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+
+// Including the unit test framework
+#include "CppUTest/TestHarness.h"
+
+// Include the tested header
+#include "drivers/peripherals/core/SPI_EepromTest.hpp"
+#include "modules/eeprom/journal/journal.hpp"
+
+// STD
+#include <cstring>
+
+// ==============================================================================
+// DEFINES
+// ==============================================================================
+#define JOURNAL_ADDRESS 0x1000
+#define JOURNAL_SIZE (8 * PAGE_SIZE)
+#define JOURNAL_STATE 32
+
+// ==============================================================================
+// TEST GROUPS
+// ==============================================================================
+
+// A journal of two banks of 4 pages, on an erased EEPROM.
+TEST_GROUP_BASE(EEPROM_Journal, SPI_EepromTest)
+{
+    EEPROM_JOURNAL* Journal;
+
+    void Open() override
+    {
+        Journal = new EEPROM_JOURNAL(Queue, JOURNAL_ADDRESS, JOURNAL_SIZE, JOURNAL_STATE);
+    }
+    void Close() override
+    {
+        delete Journal;
+    }
+
+    // Return the offset of the end of the log on the first bank, as programmed on the device.
+    int End()
+    {
+        uint8_t Bank[JOURNAL_SIZE / 2];
+        Model->Peek(JOURNAL_ADDRESS, Bank, sizeof(Bank));
+
+        int Position = PAGE_SIZE;
+        while((Position < JOURNAL_SIZE / 2) && (Bank[Position] != 0xFF))
+        {
+            if(Bank[Position] == 0)
+                Position = (Position / PAGE_SIZE + 1) * PAGE_SIZE;
+            else
+                Position += (Bank[Position] & ~JOURNAL_RECORD_LAST) + JOURNAL_RECORD_OVERHEAD;
+        }
+        return Position;
+    }
+
+    // Format the journal, then append changes until the log end 8 bytes before the end of a page : the first record
+    // of a change of two single bytes fit there, the second one go to the next page.
+    void FillUpToTheLastRecord(uint8_t* const State)
+    {
+        memset(State, 0x00, JOURNAL_STATE);
+        std::shared_future<int> Done;
+        LONGS_EQUAL(0, Journal->Format(State, &Done));
+        LONGS_EQUAL(0, Done.get());
+
+        for(int i = 0; End() % PAGE_SIZE != PAGE_SIZE - 8; i++)
+        {
+            State[i % 4] = (uint8_t)(i + 1);
+            LONGS_EQUAL(0, Journal->Set(State, &Done));
+            LONGS_EQUAL(0, Done.get());
+        }
+    }
+};
+
+// ==============================================================================
+// TESTS
+// ==============================================================================
+
+TEST(EEPROM_Journal, ErasedRegionIsNotMounted)
+{
+    uint8_t State[JOURNAL_STATE];
+
+    LONGS_EQUAL(-1, Journal->Mount());
+    LONGS_EQUAL(-1, Journal->Get(State));
+    LONGS_EQUAL(-1, Journal->Set(State));
+}
+
+TEST(EEPROM_Journal, ChangesAreReplayedAfterReboot)
+{
+    uint8_t State[JOURNAL_STATE];
+    uint8_t Back[JOURNAL_STATE];
+    for(int i = 0; i < JOURNAL_STATE; i++)
+        State[i] = (uint8_t)i;
+
+    std::shared_future<int> Done;
+    LONGS_EQUAL(0, Journal->Format(State, &Done));
+    LONGS_EQUAL(0, Done.get());
+
+    State[3] = 0xA0;
+    LONGS_EQUAL(0, Journal->Set(State));
+    State[20] = 0xA1;
+    State[31] = 0xA2;
+    LONGS_EQUAL(0, Journal->Set(State, &Done));
+    LONGS_EQUAL(0, Done.get());
+
+    Reboot();
+    LONGS_EQUAL(0, Journal->Mount());
+    LONGS_EQUAL(0, Journal->Get(Back));
+    MEMCMP_EQUAL(State, Back, JOURNAL_STATE);
+}
+
+TEST(EEPROM_Journal, OnlyTheChangedBytesAreAppended)
+{
+    uint8_t State[JOURNAL_STATE];
+    memset(State, 0x00, sizeof(State));
+    LONGS_EQUAL(0, Journal->Format(State));
+
+    const JOURNAL_STATISTICS Before = Journal->GetStatistics();
+    State[10] = 0x01;
+    LONGS_EQUAL(0, Journal->Set(State));
+    LONGS_EQUAL(0, Journal->Set(State));
+
+    const JOURNAL_STATISTICS After = Journal->GetStatistics();
+    LONGS_EQUAL(1, After.Records - Before.Records);
+    LONGS_EQUAL(1 + JOURNAL_RECORD_OVERHEAD, After.Bytes - Before.Bytes);
+}
+
+TEST(EEPROM_Journal, FullBankIsCompactedOnTheOtherBank)
+{
+    uint8_t State[JOURNAL_STATE];
+    uint8_t Back[JOURNAL_STATE];
+    memset(State, 0x00, sizeof(State));
+    LONGS_EQUAL(0, Journal->Format(State));
+
+    std::shared_future<int> Done;
+    for(int i = 0; i < 200; i++)
+    {
+        State[i % JOURNAL_STATE] = (uint8_t)(i + 1);
+        LONGS_EQUAL(0, Journal->Set(State, &Done));
+    }
+    LONGS_EQUAL(0, Done.get());
+    CHECK_TRUE(Journal->GetStatistics().Compactions > 2);
+
+    Reboot();
+    LONGS_EQUAL(0, Journal->Mount());
+    LONGS_EQUAL(0, Journal->Get(Back));
+    MEMCMP_EQUAL(State, Back, JOURNAL_STATE);
+}
+
+TEST(EEPROM_Journal, CorruptedRecordEndTheLog)
+{
+    uint8_t State[JOURNAL_STATE];
+    uint8_t Old[JOURNAL_STATE];
+    uint8_t Back[JOURNAL_STATE];
+    memset(State, 0x00, sizeof(State));
+    LONGS_EQUAL(0, Journal->Format(State));
+
+    State[0] = 0x01;
+    std::shared_future<int> Done;
+    LONGS_EQUAL(0, Journal->Set(State, &Done));
+    LONGS_EQUAL(0, Done.get());
+    memcpy(Old, State, sizeof(State));
+
+    // The last record is the 5 bytes before the end of the log.
+    State[1] = 0x02;
+    LONGS_EQUAL(0, Journal->Set(State, &Done));
+    LONGS_EQUAL(0, Done.get());
+    const int Tail = End();
+
+    uint8_t Flipped = 0;
+    Model->Peek(JOURNAL_ADDRESS + Tail - 1, &Flipped, 1);
+    Flipped ^= 0x01;
+    Model->Poke(JOURNAL_ADDRESS + Tail - 1, &Flipped, 1);
+
+    Reboot();
+    LONGS_EQUAL(0, Journal->Mount());
+    LONGS_EQUAL(0, Journal->Get(Back));
+    MEMCMP_EQUAL(Old, Back, JOURNAL_STATE);
+}
+
+TEST(EEPROM_Journal, ChangeInterruptedBetweenTwoPagesIsDiscarded)
+{
+    uint8_t State[JOURNAL_STATE];
+    uint8_t Old[JOURNAL_STATE];
+    uint8_t Back[JOURNAL_STATE];
+    FillUpToTheLastRecord(State);
+    memcpy(Old, State, sizeof(State));
+
+    // The first record is programmed, the power is lost on the page of the second one.
+    Model->CutPower(1);
+    State[8] = 0xA0;
+    State[24] = 0xA1;
+    LONGS_EQUAL(0, Journal->Set(State));
+    LONGS_EQUAL(0, Queue->Flush());
+    CHECK_FALSE(Model->IsPowered());
+
+    Model->Restore();
+    Reboot();
+    LONGS_EQUAL(0, Journal->Mount());
+    LONGS_EQUAL(0, Journal->Get(Back));
+    MEMCMP_EQUAL(Old, Back, JOURNAL_STATE);
+
+    // The next change overwrite the unfinished one.
+    std::shared_future<int> Done;
+    Old[12] = 0xB0;
+    LONGS_EQUAL(0, Journal->Set(Old, &Done));
+    LONGS_EQUAL(0, Done.get());
+
+    Reboot();
+    LONGS_EQUAL(0, Journal->Mount());
+    LONGS_EQUAL(0, Journal->Get(Back));
+    MEMCMP_EQUAL(Old, Back, JOURNAL_STATE);
+}
+
+TEST(EEPROM_Journal, RecordsOfAnUnfinishedChangeAreNotReplayedLater)
+{
+    uint8_t State[JOURNAL_STATE];
+    uint8_t Old[JOURNAL_STATE];
+    uint8_t Back[JOURNAL_STATE];
+    FillUpToTheLastRecord(State);
+    memcpy(Old, State, sizeof(State));
+    const int Tail = End();
+
+    // The first page fail, while the last record of the change is programmed on the next one.
+    Model->InjectFailure(1);
+    State[8] = 0xA0;
+    State[24] = 0xA1;
+    LONGS_EQUAL(0, Journal->Set(State));
+    LONGS_EQUAL(0, Queue->Flush());
+
+    Reboot();
+    LONGS_EQUAL(0, Journal->Mount());
+    LONGS_EQUAL(0, Journal->Get(Back));
+    MEMCMP_EQUAL(Old, Back, JOURNAL_STATE);
+
+    // A change of 4 bytes end exactly on the orphan record, which shall not be taken as the next change.
+    uint8_t Orphan = 0;
+    Model->Peek(JOURNAL_ADDRESS + Tail + 8, &Orphan, 1);
+    LONGS_EQUAL(JOURNAL_RECORD_LAST | 1, Orphan);
+
+    std::shared_future<int> Done;
+    memset(&Old[12], 0xB0, 4);
+    LONGS_EQUAL(0, Journal->Set(Old, &Done));
+    LONGS_EQUAL(0, Done.get());
+
+    Reboot();
+    LONGS_EQUAL(0, Journal->Mount());
+    LONGS_EQUAL(0, Journal->Get(Back));
+    MEMCMP_EQUAL(Old, Back, JOURNAL_STATE);
+}
+
+TEST(EEPROM_Journal, FailedChangeIsCarriedByTheNextOne)
+{
+    uint8_t State[JOURNAL_STATE];
+    uint8_t Back[JOURNAL_STATE];
+    memset(State, 0x00, sizeof(State));
+
+    std::shared_future<int> Done;
+    LONGS_EQUAL(0, Journal->Format(State, &Done));
+    LONGS_EQUAL(0, Done.get());
+
+    // The record of the first change is lost, the second change write the whole state after it.
+    const JOURNAL_STATISTICS Before = Journal->GetStatistics();
+    Model->InjectFailure(1);
+    State[1] = 0xA0;
+    LONGS_EQUAL(0, Journal->Set(State, &Done));
+    CHECK_TRUE(Done.get() != 0);
+
+    State[2] = 0xA1;
+    LONGS_EQUAL(0, Journal->Set(State, &Done));
+    LONGS_EQUAL(0, Done.get());
+    CHECK_TRUE(Journal->GetStatistics().Compactions > Before.Compactions);
+
+    Reboot();
+    LONGS_EQUAL(0, Journal->Mount());
+    LONGS_EQUAL(0, Journal->Get(Back));
+    MEMCMP_EQUAL(State, Back, JOURNAL_STATE);
+}
+
+TEST(EEPROM_Journal, FailedSnapshotIsWroteAgain)
+{
+    uint8_t State[JOURNAL_STATE];
+    uint8_t Back[JOURNAL_STATE];
+    memset(State, 0x00, sizeof(State));
+
+    std::shared_future<int> Done;
+    LONGS_EQUAL(0, Journal->Format(State, &Done));
+    LONGS_EQUAL(0, Done.get());
+
+    // The snapshot of the compaction fail, and it's header is dropped : the first bank is the only valid one.
+    Model->InjectFailure(1);
+    State[1] = 0xA0;
+    LONGS_EQUAL(0, Journal->Format(State, &Done));
+    CHECK_TRUE(Done.get() != 0);
+
+    State[2] = 0xA1;
+    LONGS_EQUAL(0, Journal->Set(State, &Done));
+    LONGS_EQUAL(0, Done.get());
+
+    Reboot();
+    LONGS_EQUAL(0, Journal->Mount());
+    LONGS_EQUAL(0, Journal->Get(Back));
+    MEMCMP_EQUAL(State, Back, JOURNAL_STATE);
+}
@@ -0,0 +1,420 @@
+/**
+ * @file journal.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Source for the wear-leveled, log structured storage.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+#include "modules/eeprom/journal/journal.hpp"
+
+// Libraries
+#include "modules/libcrc/checksum.h"
+
+// STD
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+// ==============================================================================
+// CONSTANTS
+// ==============================================================================
+constexpr uint8_t JOURNAL_MAGIC[2] = {'J', 'L'};
+constexpr int JOURNAL_BANK_CRC_SIZE = 6; // Bytes of JOURNAL_BANK covered by it's CRC
+
+// ==============================================================================
+// CONSTRUCTORS
+// ==============================================================================
+
+EEPROM_JOURNAL::EEPROM_JOURNAL(EEPROM_QUEUE* const Queue,
+                               const int Address,
+                               const int Size,
+                               const int StateSize,
+                               const bool Ordered)
+{
+    this->Queue = Queue;
+    this->Address = Address;
+    this->BankSize = Size / 2;
+    this->StateSize = StateSize;
+    this->Ordered = Ordered;
+
+    this->State = new uint8_t[StateSize];
+    memset(this->State, 0x00, StateSize);
+
+    this->Mounted = false;
+    this->Bank = 0;
+    this->Generation = 0;
+    this->Tail = 0;
+    this->Sequence = 0;
+    this->Statistics = JOURNAL_STATISTICS{};
+    return;
+}
+
+// ==============================================================================
+// DESTRUCTORS
+// ==============================================================================
+
+EEPROM_JOURNAL::~EEPROM_JOURNAL()
+{
+    delete[] this->State;
+    return;
+}
+
+// ==============================================================================
+// PRIVATE
+// ==============================================================================
+
+uint16_t EEPROM_JOURNAL::RecordCRC(const uint16_t Generation,
+                                   const uint16_t Sequence,
+                                   const uint8_t* const Record) const
+{
+    // The generation is part of the CRC : records left by a previous use of the bank are rejected.
+    // So is the sequence number : records of an unfinished change are rejected once the next change is wrote.
+    uint16_t CRC = CRC_START_16;
+    CRC = update_crc_16(CRC, (uint8_t)(Generation & 0x00FF));
+    CRC = update_crc_16(CRC, (uint8_t)((Generation & 0xFF00) >> 8));
+    CRC = update_crc_16(CRC, (uint8_t)(Sequence & 0x00FF));
+    CRC = update_crc_16(CRC, (uint8_t)((Sequence & 0xFF00) >> 8));
+    for(int i = 0; i < (Record[0] & ~JOURNAL_RECORD_LAST) + 2; i++)
+        CRC = update_crc_16(CRC, Record[i]);
+    return CRC;
+}
+
+int EEPROM_JOURNAL::ReadBank(const int Bank, uint8_t* const Buffer, uint16_t* const Generation)
+{
+    if(this->Queue->Read(this->Address + Bank * this->BankSize, Buffer, this->BankSize) != 0)
+        return -2;
+
+    JOURNAL_BANK Header;
+    memcpy(&Header, Buffer, sizeof(JOURNAL_BANK));
+
+    if((Header.Magic[0] != JOURNAL_MAGIC[0]) | (Header.Magic[1] != JOURNAL_MAGIC[1]))
+        return -1;
+    if(Header.StateSize != this->StateSize)
+        return -1;
+    if(Header.CRC != crc_16(Buffer, JOURNAL_BANK_CRC_SIZE))
+        return -1;
+
+    *Generation = Header.Generation;
+    return 0;
+}
+
+int EEPROM_JOURNAL::Replay(const uint8_t* const Buffer, const uint16_t Generation)
+{
+    // Records are applied on a copy, committed once the last record of their change is found.
+    uint8_t* Pending = (uint8_t*)malloc(this->StateSize);
+    if(Pending == nullptr)
+        return -2;
+    memset(this->State, 0x00, this->StateSize);
+    memset(Pending, 0x00, this->StateSize);
+    this->Sequence = 0;
+
+    // The snapshot start on the second page, and is followed by the deltas.
+    int Position = PAGE_SIZE;
+    int Committed = PAGE_SIZE;
+    while(Position < this->BankSize)
+    {
+        const uint8_t* Record = &Buffer[Position];
+        const int Len = Record[0] & ~JOURNAL_RECORD_LAST;
+
+        // Padding up to the next page
+        if(Record[0] == 0)
+        {
+            Position = (Position / PAGE_SIZE + 1) * PAGE_SIZE;
+            continue;
+        }
+
+        // End of the log : erased, torn or left by a previous generation or change.
+        if((Len == 0) | (Len > JOURNAL_RECORD_MAX) |
+           ((Position % PAGE_SIZE) + Len + JOURNAL_RECORD_OVERHEAD > PAGE_SIZE))
+            break;
+        if(Record[1] + Len > this->StateSize)
+            break;
+
+        const uint16_t CRC = (uint16_t)(Record[Len + 2] | (Record[Len + 3] << 8));
+        if(CRC != this->RecordCRC(Generation, this->Sequence, Record))
+            break;
+
+        memcpy(&Pending[Record[1]], &Record[2], Len);
+        Position += Len + JOURNAL_RECORD_OVERHEAD;
+
+        if(Record[0] & JOURNAL_RECORD_LAST)
+        {
+            memcpy(this->State, Pending, this->StateSize);
+            Committed = Position;
+            this->Sequence++;
+        }
+    }
+
+    // An unfinished change is discarded, and overwritten by the next one.
+    this->Tail = this->Address + this->Bank * this->BankSize + Committed;
+    free(Pending);
+    return 0;
+}
+
+int EEPROM_JOURNAL::Append(
+    uint8_t* const Buffer, int* const Position, const int Offset, const int Len, const bool Last)
+{
+    int Next = *Position;
+    const int BankEnd = this->Address + (this->Bank + 1) * this->BankSize;
+
+    // Records never cross a page.
+    if(((this->Tail + Next) % PAGE_SIZE) + Len + JOURNAL_RECORD_OVERHEAD > PAGE_SIZE)
+    {
+        const int Pad = PAGE_SIZE - ((this->Tail + Next) % PAGE_SIZE);
+        if(this->Tail + Next + Pad > BankEnd)
+            return -1;
+        memset(&Buffer[Next], 0x00, Pad);
+        Next += Pad;
+    }
+
+    if(this->Tail + Next + Len + JOURNAL_RECORD_OVERHEAD > BankEnd)
+        return -1;
+
+    uint8_t* Record = &Buffer[Next];
+    Record[0] = (uint8_t)Len | (Last ? JOURNAL_RECORD_LAST : 0x00);
+    Record[1] = (uint8_t)Offset;
+    memcpy(&Record[2], &this->State[Offset], Len);
+
+    const uint16_t CRC = this->RecordCRC(this->Generation, this->Sequence, Record);
+    Record[Len + 2] = (uint8_t)(CRC & 0x00FF);
+    Record[Len + 3] = (uint8_t)((CRC & 0xFF00) >> 8);
+
+    *Position = Next + Len + JOURNAL_RECORD_OVERHEAD;
+    this->Statistics.Records++;
+    return 0;
+}
+
+bool EEPROM_JOURNAL::Lost()
+{
+    // The completed writes are forgotten, the failed ones are reported.
+    bool Failed = false;
+    auto Completed = std::remove_if(this->Writes.begin(), this->Writes.end(), [&Failed](const std::shared_future<int>& Write) {
+        if(Write.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return false;
+        Failed |= (Write.get() != 0);
+        return true;
+    });
+    this->Writes.erase(Completed, this->Writes.end());
+    return Failed;
+}
+
+int EEPROM_JOURNAL::Compact(std::shared_future<int>* const Done, const bool Switch)
+{
+    uint8_t* Buffer = (uint8_t*)malloc(this->BankSize);
+    if(Buffer == nullptr)
+        return -2;
+
+    // Switch to the other bank, the snapshot is appended as any record. A bank whose header is not programmed is
+    // reused : the other one is then the only valid one. The new generation reject the records left on it.
+    if(this->Mounted)
+    {
+        if(Switch)
+            this->Bank = 1 - this->Bank;
+        this->Generation++;
+    }
+    const int BankAddress = this->Address + this->Bank * this->BankSize;
+    this->Tail = BankAddress + PAGE_SIZE;
+    this->Sequence = 0;
+
+    int Position = 0;
+    for(int Offset = 0; Offset < this->StateSize; Offset += JOURNAL_RECORD_MAX)
+    {
+        const int Len = std::min(JOURNAL_RECORD_MAX, this->StateSize - Offset);
+        this->Append(Buffer, &Position, Offset, Len, Offset + Len == this->StateSize);
+    }
+    this->Sequence++;
+    this->Writes.clear();
+    this->Writes.push_back(this->Queue->Write(this->Tail, Buffer, Position));
+    this->Tail += Position;
+    this->Statistics.Bytes += Position;
+    free(Buffer);
+
+    // Then the header, programmed once the snapshot is.
+    JOURNAL_BANK Header;
+    memcpy(Header.Magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+    Header.Generation = this->Generation;
+    Header.StateSize = (uint16_t)this->StateSize;
+    Header.CRC = crc_16((const uint8_t*)&Header, JOURNAL_BANK_CRC_SIZE);
+
+    this->Header = this->Queue->Write(BankAddress, (const uint8_t*)&Header, sizeof(JOURNAL_BANK), true);
+    this->Writes.push_back(this->Header);
+    if(Done != nullptr)
+        *Done = this->Header;
+
+    this->Mounted = true;
+    this->Statistics.Compactions++;
+    return 0;
+}
+
+// ==============================================================================
+// PUBLIC
+// ==============================================================================
+
+int EEPROM_JOURNAL::Mount()
+{
+    uint8_t* Buffer = (uint8_t*)malloc(this->BankSize);
+    if(Buffer == nullptr)
+        return -2;
+
+    uint16_t Generations[2] = {0, 0};
+    int Valid[2] = {0, 0};
+    for(int i = 0; i < 2; i++)
+    {
+        int res = this->ReadBank(i, Buffer, &Generations[i]);
+        if(res == -2)
+        {
+            free(Buffer);
+            return -2;
+        }
+        Valid[i] = (res == 0);
+    }
+
+    if((!Valid[0]) & (!Valid[1]))
+    {
+        free(Buffer);
+        return -1;
+    }
+
+    // Newest bank, with wrapping generations.
+    if(Valid[0] & Valid[1])
+        this->Bank = ((int16_t)(Generations[1] - Generations[0]) > 0) ? 1 : 0;
+    else
+        this->Bank = Valid[1] ? 1 : 0;
+    this->Generation = Generations[this->Bank];
+
+    // Served from the mirror.
+    this->ReadBank(this->Bank, Buffer, &Generations[this->Bank]);
+    int res = this->Replay(Buffer, this->Generation);
+    free(Buffer);
+    if(res != 0)
+        return -2;
+
+    this->Writes.clear();
+    this->Header = std::shared_future<int>();
+    this->Mounted = true;
+    return 0;
+}
+
+int EEPROM_JOURNAL::Format(const uint8_t* const State, std::shared_future<int>* const Done)
+{
+    memcpy(this->State, State, this->StateSize);
+    return this->Compact(Done, true);
+}
+
+int EEPROM_JOURNAL::Get(uint8_t* const State) const
+{
+    if(!this->Mounted)
+        return -1;
+
+    memcpy(State, this->State, this->StateSize);
+    return 0;
+}
+
+int EEPROM_JOURNAL::Set(const uint8_t* const State, std::shared_future<int>* const Done)
+{
+    if(!this->Mounted)
+        return -1;
+
+    // A write of the bank failed : the records appended after it would never be replayed. The other bank is only
+    // overwritten once the header of this one is known to be programmed.
+    // The queue drop the first header that follow a failed data page, even a record : the snapshot is wrote again
+    // once it has been handled.
+    if(this->Lost())
+    {
+        memcpy(this->State, State, this->StateSize);
+
+        std::shared_future<int> Future;
+        int res = 0;
+        for(int Try = 0; Try < 2; Try++)
+        {
+            const bool Valid = (!this->Header.valid()) || (this->Header.get() == 0);
+            res = this->Compact(&Future, Valid);
+            if((res != 0) || (Future.get() != -3))
+                break;
+        }
+
+        if(Done != nullptr)
+            *Done = Future;
+        return res;
+    }
+
+    uint8_t* Buffer = (uint8_t*)malloc(this->BankSize);
+    if(Buffer == nullptr)
+        return -2;
+
+    // Group the changed bytes in records. Unchanged gaps shorter than a record overhead are included.
+    std::vector<std::pair<int, int>> Records;
+    int i = 0;
+    while(i < this->StateSize)
+    {
+        if(this->State[i] == State[i])
+        {
+            i++;
+            continue;
+        }
+
+        const int Start = i;
+        int Last = i;
+        for(int j = i; (j < this->StateSize) && (j - Start < JOURNAL_RECORD_MAX); j++)
+        {
+            if(this->State[j] != State[j])
+                Last = j;
+            else if(j - Last > JOURNAL_RECORD_OVERHEAD)
+                break;
+        }
+
+        Records.push_back({Start, Last - Start + 1});
+        i = Last + 1;
+    }
+    memcpy(this->State, State, this->StateSize);
+
+    // The last record commit the whole change.
+    int Position = 0;
+    int Full = 0;
+    for(size_t Record = 0; (Record < Records.size()) & (Full == 0); Record++)
+        Full = this->Append(
+            Buffer, &Position, Records[Record].first, Records[Record].second, Record + 1 == Records.size());
+
+    // No space left on the bank : the whole state go to the other one.
+    if(Full != 0)
+    {
+        free(Buffer);
+        return this->Compact(Done, true);
+    }
+
+    std::shared_future<int> Future;
+    if(Position > 0)
+    {
+        Future = this->Queue->Write(this->Tail, Buffer, Position, this->Ordered);
+        this->Writes.push_back(Future);
+        this->Tail += Position;
+        this->Sequence++;
+        this->Statistics.Bytes += Position;
+    }
+    else
+    {
+        std::promise<int> Unchanged;
+        Unchanged.set_value(0);
+        Future = Unchanged.get_future().share();
+    }
+    free(Buffer);
+
+    if(Done != nullptr)
+        *Done = Future;
+    return 0;
+}
+
+JOURNAL_STATISTICS EEPROM_JOURNAL::GetStatistics() const
+{
+    return this->Statistics;
+}
@@ -0,0 +1,205 @@
+/**
+ * @file TEST_QUEUE.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Source for unittesting the EEPROM write-behind queue, on a simulated M95256.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+
+// Including the unit test framework
+#include "CppUTest/TestHarness.h"
+
+// Include the tested header
+#include "drivers/peripherals/core/SPI_EepromTest.hpp"
+#include "modules/eeprom/queue/queue.hpp"
+
+// STD
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// ==============================================================================
+// TEST GROUPS
+// ==============================================================================
+
+// A queue on an erased EEPROM, without write cycle time.
+TEST_GROUP_BASE(EEPROM_Queue, SPI_EepromTest){};
+
+// ==============================================================================
+// TESTS
+// ==============================================================================
+
+TEST(EEPROM_Queue, WritesAreProgrammedPerPage)
+{
+    uint8_t Data[100];
+    uint8_t Back[100];
+    for(int i = 0; i < 100; i++)
+        Data[i] = (uint8_t)(i * 7 + 1);
+
+    // Pending writes are already visible.
+    std::shared_future<int> Done = Queue->Write(0x130, Data, 100);
+    LONGS_EQUAL(0, Queue->Read(0x130, Back, 100));
+    MEMCMP_EQUAL(Data, Back, 100);
+
+    LONGS_EQUAL(0, Done.get());
+    Model->Peek(0x130, Back, 100);
+    MEMCMP_EQUAL(Data, Back, 100);
+
+    // 0x130 to 0x193 : three pages.
+    std::vector<int> Log = Model->GetLog();
+    LONGS_EQUAL(3, Log.size());
+    LONGS_EQUAL(3, Queue->GetStatistics().Pages);
+}
+
+TEST(EEPROM_Queue, InvalidWritesAreRejected)
+{
+    uint8_t Data[2] = {0x00, 0x00};
+
+    LONGS_EQUAL(-1, Queue->Write(-1, Data, 2).get());
+    LONGS_EQUAL(-1, Queue->Write(EEPROM_QUEUE_SIZE - 1, Data, 2).get());
+    LONGS_EQUAL(0, Queue->Write(0, Data, 0).get());
+    LONGS_EQUAL(0, Model->GetLog().size());
+}
+
+TEST(EEPROM_Queue, PendingWritesOnAPageAreCoalesced)
+{
+    uint8_t Data[4] = {0x11, 0x22, 0x33, 0x44};
+    uint8_t Back[4];
+
+    // The worker is held on the first page, while the next one is written twice.
+    Model->Hold();
+    Queue->Write(0x000, Data, 4);
+    Model->WaitHeld();
+    Queue->Write(0x080, Data, 2);
+    Queue->Write(0x082, &Data[2], 2);
+    Model->Release();
+    LONGS_EQUAL(0, Queue->Flush());
+
+    LONGS_EQUAL(1, Queue->GetStatistics().Coalesced);
+    std::vector<int> Log = Model->GetLog();
+    LONGS_EQUAL(1, std::count(Log.begin(), Log.end(), 0x080));
+
+    Model->Peek(0x080, Back, 4);
+    MEMCMP_EQUAL(Data, Back, 4);
+}
+
+TEST(EEPROM_Queue, HeaderPagesAreProgrammedAfterTheData)
+{
+    uint8_t Data[PAGE_SIZE];
+    memset(Data, 0x5A, sizeof(Data));
+
+    // The worker is held on the first data page, while the header and a data page queued after it are pending.
+    Model->Hold();
+    Queue->Write(0x200, Data, PAGE_SIZE);
+    Model->WaitHeld();
+    Queue->Write(0x000, Data, 8, true);
+    Queue->Write(0x240, Data, PAGE_SIZE);
+    Model->Release();
+    LONGS_EQUAL(0, Queue->Flush());
+
+    std::vector<int> Log = Model->GetLog();
+    LONGS_EQUAL(3, Log.size());
+    LONGS_EQUAL(0x200, Log[0]);
+    LONGS_EQUAL(0x240, Log[1]);
+    LONGS_EQUAL(0x000, Log[2]);
+}
+
+TEST(EEPROM_Queue, HeaderIsDroppedAfterADataFailure)
+{
+    uint8_t Data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    uint8_t Back[8];
+    uint8_t Erased[8];
+    memset(Erased, 0xFF, sizeof(Erased));
+
+    Model->InjectFailure(1);
+    std::shared_future<int> Payload = Queue->Write(0x400, Data, 8);
+    std::shared_future<int> Header = Queue->Write(0x000, Data, 8, true);
+
+    LONGS_EQUAL(-2, Payload.get());
+    LONGS_EQUAL(-3, Header.get());
+    LONGS_EQUAL(1, Queue->GetStatistics().Dropped);
+    Model->Peek(0x000, Back, 8);
+    MEMCMP_EQUAL(Erased, Back, 8);
+
+    // The next header start from a clean state.
+    LONGS_EQUAL(0, Queue->Write(0x000, Data, 8, true).get());
+    Model->Peek(0x000, Back, 8);
+    MEMCMP_EQUAL(Data, Back, 8);
+}
+
+TEST(EEPROM_Queue, DroppedHeaderIsReloadedOnTheMirror)
+{
+    uint8_t Data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    uint8_t Back[8];
+    uint8_t Erased[8];
+    memset(Erased, 0xFF, sizeof(Erased));
+
+    LONGS_EQUAL(0, Queue->Preload());
+
+    Model->InjectFailure(1);
+    Queue->Write(0x400, Data, 8);
+    LONGS_EQUAL(-3, Queue->Write(0x000, Data, 8, true).get());
+
+    // The mirror shall not report the header that never reached the device.
+    const unsigned long Loads = Queue->GetStatistics().Loads;
+    LONGS_EQUAL(0, Queue->Read(0x000, Back, 8));
+    MEMCMP_EQUAL(Erased, Back, 8);
+    LONGS_EQUAL(Loads + 1, Queue->GetStatistics().Loads);
+}
+
+TEST(EEPROM_Queue, UnchangedWritesAreSkipped)
+{
+    uint8_t Data[PAGE_SIZE];
+    memset(Data, 0xFF, sizeof(Data));
+
+    LONGS_EQUAL(0, Queue->Preload());
+    LONGS_EQUAL(0, Queue->Write(0x100, Data, PAGE_SIZE).get());
+
+    LONGS_EQUAL(1, Queue->GetStatistics().Unchanged);
+    LONGS_EQUAL(0, Model->GetLog().size());
+
+    // A single preload read, then everything is served by the mirror.
+    LONGS_EQUAL(0, Queue->Read(0x7000, Data, PAGE_SIZE));
+    LONGS_EQUAL(1, Queue->GetStatistics().Loads);
+}
+
+TEST(EEPROM_Queue, ConcurrentWritersAreAllProgrammed)
+{
+    constexpr int Writers = 4;
+    constexpr int Pages = 16;
+    std::vector<std::thread> Threads;
+
+    Model->SetCycle(100);
+    for(int Writer = 0; Writer < Writers; Writer++)
+    {
+        Threads.emplace_back([this, Writer]() {
+            uint8_t Data[PAGE_SIZE];
+            for(int Page = 0; Page < Pages; Page++)
+            {
+                memset(Data, Writer * Pages + Page, sizeof(Data));
+                Queue->Write((Writer * Pages + Page) * PAGE_SIZE, Data, PAGE_SIZE);
+            }
+        });
+    }
+    for(auto& Thread : Threads)
+        Thread.join();
+    LONGS_EQUAL(0, Queue->Flush());
+
+    uint8_t Back[PAGE_SIZE];
+    uint8_t Expected[PAGE_SIZE];
+    for(int Page = 0; Page < Writers * Pages; Page++)
+    {
+        memset(Expected, Page, sizeof(Expected));
+        Model->Peek(Page * PAGE_SIZE, Back, PAGE_SIZE);
+        MEMCMP_EQUAL(Expected, Back, PAGE_SIZE);
+    }
+    LONGS_EQUAL(Writers * Pages, Queue->GetStatistics().Requests);
+}
@@ -0,0 +1,329 @@
+/**
+ * @file queue.cpp
+ * @author l.heywang (leonard.heywang@gmail.com)
+ * @brief Source for the EEPROM write-behind queue.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+// ==============================================================================
+// INCLUDES
+// ==============================================================================
+#include "modules/eeprom/queue/queue.hpp"
+
+// STD
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+// ==============================================================================
+// CONSTRUCTORS
+// ==============================================================================
+
+EEPROM_QUEUE::EEPROM_QUEUE(M95256* const Slave)
+{
+    this->Slave = Slave;
+    this->CurrentPage = -1;
+    this->DataError = 0;
+    this->Running = true;
+    this->Statistics = EEPROM_QUEUE_STATISTICS{};
+
+    this->Mirror = new uint8_t[EEPROM_QUEUE_SIZE];
+    memset(this->Loaded, 0x00, sizeof(this->Loaded));
+
+    this->Worker = std::thread(&EEPROM_QUEUE::Work, this);
+    return;
+}
+
+// ==============================================================================
+// DESTRUCTORS
+// ==============================================================================
+
+EEPROM_QUEUE::~EEPROM_QUEUE()
+{
+    {
+        std::lock_guard<std::mutex> Guard(this->Lock);
+        this->Running = false;
+    }
+    this->Wake.notify_all();
+    this->Worker.join();
+    delete[] this->Mirror;
+    return;
+}
+
+// ==============================================================================
+// PRIVATE
+// ==============================================================================
+
+void EEPROM_QUEUE::Work()
+{
+    std::unique_lock<std::mutex> Guard(this->Lock);
+
+    while(1)
+    {
+        this->Wake.wait(Guard, [this] { return (!this->Pages.empty()) | (!this->Running); });
+
+        // Stopped, and everything has been programmed.
+        if(this->Pages.empty())
+            break;
+
+        // Data pages first, by address. Header pages once none remain.
+        auto Next = std::find_if(this->Pages.begin(), this->Pages.end(), [](const auto& Page) {
+            return !Page.second.Header;
+        });
+        if(Next == this->Pages.end())
+            Next = this->Pages.begin();
+
+        this->CurrentPage = Next->first;
+        this->Current = std::move(Next->second);
+        this->Pages.erase(Next);
+
+        const bool Commit = (!this->Current.Header) | (this->DataError == 0);
+
+        Guard.unlock();
+        int res = Commit ? this->Program(this->CurrentPage, &this->Current) : -3;
+        Guard.lock();
+
+        if(!this->Current.Header)
+        {
+            if(res != 0)
+                this->DataError = res;
+        }
+        else if(std::none_of(this->Pages.begin(), this->Pages.end(), [](const auto& Page) {
+                    return Page.second.Header;
+                }))
+        {
+            // The whole header has been handled, the next one start from a clean state.
+            this->DataError = 0;
+        }
+
+        // The mirror may hold bytes that are not on the device, dropped headers included : reload the page on next
+        // access.
+        if(res != 0)
+            this->Loaded[this->CurrentPage / 64] &= ~(1ULL << (this->CurrentPage % 64));
+
+        if(Commit)
+            this->Statistics.Pages++;
+        else
+            this->Statistics.Dropped++;
+
+        for(auto& Request : this->Current.Waiters)
+        {
+            if((res != 0) & (Request->Result == 0))
+                Request->Result = res;
+            if(--Request->Remaining == 0)
+                Request->Done.set_value(Request->Result);
+        }
+        this->Current.Waiters.clear();
+        this->CurrentPage = -1;
+
+        if(this->Pages.empty())
+            this->Idle.notify_all();
+    }
+
+    this->Idle.notify_all();
+    return;
+}
+
+int EEPROM_QUEUE::Program(const int Number, EEPROM_PAGE* const Page)
+{
+    const int First = std::countr_zero(Page->Mask);
+    const int Last = 63 - std::countl_zero(Page->Mask);
+    const int Len = Last - First + 1;
+    const int Address = Number * PAGE_SIZE;
+
+    std::lock_guard<std::mutex> Guard(this->Device);
+
+    // Holes are filled with the current content, to program a single range.
+    const uint64_t Range = (Len == 64) ? ~0ULL : (((1ULL << Len) - 1) << First);
+    if((Page->Mask & Range) != Range)
+    {
+        uint8_t Old[PAGE_SIZE];
+        if(this->Slave->Read(Address + First, &Old[First], Len) != 0)
+            return -2;
+
+        for(int i = First; i <= Last; i++)
+            if((Page->Mask & (1ULL << i)) == 0)
+                Page->Data[i] = Old[i];
+    }
+
+    if(this->Slave->Write(Address + First, &Page->Data[First], Len) != 0)
+        return -2;
+    return 0;
+}
+
+bool EEPROM_QUEUE::IsLoaded(const int Number) const
+{
+    return (this->Loaded[Number / 64] & (1ULL << (Number % 64))) != 0;
+}
+
+int EEPROM_QUEUE::Load(const int First, const int Last)
+{
+    const int Address = First * PAGE_SIZE;
+    const int Len = (Last - First + 1) * PAGE_SIZE;
+
+    uint8_t* buf = (uint8_t*)malloc(Len);
+    if(buf == nullptr)
+        return -1;
+
+    // The worker can't program while we hold the device, thus the current page is either on the device or still
+    // held by the queue.
+    std::lock_guard<std::mutex> Access(this->Device);
+
+    int res = this->Slave->Read(Address, buf, Len);
+    if(res != 0)
+    {
+        free(buf);
+        return res;
+    }
+
+    std::lock_guard<std::mutex> Guard(this->Lock);
+    this->Statistics.Loads++;
+
+    for(int Number = First; Number <= Last; Number++)
+    {
+        // Loaded by another reader meanwhile.
+        if(this->IsLoaded(Number))
+            continue;
+
+        // Bytes written since are already on the mirror.
+        uint64_t Written = (this->CurrentPage == Number) ? this->Current.Mask : 0;
+        auto Page = this->Pages.find(Number);
+        if(Page != this->Pages.end())
+            Written |= Page->second.Mask;
+
+        for(int i = 0; i < PAGE_SIZE; i++)
+            if((Written & (1ULL << i)) == 0)
+                this->Mirror[Number * PAGE_SIZE + i] = buf[(Number - First) * PAGE_SIZE + i];
+
+        this->Loaded[Number / 64] |= 1ULL << (Number % 64);
+    }
+
+    free(buf);
+    return 0;
+}
+
+// ==============================================================================
+// PUBLIC
+// ==============================================================================
+
+std::shared_future<int> EEPROM_QUEUE::Write(const int Address,
+                                            const uint8_t* const Data,
+                                            const int Len,
+                                            const bool Header)
+{
+    auto Request = std::make_shared<EEPROM_WRITE>();
+    std::shared_future<int> Future = Request->Done.get_future().share();
+    Request->Result = 0;
+
+    if((Address < 0) | (Len < 0) | (Address + Len > EEPROM_QUEUE_SIZE))
+    {
+        Request->Done.set_value(-1);
+        return Future;
+    }
+    if(Len == 0)
+    {
+        Request->Done.set_value(0);
+        return Future;
+    }
+
+    const int First = Address / PAGE_SIZE;
+    const int Last = (Address + Len - 1) / PAGE_SIZE;
+    Request->Remaining = Last - First + 1;
+
+    {
+        std::lock_guard<std::mutex> Guard(this->Lock);
+
+        this->Statistics.Requests++;
+
+        for(int Number = First; Number <= Last; Number++)
+        {
+            const int Start = std::max(Address, Number * PAGE_SIZE);
+            const int End = std::min(Address + Len, (Number + 1) * PAGE_SIZE);
+
+            // Already on the EEPROM : nothing to program.
+            if(this->IsLoaded(Number) & (this->CurrentPage != Number) &
+               (this->Pages.count(Number) == 0) &
+               (memcmp(&this->Mirror[Start], &Data[Start - Address], End - Start) == 0))
+            {
+                this->Statistics.Unchanged++;
+                Request->Remaining--;
+                continue;
+            }
+
+            auto [Page, New] = this->Pages.try_emplace(Number);
+            if(!New)
+                this->Statistics.Coalesced++;
+
+            for(int Byte = Start; Byte < End; Byte++)
+            {
+                Page->second.Data[Byte % PAGE_SIZE] = Data[Byte - Address];
+                Page->second.Mask |= 1ULL << (Byte % PAGE_SIZE);
+            }
+            memcpy(&this->Mirror[Start], &Data[Start - Address], End - Start);
+
+            Page->second.Header |= Header;
+            Page->second.Waiters.push_back(Request);
+        }
+
+        if(Request->Remaining == 0)
+        {
+            Request->Done.set_value(0);
+            return Future;
+        }
+    }
+
+    this->Wake.notify_one();
+    return Future;
+}
+
+int EEPROM_QUEUE::Read(const int Address, uint8_t* const Data, const int Len)
+{
+    if((Address < 0) | (Len < 0) | (Address + Len > EEPROM_QUEUE_SIZE))
+        return -1;
+    if(Len == 0)
+        return 0;
+
+    std::unique_lock<std::mutex> Guard(this->Lock);
+
+    // Load the missing pages, from the first to the last one, in a single read.
+    int First = Address / PAGE_SIZE;
+    int Last = (Address + Len - 1) / PAGE_SIZE;
+    while((First <= Last) && this->IsLoaded(First))
+        First++;
+    while((Last >= First) && this->IsLoaded(Last))
+        Last--;
+
+    if(First <= Last)
+    {
+        Guard.unlock();
+        int res = this->Load(First, Last);
+        if(res != 0)
+            return res;
+        Guard.lock();
+    }
+
+    memcpy(Data, &this->Mirror[Address], Len);
+    return 0;
+}
+
+int EEPROM_QUEUE::Preload()
+{
+    return this->Load(0, EEPROM_QUEUE_PAGES - 1);
+}
+
+int EEPROM_QUEUE::Flush()
+{
+    std::unique_lock<std::mutex> Guard(this->Lock);
+    this->Idle.wait(Guard, [this] { return this->Pages.empty() & (this->CurrentPage < 0); });
+    return 0;
+}
+
+EEPROM_QUEUE_STATISTICS EEPROM_QUEUE::GetStatistics()
+{
+    std::lock_guard<std::mutex> Guard(this->Lock);
+    return this->Statistics;
+}